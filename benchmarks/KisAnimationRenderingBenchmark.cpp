@@ -54,27 +54,35 @@ void runRenderingTest(KisImageSP image, int numCores, int numClones)
     }
 }
 
+KisDocument* loadTestDocument()
+{
+    const QString fileName = TestUtil::fetchDataFileLazy("miloor_turntable_002.kra", true);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(QFileInfo(fileName).exists(), nullptr);
 
-}
-
+    KisDocument *doc = KisPart::instance()->createDocument();
 
+    const bool loadingResult = doc->loadNativeFormat(fileName);
+    KIS_SAFE_ASSERT_RECOVER(loadingResult) {
+        delete doc;
+        return nullptr;
+    }
 
+    doc->image()->barrierLock();
+    doc->image()->unlock();
 
-void KisAnimationRenderingBenchmark::testCacheRendering()
-{
-    const QString fileName = TestUtil::fetchDataFileLazy("miloor_turntable_002.kra", true);
-    QVERIFY(QFileInfo(fileName).exists());
+    return doc;
+}
 
 
-    QScopedPointer<KisDocument> doc(KisPart::instance()->createDocument());
+}
 
-    bool loadingResult = doc->loadNativeFormat(fileName);
-    QVERIFY(loadingResult);
 
 
-    doc->image()->barrierLock();
-    doc->image()->unlock();
 
+void KisAnimationRenderingBenchmark::testCacheRendering()
+{
+    QScopedPointer<KisDocument> doc(loadTestDocument());
+    QVERIFY(doc);
 
     for (int numCores = 1; numCores <= QThread::idealThreadCount(); numCores++) {
         QElapsedTimer timer;
@@ -97,4 +105,41 @@ void KisAnimationRenderingBenchmark::testCacheRendering()
     }
 }
 
+void KisAnimationRenderingBenchmark::testClonesScaling()
+{
+    /**
+     * Uses all the cores of the machine and measures how the rendering
+     * time scales with the number of image clones rendering the frames
+     * in parallel. The efficiency is the speedup divided by the number
+     * of clones.
+     */
+
+    QScopedPointer<KisDocument> doc(loadTestDocument());
+    QVERIFY(doc);
+
+    const int numCores = QThread::idealThreadCount();
+    qint64 singleCloneTime = 0;
+
+    for (int numClones = 1; numClones <= numCores; numClones *= 2) {
+        QElapsedTimer timer;
+        timer.start();
+
+        runRenderingTest(doc->image(), numCores, numClones);
+
+        const qint64 time = timer.elapsed();
+
+        if (numClones == 1) {
+            singleCloneTime = time;
+        }
+
+        const qreal speedup = qreal(singleCloneTime) / qMax(qint64(1), time);
+
+        qDebug() << "Cores:" << numCores
+                 << "Clones:" << numClones
+                 << "Time:" << time
+                 << "Speedup:" << QString::number(speedup, 'f', 2)
+                 << "Efficiency:" << QString::number(speedup / numClones, 'f', 2);
+    }
+}
+
 SIMPLE_TEST_MAIN(KisAnimationRenderingBenchmark)
@@ -14,6 +14,7 @@ class KisAnimationRenderingBenchmark : public QObject
     Q_OBJECT
 private Q_SLOTS:
    void testCacheRendering();
+   void testClonesScaling();
 };
 
 #endif // KISANIMATIONRENDERINGBENCHMARK_H
@@ -10,6 +10,11 @@
 
 #include "kis_circle_mask_generator.h"
 #include "kis_rect_mask_generator.h"
+#include "kis_gauss_circle_mask_generator.h"
+#include "kis_gauss_rect_mask_generator.h"
+#include "kis_curve_circle_mask_generator.h"
+#include "kis_curve_rect_mask_generator.h"
+#include "kis_cubic_curve.h"
 
 void KisMaskGeneratorBenchmark::benchmarkCircle()
 {
@@ -33,17 +38,15 @@ void KisMaskGeneratorBenchmark::benchmarkCircle()
 #include "krita_utils.h"
 
 
-void benchmarkSIMD(qreal fade) {
+void benchmarkSIMD(KisMaskGenerator &gen, const QRect &bounds = QRect(0, 0, 1000, 1000), qreal randomness = 0.0) {
     const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
     KisFixedPaintDeviceSP dev = new KisFixedPaintDevice(cs);
-    dev->setRect(QRect(0, 0, 1000, 1000));
+    dev->setRect(bounds);
     dev->initialize();
 
     MaskProcessingData data(dev, cs, nullptr,
-                            0.0, 1.0,
-                            500, 500, 0);
-
-    KisCircleMaskGenerator gen(1000, 1.0, fade, fade, 2, false);
+                            randomness, 1.0,
+                            0.5 * bounds.width(), 0.5 * bounds.height(), 0);
 
     KisBrushMaskApplicatorBase *applicator = gen.applicator();
     applicator->initializeData(&data);
@@ -57,6 +60,11 @@ void benchmarkSIMD(qreal fade) {
     }
 }
 
+void benchmarkSIMD(qreal fade) {
+    KisCircleMaskGenerator gen(1000, 1.0, fade, fade, 2, false);
+    benchmarkSIMD(gen);
+}
+
 void KisMaskGeneratorBenchmark::benchmarkSIMD_SharpBrush()
 {
     benchmarkSIMD(1.0);
@@ -67,6 +75,80 @@ void KisMaskGeneratorBenchmark::benchmarkSIMD_FadedBrush()
     benchmarkSIMD(0.5);
 }
 
+void KisMaskGeneratorBenchmark::benchmarkSIMD_GaussCircle()
+{
+    KisGaussCircleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, true);
+    benchmarkSIMD(gen);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_SoftCircle()
+{
+    const KisCubicCurve curve(QString("0,1;1,0"));
+    KisCurveCircleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, curve, true);
+    benchmarkSIMD(gen);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_Rect()
+{
+    KisRectangleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, true);
+    benchmarkSIMD(gen);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_GaussRect()
+{
+    KisGaussRectangleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, true);
+    benchmarkSIMD(gen);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_SoftRect()
+{
+    const KisCubicCurve curve(QString("0,1;1,0"));
+    KisCurveRectangleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, curve, true);
+    benchmarkSIMD(gen);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_SpikedCircle()
+{
+    KisCircleMaskGenerator gen(1000, 0.5, 0.5, 0.5, 5, true);
+    benchmarkSIMD(gen);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_SpikedSoftRect()
+{
+    const KisCubicCurve curve(QString("0,1;1,0"));
+    KisCurveRectangleMaskGenerator gen(1000, 0.5, 0.5, 0.5, 5, curve, true);
+    benchmarkSIMD(gen);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_RandomFade()
+{
+    KisCircleMaskGenerator gen(1000, 1.0, 0.5, 0.5, 2, true);
+    benchmarkSIMD(gen, QRect(0, 0, 1000, 1000), 0.5);
+}
+
+void KisMaskGeneratorBenchmark::benchmarkSIMD_SupersampledSmallDabs()
+{
+    // small antialiased dabs are supersampled
+    KisCircleMaskGenerator gen(7, 1.0, 0.5, 0.5, 2, true);
+
+    QBENCHMARK {
+        for (int i = 0; i < 10000; i++) {
+            const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+            KisFixedPaintDeviceSP dev = new KisFixedPaintDevice(cs);
+            dev->setRect(QRect(0, 0, 9, 9));
+            dev->initialize();
+
+            MaskProcessingData data(dev, cs, nullptr,
+                                    0.0, 1.0,
+                                    4.5, 4.5, 0);
+
+            KisBrushMaskApplicatorBase *applicator = gen.applicator();
+            applicator->initializeData(&data);
+            applicator->process(dev->bounds());
+        }
+    }
+}
+
 void KisMaskGeneratorBenchmark::benchmarkSquare()
 {
     KisRectangleMaskGenerator gen(1000, 0.5, 0.5, 0.5, 3, true);
@@ -16,6 +16,15 @@ private Q_SLOTS:
     void benchmarkCircle();
     void benchmarkSIMD_SharpBrush();
     void benchmarkSIMD_FadedBrush();
+    void benchmarkSIMD_GaussCircle();
+    void benchmarkSIMD_SoftCircle();
+    void benchmarkSIMD_Rect();
+    void benchmarkSIMD_GaussRect();
+    void benchmarkSIMD_SoftRect();
+    void benchmarkSIMD_SpikedCircle();
+    void benchmarkSIMD_SpikedSoftRect();
+    void benchmarkSIMD_RandomFade();
+    void benchmarkSIMD_SupersampledSmallDabs();
     void benchmarkSquare();
 
 };
@@ -10,6 +10,7 @@
 #include <QRegion>
 #include <QPainter>
 #include <QPainterPath>
+#include <QMutex>
 #include <QDebug>
 
 #include "KoMeshPatchesRenderer.h"
@@ -20,26 +21,70 @@ public:
     Private()
         : QSharedData()
         , gradient(0)
-        , renderer(new KoMeshPatchesRenderer)
     {}
 
     Private(const Private& other)
         : QSharedData()
         , gradient(new SvgMeshGradient(*other.gradient))
         , matrix(other.matrix)
-        , renderer(new KoMeshPatchesRenderer)
     {
     }
 
-    ~Private() {
-        delete renderer;
-    }
-
     QScopedPointer<SvgMeshGradient> gradient;
     QTransform matrix;
-    KoMeshPatchesRenderer *renderer;
+
+    /**
+     * The rendered patches for the last two scales of the painter. The
+     * fills that miss KoShapeRasterCache (e.g. too big ones, or the ones
+     * painted by the text shapes) are painted from here. The background
+     * may be painted from several threads at once, so the cache is
+     * guarded by the mutex, though the rendering itself is done outside
+     * the lock.
+     */
+    struct CachedPatchImage {
+        QRectF meshBoundingRect;
+        QTransform scaleTransform;
+        QImage image;
+    };
+
+    static const int maxCachedPatchImages = 2;
+
+    mutable QMutex cacheMutex;
+    mutable QVector<CachedPatchImage> cachedPatchImages;
+
+    QImage findCachedPatchImage(const QRectF &meshBoundingRect, const QTransform &scaleTransform) const;
+    void addCachedPatchImage(const QRectF &meshBoundingRect, const QTransform &scaleTransform, const QImage &image) const;
 };
 
+QImage KoMeshGradientBackground::Private::findCachedPatchImage(const QRectF &meshBoundingRect, const QTransform &scaleTransform) const
+{
+    QMutexLocker l(&cacheMutex);
+
+    for (int i = 0; i < cachedPatchImages.size(); i++) {
+        if (cachedPatchImages[i].meshBoundingRect == meshBoundingRect &&
+            cachedPatchImages[i].scaleTransform == scaleTransform) {
+
+            // move the entry to the front, so that the least recently
+            // used one is dropped first
+            cachedPatchImages.move(i, 0);
+            return cachedPatchImages.first().image;
+        }
+    }
+
+    return QImage();
+}
+
+void KoMeshGradientBackground::Private::addCachedPatchImage(const QRectF &meshBoundingRect, const QTransform &scaleTransform, const QImage &image) const
+{
+    QMutexLocker l(&cacheMutex);
+
+    cachedPatchImages.prepend({meshBoundingRect, scaleTransform, image});
+
+    while (cachedPatchImages.size() > maxCachedPatchImages) {
+        cachedPatchImages.removeLast();
+    }
+}
+
 KoMeshGradientBackground::KoMeshGradientBackground(const SvgMeshGradient *gradient, const QTransform &matrix)
     : KoShapeBackground()
     , d(new Private)
@@ -79,25 +124,40 @@ void KoMeshGradientBackground::paint(QPainter &painter,
         meshBoundingRect = gradient->boundingRect();
     }
 
-    if (d->renderer->patchImage()->isNull()) {
+    /**
+     * The patch image depends on the scale of the painter only, the
+     * translation is applied when drawing it
+     */
+    const QTransform painterTransform = painter.transform();
+    const QTransform scaleTransform(painterTransform.m11(), painterTransform.m12(),
+                                    painterTransform.m21(), painterTransform.m22(),
+                                    0, 0);
+
+    QImage patchImage = d->findCachedPatchImage(meshBoundingRect, scaleTransform);
+
+    if (patchImage.isNull()) {
+        KoMeshPatchesRenderer renderer;
+        renderer.configure(meshBoundingRect, painterTransform);
 
-        d->renderer->configure(meshBoundingRect, painter.transform());
         SvgMeshArray *mesharray = gradient->getMeshArray().data();
 
         for (int row = 0; row < mesharray->numRows(); ++row) {
             for (int col = 0; col < mesharray->numColumns(); ++col) {
                 SvgMeshPatch *patch = mesharray->getPatch(row, col);
-                d->renderer->fillPatch(patch, gradient->type(), mesharray, row, col);
+                renderer.fillPatch(patch, gradient->type(), mesharray, row, col);
             }
         }
         // uncomment to debug
-        //  d->renderer->patchImage()->save("mesh-patch.png");
+        //  renderer.patchImage()->save("mesh-patch.png");
+
+        patchImage = *renderer.patchImage();
+        d->addCachedPatchImage(meshBoundingRect, scaleTransform, patchImage);
     }
 
     painter.setClipPath(fillPath);
 
     // patch is to be drawn wrt. to "user" coordinates
-    painter.drawImage(meshBoundingRect, *d->renderer->patchImage());
+    painter.drawImage(meshBoundingRect, patchImage);
 
     painter.restore();
 }
@@ -109,6 +169,12 @@ bool KoMeshGradientBackground::compareTo(const KoShapeBackground*) const
 
 SvgMeshGradient* KoMeshGradientBackground::gradient()
 {
+    // the gradient may be modified by the caller
+    {
+        QMutexLocker l(&d->cacheMutex);
+        d->cachedPatchImages.clear();
+    }
+
     return d->gradient.data();
 }
 
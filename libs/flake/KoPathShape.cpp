@@ -18,6 +18,7 @@
 #include "KoShapeLoadingContext.h"
 #include "KoShapeShadow.h"
 #include "KoShapeBackground.h"
+#include "KoShapeRasterCache.h"
 #include "KoShapeContainer.h"
 #include "KoFilterEffectStack.h"
 #include "KoMarker.h"
@@ -112,8 +113,10 @@ void KoPathShape::paint(QPainter &painter) const
     QPainterPath path(outline());
     path.setFillRule(d->fillRule);
 
-    if (background()) {
-        background()->paint(painter, path);
+    QSharedPointer<KoShapeBackground> fill = background();
+
+    if (fill && !KoShapeRasterCache::instance()->tryPaintBackground(painter, fill, path)) {
+        fill->paint(painter, path);
     }
     //d->paintDebug(painter);
 }
@@ -0,0 +1,217 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoShapeRasterCache.h"
+
+#include <array>
+#include <limits>
+
+#include <QCache>
+#include <QGlobalStatic>
+#include <QImage>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QPainterPath>
+
+#include "KisQPainterStateSaver.h"
+#include "KoMeshGradientBackground.h"
+#include "KoShapeBackground.h"
+#include "kis_global.h"
+
+Q_GLOBAL_STATIC(KoShapeRasterCache, s_instance)
+
+namespace {
+
+/**
+ * Paths with fewer elements are filled faster
+ * than the cache is looked up
+ */
+const int complexPathElementCount = 256;
+
+const qint64 defaultMemoryLimit = 64 * 1024 * 1024;
+
+/**
+ * The transformation is quantized to avoid cache misses caused by
+ * rounding errors, e.g. when the same shape is rendered in patches
+ */
+inline qint64 quantize(qreal value)
+{
+    return qRound64(value * 65536.0);
+}
+
+struct CacheKey
+{
+    const KoShapeBackground *background = nullptr;
+    QPainterPath fillPath;
+    std::array<qint64, 6> transform;
+    QSize size;
+    int renderHints = 0;
+    uint pathHash = 0;
+
+    bool operator==(const CacheKey &rhs) const {
+        return background == rhs.background &&
+            size == rhs.size &&
+            renderHints == rhs.renderHints &&
+            transform == rhs.transform &&
+            pathHash == rhs.pathHash &&
+            fillPath == rhs.fillPath;
+    }
+};
+
+uint qHash(const CacheKey &key, uint seed = 0)
+{
+    uint result = ::qHash(quintptr(key.background), seed) ^ key.pathHash;
+
+    for (qint64 value : key.transform) {
+        result = 31 * result + ::qHash(value);
+    }
+
+    return result ^ ::qHash(key.size.width()) ^ ::qHash(key.size.height() << 16);
+}
+
+uint hashPath(const QPainterPath &path)
+{
+    uint result = uint(path.fillRule());
+
+    for (int i = 0; i < path.elementCount(); i++) {
+        const QPainterPath::Element &el = path.elementAt(i);
+        result = 31 * result + ::qHash(quantize(el.x));
+        result = 31 * result + ::qHash(quantize(el.y));
+        result = 31 * result + uint(el.type);
+    }
+
+    return result;
+}
+
+struct CacheEntry
+{
+    /**
+     * Keeps the background alive, so that its address
+     * could not be reused by a different one
+     */
+    QSharedPointer<KoShapeBackground> background;
+    QImage image;
+};
+
+bool isExpensiveToRender(const KoShapeBackground *background, const QPainterPath &fillPath)
+{
+    return fillPath.elementCount() >= complexPathElementCount ||
+        dynamic_cast<const KoMeshGradientBackground*>(background);
+}
+
+}
+
+struct KoShapeRasterCache::Private
+{
+    mutable QMutex mutex;
+    QCache<CacheKey, CacheEntry> cache;
+};
+
+KoShapeRasterCache::KoShapeRasterCache()
+    : m_d(new Private)
+{
+    setMemoryLimit(defaultMemoryLimit);
+}
+
+KoShapeRasterCache::~KoShapeRasterCache()
+{
+}
+
+KoShapeRasterCache *KoShapeRasterCache::instance()
+{
+    return s_instance;
+}
+
+bool KoShapeRasterCache::tryPaintBackground(QPainter &painter,
+                                            QSharedPointer<KoShapeBackground> background,
+                                            const QPainterPath &fillPath)
+{
+    if (!background || !isExpensiveToRender(background.data(), fillPath)) return false;
+
+    /**
+     * The cached bitmap is painted as a whole, so other composition
+     * modes would affect the pixels outside the fill path
+     */
+    if (painter.compositionMode() != QPainter::CompositionMode_SourceOver) return false;
+
+    const QTransform transform = painter.transform();
+    if (transform.type() == QTransform::TxProject) return false;
+
+    const QRect deviceRect =
+        kisGrowRect(transform.mapRect(fillPath.boundingRect()).toAlignedRect(), 1);
+    if (deviceRect.isEmpty()) return false;
+
+    const qint64 imageSize = qint64(deviceRect.width()) * deviceRect.height() * 4;
+    if (imageSize > memoryLimit() / 4) return false;
+
+    const QTransform imageTransform =
+        transform * QTransform::fromTranslate(-deviceRect.x(), -deviceRect.y());
+
+    CacheKey key;
+    key.background = background.data();
+    key.fillPath = fillPath;
+    key.transform = {{quantize(imageTransform.m11()), quantize(imageTransform.m12()),
+                      quantize(imageTransform.m21()), quantize(imageTransform.m22()),
+                      quantize(imageTransform.dx()), quantize(imageTransform.dy())}};
+    key.size = deviceRect.size();
+    key.renderHints = int(painter.renderHints());
+    key.pathHash = hashPath(fillPath);
+
+    QImage image;
+
+    {
+        QMutexLocker l(&m_d->mutex);
+        CacheEntry *entry = m_d->cache.object(key);
+        if (entry) {
+            image = entry->image;
+        }
+    }
+
+    if (image.isNull()) {
+        image = QImage(deviceRect.size(), QImage::Format_ARGB32_Premultiplied);
+        image.fill(0);
+
+        QPainter imagePainter(&image);
+        imagePainter.setRenderHints(painter.renderHints());
+        imagePainter.setTransform(imageTransform);
+        background->paint(imagePainter, fillPath);
+        imagePainter.end();
+
+        QMutexLocker l(&m_d->mutex);
+        m_d->cache.insert(key, new CacheEntry{background, image}, int(imageSize));
+    }
+
+    KisQPainterStateSaver saver(&painter);
+    painter.setTransform(QTransform());
+    painter.drawImage(deviceRect.topLeft(), image);
+
+    return true;
+}
+
+qint64 KoShapeRasterCache::memoryLimit() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->cache.maxCost();
+}
+
+void KoShapeRasterCache::setMemoryLimit(qint64 value)
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->cache.setMaxCost(int(qBound(qint64(0), value, qint64(std::numeric_limits<int>::max()))));
+}
+
+qint64 KoShapeRasterCache::memoryUsage() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->cache.totalCost();
+}
+
+void KoShapeRasterCache::clear()
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->cache.clear();
+}
@@ -0,0 +1,81 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KOSHAPERASTERCACHE_H
+#define KOSHAPERASTERCACHE_H
+
+#include "kritaflake_export.h"
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+class QPainter;
+class QPainterPath;
+class KoShapeBackground;
+
+
+/**
+ * A process-wide cache of the rasterized fills of the shapes, whose
+ * rendering is expensive: paths with a lot of segments and mesh
+ * gradients.
+ *
+ * The fill is rasterized in the device coordinates of the painter
+ * and keyed on the background object, the fill path and the
+ * transformation of the painter (excluding the integer part of
+ * its offset). Therefore, panning the canvas or rendering the layer
+ * in patches reuses the same bitmap, while zooming, transforming
+ * or editing the shape produces a new one.
+ *
+ * The backgrounds are supposed to be immutable, once they are
+ * assigned to a shape (KoShapeFillWrapper always creates a new
+ * one on change).
+ *
+ * The amount of memory occupied by the cached bitmaps is limited
+ * by memoryLimit(), the least recently used bitmaps are dropped
+ * when the limit is exceeded. The cache is thread-safe.
+ */
+class KRITAFLAKE_EXPORT KoShapeRasterCache
+{
+public:
+    KoShapeRasterCache();
+    ~KoShapeRasterCache();
+
+    static KoShapeRasterCache* instance();
+
+    /**
+     * Paints \p background inside \p fillPath on \p painter using the
+     * cached bitmap (it is rasterized on the first call).
+     *
+     * Returns false if the fill is not expensive enough to be cached,
+     * or it cannot be cached (e.g. the bitmap would be too big or the
+     * painter has a perspective transformation). In such a case nothing
+     * is painted and the caller should paint the background directly.
+     */
+    bool tryPaintBackground(QPainter &painter,
+                            QSharedPointer<KoShapeBackground> background,
+                            const QPainterPath &fillPath);
+
+    /**
+     * The maximum size of the cached bitmaps in bytes
+     */
+    qint64 memoryLimit() const;
+    void setMemoryLimit(qint64 value);
+
+    /**
+     * The size of the currently cached bitmaps in bytes
+     */
+    qint64 memoryUsage() const;
+
+    void clear();
+
+private:
+    Q_DISABLE_COPY(KoShapeRasterCache)
+
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KOSHAPERASTERCACHE_H
@@ -8,6 +8,9 @@
 #include <QtGui>
 #include "KoShapeContainer.h"
 #include "KoShapeManager.h"
+#include "KoPathShape.h"
+#include "KoColorBackground.h"
+#include "KoShapeRasterCache.h"
 
 #include <MockShapes.h>
 #include <testflake.h>
@@ -298,4 +301,105 @@ void TestShapePainting::testGroupUngroup()
     }
 }
 
+namespace {
+bool compareImagesFuzzy(const QImage &image1, const QImage &image2, int tolerance)
+{
+    if (image1.size() != image2.size()) return false;
+
+    for (int y = 0; y < image1.height(); y++) {
+        for (int x = 0; x < image1.width(); x++) {
+            const QRgb pixel1 = image1.pixel(x, y);
+            const QRgb pixel2 = image2.pixel(x, y);
+
+            if (qAbs(qRed(pixel1) - qRed(pixel2)) > tolerance ||
+                qAbs(qGreen(pixel1) - qGreen(pixel2)) > tolerance ||
+                qAbs(qBlue(pixel1) - qBlue(pixel2)) > tolerance ||
+                qAbs(qAlpha(pixel1) - qAlpha(pixel2)) > tolerance) {
+
+                qDebug() << "Pixels differ at" << x << y << pixel1 << pixel2;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+}
+
+void TestShapePainting::testRasterCache()
+{
+    KoShapeRasterCache *cache = KoShapeRasterCache::instance();
+    cache->clear();
+
+    // a star with enough points to be considered as complex
+    KoPathShape shape;
+    const int numPoints = 300;
+    for (int i = 0; i < numPoints; i++) {
+        const qreal angle = 2 * M_PI * i / numPoints;
+        const qreal radius = i % 2 ? 20 : 45;
+        const QPointF pt(50 + radius * std::cos(angle), 50 + radius * std::sin(angle));
+
+        if (i == 0) {
+            shape.moveTo(pt);
+        } else {
+            shape.lineTo(pt);
+        }
+    }
+    shape.close();
+    shape.setBackground(QSharedPointer<KoShapeBackground>(new KoColorBackground(Qt::red)));
+
+    QImage reference(100, 100, QImage::Format_ARGB32);
+    reference.fill(0);
+
+    {
+        QPainter painter(&reference);
+        painter.setRenderHint(QPainter::Antialiasing);
+
+        QPainterPath path = shape.outline();
+        path.setFillRule(shape.fillRule());
+        shape.background()->paint(painter, path);
+    }
+
+    QImage cached(100, 100, QImage::Format_ARGB32);
+    cached.fill(0);
+
+    {
+        QPainter painter(&cached);
+        painter.setRenderHint(QPainter::Antialiasing);
+        shape.paint(painter);
+    }
+
+    const qint64 usage = cache->memoryUsage();
+    QVERIFY(usage > 0);
+    QVERIFY(compareImagesFuzzy(cached, reference, 2));
+
+    QImage cachedAgain(100, 100, QImage::Format_ARGB32);
+    cachedAgain.fill(0);
+
+    {
+        QPainter painter(&cachedAgain);
+        painter.setRenderHint(QPainter::Antialiasing);
+        shape.paint(painter);
+    }
+
+    QCOMPARE(cache->memoryUsage(), usage);
+    QCOMPARE(cachedAgain, cached);
+
+    // the scale of the painter is a part of the key
+    {
+        QImage scaled(100, 100, QImage::Format_ARGB32);
+        scaled.fill(0);
+
+        QPainter painter(&scaled);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.scale(0.5, 0.5);
+        shape.paint(painter);
+    }
+
+    QVERIFY(cache->memoryUsage() > usage);
+
+    cache->clear();
+    QCOMPARE(cache->memoryUsage(), qint64(0));
+}
+
 KISTEST_MAIN(TestShapePainting)
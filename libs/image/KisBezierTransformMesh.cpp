@@ -115,18 +115,108 @@ void KisBezierTransformMesh::transformPatch(const KisBezierPatch &patch, KisPain
     }
 }
 
-void KisBezierTransformMesh::transformMesh(const QPoint &srcQImageOffset, const QImage &srcImage, const QPoint &dstQImageOffset, QImage *dstImage) const
+namespace {
+
+struct SampledPatch
 {
-    for (auto it = beginPatches(); it != endPatches(); ++it) {
-        transformPatch(*it, srcQImageOffset, srcImage, dstQImageOffset, dstImage);
+    QSize gridSize;
+    QVector<QPointF> originalPoints;
+    QVector<QPointF> transformedPoints;
+    QRect dstBounds;
+};
+
+/**
+ * Sampling of the bezier patches is rather expensive, so we sample
+ * every patch only once (concurrently) and then share the sampled
+ * grids between all the rasterization stripes.
+ */
+QVector<SampledPatch> sampleMeshPatches(const KisBezierTransformMesh &mesh, QRect *dstBounds)
+{
+    QVector<KisBezierPatch> patches;
+    for (auto it = mesh.beginPatches(); it != mesh.endPatches(); ++it) {
+        patches.append(*it);
     }
+
+    QVector<SampledPatch> sampledPatches(patches.size());
+
+    GridIterationTools::parallelForEachIndex(patches.size(),
+        [&] (int i) {
+            SampledPatch &sample = sampledPatches[i];
+            patches[i].sampleRegularGrid(sample.gridSize,
+                                         sample.originalPoints,
+                                         sample.transformedPoints,
+                                         QPointF(8,8));
+
+            sample.dstBounds =
+                KisAlgebra2D::approximateRectFromPoints(sample.transformedPoints)
+                    .toAlignedRect().adjusted(-1, -1, 1, 1);
+        }, 1);
+
+    *dstBounds = QRect();
+    for (auto it = sampledPatches.begin(); it != sampledPatches.end(); ++it) {
+        *dstBounds |= it->dstBounds;
+    }
+
+    return sampledPatches;
+}
+
+template <class PolygonOp>
+void rasterizeSampledPatches(const QVector<SampledPatch> &sampledPatches,
+                             const QRect &dstBounds,
+                             const QPoint &clipRectOffset,
+                             int stripeAlignment,
+                             const PolygonOp &polygonOp)
+{
+    GridIterationTools::processStripesConcurrently(
+        GridIterationTools::splitIntoAlignedStripes(dstBounds, stripeAlignment),
+        [&] (const QRect &stripe) {
+            PolygonOp stripeOp(polygonOp);
+            stripeOp.setDstClipRect(stripe.translated(clipRectOffset));
+
+            for (auto it = sampledPatches.begin(); it != sampledPatches.end(); ++it) {
+                if (!it->dstBounds.intersects(stripe)) continue;
+
+                GridIterationTools::RegularGridIndexesOp indexesOp(it->gridSize);
+                GridIterationTools::iterateThroughGrid
+                        <GridIterationTools::AlwaysCompletePolygonPolicy>(stripeOp, indexesOp,
+                                                                          it->gridSize,
+                                                                          it->originalPoints,
+                                                                          it->transformedPoints);
+            }
+        });
+}
+
+}
+
+void KisBezierTransformMesh::transformMesh(const QPoint &srcQImageOffset, const QImage &srcImage, const QPoint &dstQImageOffset, QImage *dstImage) const
+{
+    QRect dstBounds;
+    const QVector<SampledPatch> sampledPatches = sampleMeshPatches(*this, &dstBounds);
+
+    dstBounds &= QRect(dstQImageOffset, dstImage->size());
+    if (dstBounds.isEmpty()) return;
+
+    // make sure the image is not shared before writing into it concurrently
+    dstImage->detach();
+
+    GridIterationTools::QImagePolygonOp polygonOp(srcImage, *dstImage, srcQImageOffset, dstQImageOffset);
+
+    // the stripes are generated in image space, but QImagePolygonOp expects
+    // the clip rect in the coordinate system of the destination image
+    rasterizeSampledPatches(sampledPatches, dstBounds,
+                            -dstQImageOffset, 16,
+                            polygonOp);
 }
 
 void KisBezierTransformMesh::transformMesh(KisPaintDeviceSP srcDevice, KisPaintDeviceSP dstDevice) const
 {
-    for (auto it = beginPatches(); it != endPatches(); ++it) {
-        transformPatch(*it, srcDevice, dstDevice);
-    }
+    QRect dstBounds;
+    const QVector<SampledPatch> sampledPatches = sampleMeshPatches(*this, &dstBounds);
+
+    if (dstBounds.isEmpty()) return;
+
+    GridIterationTools::PaintDevicePolygonOp polygonOp(srcDevice, dstDevice);
+    rasterizeSampledPatches(sampledPatches, dstBounds, QPoint(), 64, polygonOp);
 }
 
 QRect KisBezierTransformMesh::approxNeedRect(const QRect &rc) const
@@ -12,6 +12,7 @@
 #include "kis_painter.h"
 #include "KoColorModelStandardIds.h"
 #include "KisFastDeviceProcessingUtils.h"
+#include "KisParallelDeviceProcessingUtils.h"
 #include "KisRegion.h"
 #include "kis_wrapped_rect.h"
 #include <KoOptimizedPixelDataScalerU8ToU16Factory.h>
@@ -200,14 +201,24 @@ void KisOverlayPaintDeviceWrapper::readRects(const QVector<QRect> &rects)
     } else {
         KisPaintDeviceSP overlay = m_d->overlays.first();
 
-        KisRandomConstAccessorSP srcIt = m_d->source->createRandomConstAccessorNG();
-        KisRandomAccessorSP dstIt = overlay->createRandomAccessorNG();
-
-        auto rectIter = rectsToRead.begin();
-        while (rectIter != rectsToRead.end()) {
-            const QRect croppedRect = *rectIter & cropRect;
-
+        QVector<QRect> croppedRects;
+        Q_FOREACH (const QRect &rect, rectsToRead) {
+            const QRect croppedRect = rect & cropRect;
             if (!croppedRect.isEmpty()) {
+                croppedRects.append(croppedRect);
+            }
+        }
+
+        /**
+         * The rects of the grid never overlap, so they can be
+         * converted in parallel, every thread with its own accessors.
+         * Inside the stroke jobs (i.e. per dab) they are converted in
+         * the calling thread only, see KritaUtils::WorkerThreadScope.
+         */
+        KritaUtils::processRectsInParallel(croppedRects,
+            [this, overlay] (const QRect &croppedRect) {
+                KisRandomConstAccessorSP srcIt = m_d->source->createRandomConstAccessorNG();
+                KisRandomAccessorSP dstIt = overlay->createRandomAccessorNG();
 
                 KritaUtils::processTwoDevicesWithStrides(croppedRect,
                                                          srcIt, dstIt,
@@ -224,10 +235,7 @@ void KisOverlayPaintDeviceWrapper::readRects(const QVector<QRect> &rects)
                     KisPaintDeviceSP otherOverlay = *it;
                     KisPainter::copyAreaOptimized(croppedRect.topLeft(), overlay, otherOverlay, croppedRect);
                 }
-            }
-
-            rectIter++;
-        }
+            });
     }
 }
 
@@ -250,11 +258,10 @@ void KisOverlayPaintDeviceWrapper::writeRects(const QVector<QRect> &rects, int i
     } else {
         KisPaintDeviceSP overlay = m_d->overlays[index];
 
+        auto writeFunc = [this, overlay, destinationDevice] (const QRect &rc) {
+            KisRandomConstAccessorSP srcIt = overlay->createRandomConstAccessorNG();
+            KisRandomAccessorSP dstIt = destinationDevice->createRandomAccessorNG();
 
-        KisRandomConstAccessorSP srcIt = overlay->createRandomConstAccessorNG();
-        KisRandomAccessorSP dstIt = destinationDevice->createRandomAccessorNG();
-
-        Q_FOREACH (const QRect &rc, rects) {
             KritaUtils::processTwoDevicesWithStrides(rc,
                                                      srcIt, dstIt,
                 [this] (const quint8 *src, int srcRowStride,
@@ -265,6 +272,28 @@ void KisOverlayPaintDeviceWrapper::writeRects(const QVector<QRect> &rects, int i
                                             dst, dstRowStride,
                                             numRows, numColumns);
             });
+        };
+
+        /**
+         * The rects may overlap (e.g. the mirrored dabs), then
+         * they cannot be written in parallel
+         */
+        bool rectsOverlap = false;
+        for (int i = 0; i < rects.size() && !rectsOverlap; i++) {
+            for (int j = i + 1; j < rects.size(); j++) {
+                if (rects[i].intersects(rects[j])) {
+                    rectsOverlap = true;
+                    break;
+                }
+            }
+        }
+
+        if (!rectsOverlap) {
+            KritaUtils::processRectsInParallel(rects, writeFunc);
+        } else {
+            Q_FOREACH (const QRect &rc, rects) {
+                writeFunc(rc);
+            }
         }
     }
 }
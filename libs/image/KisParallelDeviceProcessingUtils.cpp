@@ -0,0 +1,209 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisParallelDeviceProcessingUtils.h"
+
+#include <QAtomicInt>
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentRun>
+
+#include <KoProgressProxy.h>
+
+#include "kis_algebra_2d.h"
+#include "kis_image_config.h"
+
+
+namespace {
+
+/**
+ * The height and width of a tile of the paint device
+ */
+const int tileSize = 64;
+
+/**
+ * The areas smaller than this are processed in the calling thread
+ * only, since waking up the threads would take more time than the
+ * processing itself
+ */
+const qint64 minParallelArea = 256 * 256;
+
+thread_local bool s_isWorkerThread = false;
+
+/**
+ * The limit is read from the config only once, and then it is updated
+ * by KisImageConfig::setMaxNumberOfThreads()
+ */
+QAtomicInt s_maxNumberOfThreads(0);
+
+int maxNumberOfThreads()
+{
+    int value = s_maxNumberOfThreads.loadAcquire();
+
+    if (!value) {
+        value = qMax(1, KisImageConfig(true).maxNumberOfThreads());
+        s_maxNumberOfThreads.testAndSetOrdered(0, value);
+    }
+
+    return value;
+}
+
+}
+
+namespace KritaUtils {
+
+WorkerThreadScope::WorkerThreadScope()
+    : m_wasWorkerThread(s_isWorkerThread)
+{
+    s_isWorkerThread = true;
+}
+
+WorkerThreadScope::~WorkerThreadScope()
+{
+    s_isWorkerThread = m_wasWorkerThread;
+}
+
+bool isWorkerThread()
+{
+    return s_isWorkerThread;
+}
+
+void setMaxNumberOfParallelThreads(int value)
+{
+    s_maxNumberOfThreads.storeRelease(qMax(1, value));
+}
+
+QVector<QRect> splitRectIntoTileAlignedBands(const QRect &rc, int numBands)
+{
+    using namespace KisAlgebra2D;
+
+    QVector<QRect> bands;
+    if (rc.isEmpty()) return bands;
+
+    const int firstRow = divideFloor(rc.top(), tileSize);
+    const int lastRow = divideFloor(rc.bottom(), tileSize);
+    const int numRows = lastRow - firstRow + 1;
+    const int rowsPerBand = qMax(1, (numRows + numBands - 1) / qMax(1, numBands));
+
+    for (int row = firstRow; row <= lastRow; row += rowsPerBand) {
+        const QRect band(rc.x(), row * tileSize, rc.width(), rowsPerBand * tileSize);
+        bands.append(band & rc);
+    }
+
+    return bands;
+}
+
+namespace {
+
+void processIndexesInParallelImpl(int size,
+                                  std::function<void(int)> indexProcessor,
+                                  bool allowParallelProcessing,
+                                  KoProgressProxy *progressProxy)
+{
+    if (size <= 0) return;
+
+    if (progressProxy) {
+        progressProxy->setRange(0, size);
+        progressProxy->setValue(0);
+    }
+
+    const int numThreads =
+        !allowParallelProcessing || isWorkerThread() ?
+            1 : qMin(maxNumberOfThreads(), size);
+
+    if (numThreads <= 1) {
+        for (int i = 0; i < size; i++) {
+            indexProcessor(i);
+
+            if (progressProxy) {
+                progressProxy->setValue(i + 1);
+            }
+        }
+        return;
+    }
+
+    QAtomicInt nextIndex(0);
+    QAtomicInt numProcessedIndexes(0);
+
+    auto workerFunc = [&] () {
+        WorkerThreadScope workerScope;
+
+        int index;
+        while ((index = nextIndex.fetchAndAddOrdered(1)) < size) {
+            indexProcessor(index);
+            numProcessedIndexes.ref();
+        }
+    };
+
+    QVector<QFuture<void>> workers;
+    for (int i = 0; i < numThreads - 1; i++) {
+        workers.append(QtConcurrent::run(workerFunc));
+    }
+
+    /**
+     * The calling thread doesn't just wait for the workers, but
+     * processes the indexes as well. It also guarantees that all of
+     * them will be processed even when the global thread pool is busy.
+     */
+    WorkerThreadScope workerScope;
+
+    int index;
+    while ((index = nextIndex.fetchAndAddOrdered(1)) < size) {
+        indexProcessor(index);
+        const int numProcessed = numProcessedIndexes.fetchAndAddOrdered(1) + 1;
+
+        if (progressProxy) {
+            progressProxy->setValue(numProcessed);
+        }
+    }
+
+    for (QFuture<void> &worker : workers) {
+        worker.waitForFinished();
+    }
+
+    if (progressProxy) {
+        progressProxy->setValue(size);
+    }
+}
+
+}
+
+void processIndexesInParallel(int size,
+                              std::function<void(int)> indexProcessor)
+{
+    processIndexesInParallelImpl(size, indexProcessor, true, nullptr);
+}
+
+void processRectsInParallel(const QVector<QRect> &rects,
+                            std::function<void(const QRect&)> rectProcessor,
+                            KoProgressProxy *progressProxy)
+{
+    qint64 totalArea = 0;
+    Q_FOREACH (const QRect &rc, rects) {
+        totalArea += qint64(rc.width()) * rc.height();
+    }
+
+    processIndexesInParallelImpl(rects.size(),
+                                 [&rects, &rectProcessor] (int index) {
+                                     rectProcessor(rects[index]);
+                                 },
+                                 totalArea >= minParallelArea,
+                                 progressProxy);
+}
+
+void processRectInParallel(const QRect &rc,
+                           std::function<void(const QRect&)> bandProcessor,
+                           KoProgressProxy *progressProxy)
+{
+    /**
+     * Use a few bands per thread to balance the load
+     * when some parts of the rect are cheaper to process
+     */
+    const int numBands = 2 * QThread::idealThreadCount();
+    processRectsInParallel(splitRectIntoTileAlignedBands(rc, numBands), bandProcessor, progressProxy);
+}
+
+}
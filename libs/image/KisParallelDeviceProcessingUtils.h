@@ -0,0 +1,148 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISPARALLELDEVICEPROCESSINGUTILS_H
+#define KISPARALLELDEVICEPROCESSINGUTILS_H
+
+#include <functional>
+
+#include <QRect>
+#include <QVector>
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+#include "kis_sequential_iterator.h"
+#include "KisRunnableStrokeJobUtils.h"
+
+class KoProgressProxy;
+
+namespace KritaUtils {
+
+/**
+ * Splits \p rc into horizontal bands, whose borders lie on the
+ * borders of the tile rows (of a device with zero offset). The
+ * rect is split into about \p numBands bands, but every band is
+ * at least one tile row high.
+ */
+KRITAIMAGE_EXPORT QVector<QRect> splitRectIntoTileAlignedBands(const QRect &rc, int numBands);
+
+/**
+ * Marks the current thread as a worker thread for the lifetime of
+ * the object. The threads of the updater context (which execute the
+ * stroke and merge jobs) and the threads of processRectsInParallel()
+ * itself are marked this way.
+ *
+ * The work running on such threads is already parallelized on the
+ * upper level, so processRectsInParallel() doesn't fan it out again.
+ * Otherwise every concurrent patch of a stroke would start its own
+ * set of threads, ignoring the user's limit on the number of threads.
+ */
+class KRITAIMAGE_EXPORT WorkerThreadScope
+{
+public:
+    WorkerThreadScope();
+    ~WorkerThreadScope();
+
+    WorkerThreadScope(const WorkerThreadScope &rhs) = delete;
+    WorkerThreadScope& operator=(const WorkerThreadScope &rhs) = delete;
+
+private:
+    bool m_wasWorkerThread;
+};
+
+/**
+ * \return true if the current thread is marked with WorkerThreadScope
+ */
+KRITAIMAGE_EXPORT bool isWorkerThread();
+
+/**
+ * Sets the number of threads processRectsInParallel() is allowed to use.
+ * Called by KisImageConfig when the user changes the limit.
+ */
+KRITAIMAGE_EXPORT void setMaxNumberOfParallelThreads(int value);
+
+/**
+ * Calls \p rectProcessor for every rect of \p rects using the number
+ * of threads allowed in the image settings. The calling thread takes
+ * part in the processing as well and reports the progress to
+ * \p progressProxy (the progress proxy is never accessed from other
+ * threads).
+ *
+ * When the total area of \p rects is too small to be worth waking
+ * up the threads, or when the calling thread is a worker thread (see
+ * WorkerThreadScope), the rects are processed in the calling thread
+ * only.
+ *
+ * \p rectProcessor is called concurrently, so it must be thread-safe.
+ * Usually it means that it should create its own iterators (and other
+ * stateful objects) for every rect it processes.
+ */
+KRITAIMAGE_EXPORT void processRectsInParallel(const QVector<QRect> &rects,
+                                              std::function<void(const QRect&)> rectProcessor,
+                                              KoProgressProxy *progressProxy = nullptr);
+
+/**
+ * Calls \p indexProcessor for every index in range [0, \p size) using
+ * the same rules as processRectsInParallel(). It is supposed to be used
+ * for the data other than the rects of the paint devices, e.g. for the
+ * points or the patches of the transformation meshes. Every call should
+ * process a reasonable amount of work, so the small tasks should be
+ * grouped into chunks by the caller.
+ */
+KRITAIMAGE_EXPORT void processIndexesInParallel(int size,
+                                                std::function<void(int)> indexProcessor);
+
+/**
+ * Splits \p rc into tile-aligned bands and processes them with
+ * processRectsInParallel()
+ */
+KRITAIMAGE_EXPORT void processRectInParallel(const QRect &rc,
+                                             std::function<void(const QRect&)> bandProcessor,
+                                             KoProgressProxy *progressProxy = nullptr);
+
+/**
+ * Adds a concurrent stroke job for every tile-aligned band of \p rc.
+ * It is an equivalent of processRectInParallel() for the code running
+ * inside a stroke: the bands are distributed among the threads by the
+ * stroke's scheduler, so the user's limit on the number of threads is
+ * respected and no scheduler thread is blocked waiting for other ones.
+ */
+template <typename Job>
+void addJobsForTileAlignedBands(QVector<Job*> &jobs,
+                                const QRect &rc,
+                                int numBands,
+                                std::function<void(const QRect&)> bandProcessor)
+{
+    Q_FOREACH (const QRect &band, splitRectIntoTileAlignedBands(rc, numBands)) {
+        addJobConcurrent(jobs, [band, bandProcessor] () { bandProcessor(band); });
+    }
+}
+
+/**
+ * Iterates through \p rc of \p device and passes the spans of
+ * consecutive pixels to \p spanProcessor, which should have the
+ * following signature:
+ *
+ * void spanProcessor(const quint8 *oldData, quint8 *data, int numPixels);
+ *
+ * The spans never cross the borders of the tiles, so the processor
+ * can work on the raw arrays of pixels directly.
+ */
+template <class SpanProcessor>
+void processSpans(KisPaintDeviceSP device, const QRect &rc, SpanProcessor spanProcessor)
+{
+    KisSequentialIterator it(device, rc);
+
+    int conseq = it.nConseqPixels();
+    while (it.nextPixels(conseq)) {
+        conseq = it.nConseqPixels();
+        spanProcessor(it.oldRawData(), it.rawData(), conseq);
+    }
+}
+
+}
+
+#endif // KISPARALLELDEVICEPROCESSINGUTILS_H
@@ -13,10 +13,13 @@
 #include <kis_paint_device.h>
 #include <kis_selection.h>
 
+#include <QScopedPointer>
+#include <QThread>
+
 #ifndef NDEBUG
 #include <QTime>
 #endif
-#include <KisSequentialIteratorProgress.h>
+#include <KisParallelDeviceProcessingUtils.h>
 #include "kis_color_transformation_configuration.h"
 
 KisColorTransformationFilter::KisColorTransformationFilter(const KoID& id, const KoID & category, const QString & entry) : KisFilter(id, category, entry)
@@ -48,13 +51,36 @@ void KisColorTransformationFilter::processImpl(KisPaintDeviceSP device,
     }
     if (!colorTransformation) return;
 
-    KisSequentialIteratorProgress it(device, applyRect, progressUpdater);
+    QThread *callingThread = QThread::currentThread();
 
-    int conseq = it.nConseqPixels();
-    while (it.nextPixels(conseq)) {
-        conseq = it.nConseqPixels();
-        colorTransformation->transform(it.oldRawData(), it.rawData(), conseq);
-    }
+    KritaUtils::processRectInParallel(applyRect,
+        [&] (const QRect &band) {
+            /**
+             * Color transformations are not thread-safe, so every
+             * thread should use its own one. The configuration keeps
+             * a separate transformation for every thread, otherwise
+             * a temporary one is created for the band.
+             */
+            KoColorTransformation *transformation = colorTransformation;
+            QScopedPointer<KoColorTransformation> bandTransformation;
+
+            if (QThread::currentThread() != callingThread) {
+                if (colorTransformationConfiguration) {
+                    transformation = colorTransformationConfiguration->colorTransformation(cs, this);
+                } else {
+                    bandTransformation.reset(createTransformation(cs, config));
+                    transformation = bandTransformation.data();
+                }
+            }
+
+            KIS_SAFE_ASSERT_RECOVER_RETURN(transformation);
+
+            KritaUtils::processSpans(device, band,
+                [transformation] (const quint8 *src, quint8 *dst, int numPixels) {
+                    transformation->transform(src, dst, numPixels);
+                });
+        },
+        progressUpdater);
 
     if (!colorTransformationConfiguration) {
         delete colorTransformation;
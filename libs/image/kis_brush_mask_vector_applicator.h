@@ -13,19 +13,60 @@
 
 #if defined(HAVE_XSIMD) && !defined(XSIMD_NO_SUPPORTED_ARCHITECTURE) && XSIMD_UNIVERSAL_BUILD_PASS
 
+#include <algorithm>
+#include <QVector>
+
 #include "kis_brush_mask_scalar_applicator.h"
 
 template<class V>
 struct FastRowProcessor {
     FastRowProcessor(V *maskGenerator)
         : d(maskGenerator->d.data())
+        , hasSpikes(maskGenerator->spikes() > 2)
+        , spikesAngle(static_cast<float>(M_PI / maskGenerator->spikes()))
     {
     }
 
     template<typename _impl>
     void process(float *buffer, int width, float y, float cosa, float sina, float centerX, float centerY);
 
+    /**
+     * Vectorized version of KisMaskGenerator::fixRotation(). Instead
+     * of rotating the point iteratively until it falls into the first
+     * spike sector, we calculate the number of the rotations directly
+     * and rotate the point only once.
+     *
+     * Just like in the scalar version, \p yr is expected to be
+     * non-negative.
+     */
+    template<typename _impl>
+    inline void fixRotation(xsimd::batch<float, _impl> &xr, xsimd::batch<float, _impl> &yr) const
+    {
+        using float_v = xsimd::batch<float, _impl>;
+
+        if (!hasSpikes) return;
+
+        const float_v vSpikesAngle(spikesAngle);
+        const float_v vSectorAngle(2.0f * spikesAngle);
+
+        const float_v angle = xsimd::atan2(yr, xr);
+        const float_v numRotations =
+            xsimd::max(xsimd::ceil((angle - vSpikesAngle) / vSectorAngle), float_v(0.0f));
+
+        const float_v rotation = -numRotations * vSectorAngle;
+        const float_v cs = xsimd::cos(rotation);
+        const float_v ss = xsimd::sin(rotation);
+
+        const float_v sx = xr;
+        const float_v sy = yr;
+
+        xr = cs * sx - ss * sy;
+        yr = ss * sx + cs * sy;
+    }
+
     typename V::Private *d;
+    bool hasSpikes;
+    float spikesAngle;
 };
 
 template<class MaskGenerator, typename _impl>
@@ -93,12 +134,58 @@ void KisBrushMaskVectorApplicator<MaskGenerator, impl>::processVector(const QRec
 
     auto *buffer =xsimd::vector_aligned_malloc<float>(simdWidth);
 
+    int supersample = 1;
+    if (m_maskGenerator->shouldSupersample()) {
+        // strengthen supersampling from 3x3 for very small dabs, to smooth out dashed strokes
+        supersample = (m_maskGenerator->shouldSupersample6x6() ? 6 : 3);
+    }
+    const float invss = 1.0f / supersample;
+    const float_v vSampleWeight(1.0f / pow2(supersample));
+
+    float *sampleBuffer = supersample > 1 ? xsimd::vector_aligned_malloc<float>(simdWidth) : nullptr;
+
+    QVector<quint8> alphaRow(width);
+
     FastRowProcessor<MaskGenerator> processor(m_maskGenerator);
 
     for (int y = rect.y(); y < rect.y() + rect.height(); y++) {
-        processor.template process<impl>(buffer, simdWidth, y, m_d->cosa, m_d->sina, m_d->centerX, m_d->centerY);
+        if (supersample == 1) {
+            processor.template process<impl>(buffer, simdWidth, y, m_d->cosa, m_d->sina, m_d->centerX, m_d->centerY);
+        } else {
+            /**
+             * The supersampled mask is just an average of the subpixel
+             * masks, shifted by the subpixel offset. Each of them is
+             * generated by the vectorized row processor.
+             */
+            std::fill(buffer, buffer + simdWidth, 0.0f);
+
+            for (int sy = 0; sy < supersample; sy++) {
+                for (int sx = 0; sx < supersample; sx++) {
+                    processor.template process<impl>(sampleBuffer, simdWidth,
+                                                     y + sy * invss,
+                                                     m_d->cosa, m_d->sina,
+                                                     m_d->centerX - sx * invss, m_d->centerY);
+
+                    for (size_t i = 0; i < simdWidth; i += float_v::size) {
+                        const float_v sum = float_v::load_aligned(buffer + i) + float_v::load_aligned(sampleBuffer + i);
+                        sum.store_aligned(buffer + i);
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < simdWidth; i += float_v::size) {
+                const float_v value = float_v::load_aligned(buffer + i) * vSampleWeight;
+                value.store_aligned(buffer + i);
+            }
+        }
 
         if (m_d->randomness != 0.0 || m_d->density != 1.0) {
+            /**
+             * The random source should be sampled in exactly the same
+             * order as in the scalar version, so we first generate
+             * the alpha values for the entire row and only then apply
+             * them to the dab in one go.
+             */
             for (int x = 0; x < width; x++) {
                 if (m_d->randomness != 0.0) {
                     random = (1.0 - m_d->randomness)
@@ -119,13 +206,19 @@ void KisBrushMaskVectorApplicator<MaskGenerator, impl>::processVector(const QRec
                     }
                 }
 
-                if (m_d->color) {
-                    memcpy(dabPointer, m_d->color, m_d->pixelSize);
-                }
+                alphaRow[x] = alphaValue;
+            }
 
-                m_d->colorSpace->applyAlphaU8Mask(dabPointer, &alphaValue, 1);
-                dabPointer += m_d->pixelSize;
+            if (m_d->color) {
+                quint8 *pixelPointer = dabPointer;
+                for (int x = 0; x < width; x++) {
+                    memcpy(pixelPointer, m_d->color, m_d->pixelSize);
+                    pixelPointer += m_d->pixelSize;
+                }
             }
+
+            m_d->colorSpace->applyAlphaU8Mask(dabPointer, alphaRow.data(), width);
+            dabPointer += width * m_d->pixelSize;
         } else if (m_d->color) {
             m_d->colorSpace->fillInverseAlphaNormedFloatMaskWithColor(dabPointer, buffer, m_d->color, width);
             dabPointer += width * m_d->pixelSize;
@@ -136,6 +229,9 @@ void KisBrushMaskVectorApplicator<MaskGenerator, impl>::processVector(const QRec
         dabPointer += offset;
     } // endfor y
     xsimd::vector_aligned_free(buffer);
+    if (sampleBuffer) {
+        xsimd::vector_aligned_free(sampleBuffer);
+    }
 }
 
 #endif /* defined HAVE_XSIMD */
@@ -191,16 +191,16 @@ QVector<QPointF> KisCageTransformWorker::Private::calculateTransformedPoints()
     const int numValidPoints = validPoints.size();
     QVector<QPointF> transformedPoints(numValidPoints);
 
-    for (int i = 0; i < numValidPoints; i++) {
-        transformedPoints[i] = cage.transformedPoint(i, transfCage);
-
-        if (qIsNaN(transformedPoints[i].x()) ||
-            qIsNaN(transformedPoints[i].y())) {
-            warnKrita << "WARNING: One grid point has been removed from consideration" << validPoints[i];
-            transformedPoints[i] = validPoints[i];
-        }
-
-    }
+    GridIterationTools::parallelForEachIndex(numValidPoints,
+        [&] (int i) {
+            transformedPoints[i] = cage.transformedPoint(i, transfCage);
+
+            if (qIsNaN(transformedPoints[i].x()) ||
+                qIsNaN(transformedPoints[i].y())) {
+                warnKrita << "WARNING: One grid point has been removed from consideration" << validPoints[i];
+                transformedPoints[i] = validPoints[i];
+            }
+        });
 
     return transformedPoints;
 }
@@ -356,11 +356,13 @@ void KisCageTransformWorker::run(KisPaintDeviceSP srcDevice, KisPaintDeviceSP ds
 
     GridIterationTools::PaintDevicePolygonOp polygonOp(srcDevice, tempDevice);
     Private::MapIndexesOp indexesOp(m_d.data());
-    GridIterationTools::iterateThroughGrid
+    GridIterationTools::iterateThroughGridConcurrently
         <GridIterationTools::IncompletePolygonPolicy>(polygonOp, indexesOp,
                                                       m_d->gridSize,
                                                       m_d->validPoints,
-                                                      transformedPoints);
+                                                      transformedPoints,
+                                                      KisAlgebra2D::approximateRectFromPoints(transformedPoints).toAlignedRect(),
+                                                      false);
 
     QRect rect = tempDevice->extent();
     KisPainter gc(dstDevice);
@@ -416,13 +418,19 @@ QImage KisCageTransformWorker::runOnQImage(QPointF *newOffset)
         gc.end();
     }
 
+    // tempImage shares the data with dstImage, so detach it before
+    // writing into it from several threads
+    tempImage.detach();
+
     GridIterationTools::QImagePolygonOp polygonOp(m_d->srcImage, tempImage, m_d->srcImageOffset, dstQImageOffset);
     Private::MapIndexesOp indexesOp(m_d.data());
-    GridIterationTools::iterateThroughGrid
+    GridIterationTools::iterateThroughGridConcurrently
         <GridIterationTools::IncompletePolygonPolicy>(polygonOp, indexesOp,
                                                       m_d->gridSize,
                                                       m_d->validPoints,
-                                                      transformedPoints);
+                                                      transformedPoints,
+                                                      tempImage.rect(),
+                                                      true, 16);
 
     {
         QPainter gc(&dstImage);
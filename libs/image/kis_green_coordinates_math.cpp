@@ -9,6 +9,7 @@
 #include <cmath>
 #include <kis_global.h>
 #include <kis_algebra_2d.h>
+#include "kis_grid_interpolation_tools.h"
 using namespace KisAlgebra2D;
 
 
@@ -139,15 +140,21 @@ void KisGreenCoordinatesMath::precalculateGreenCoordinates(const QVector<QPointF
 
     m_d->precalculatedCoords.resize(numPoints);
 
-    for (int i = 0; i < numPoints; i++) {
-        m_d->precalculatedCoords[i].psi.resize(numCagePoints);
-        m_d->precalculatedCoords[i].phi.resize(numCagePoints);
-
-        m_d->precalculateOnePoint(originalCage,
-                                  &m_d->precalculatedCoords[i],
-                                  points[i],
-                                  cageDirection);
-    }
+    /**
+     * Every point depends on all the edges of the cage, so for big cages
+     * the precalculation is rather expensive. The points are independent
+     * though, so we can precalculate them concurrently.
+     */
+    GridIterationTools::parallelForEachIndex(numPoints,
+        [&] (int i) {
+            m_d->precalculatedCoords[i].psi.resize(numCagePoints);
+            m_d->precalculatedCoords[i].phi.resize(numCagePoints);
+
+            m_d->precalculateOnePoint(originalCage,
+                                      &m_d->precalculatedCoords[i],
+                                      points[i],
+                                      cageDirection);
+        }, 16);
 }
 
 void KisGreenCoordinatesMath::generateTransformedCageNormals(const QVector<QPointF> &transformedCage)
@@ -172,18 +179,19 @@ void KisGreenCoordinatesMath::generateTransformedCageNormals(const QVector<QPoin
     }
 }
 
-QPointF KisGreenCoordinatesMath::transformedPoint(int pointIndex, const QVector<QPointF> &transformedCage)
+QPointF KisGreenCoordinatesMath::transformedPoint(int pointIndex, const QVector<QPointF> &transformedCage) const
 {
     QPointF result;
 
     const int numCagePoints = transformedCage.size();
 
 
-    PrecalculatedCoords *coords = &m_d->precalculatedCoords[pointIndex];
+    const PrecalculatedCoords &coords = m_d->precalculatedCoords.at(pointIndex);
+    const QVector<QPointF> &transformedCageNormals = m_d->transformedCageNormals;
 
     for (int i = 0; i < numCagePoints; i++) {
-        result += coords->phi[i] * transformedCage[i];
-        result += coords->psi[i] * m_d->transformedCageNormals[i];
+        result += coords.phi[i] * transformedCage[i];
+        result += coords.psi[i] * transformedCageNormals[i];
     }
 
     return result;
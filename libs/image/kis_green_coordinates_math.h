@@ -36,8 +36,11 @@ public:
 
     /**
      * Transform one point according to its index
+     *
+     * The method is reentrant, so different points can be transformed
+     * from different threads concurrently
      */
-    QPointF transformedPoint(int pointIndex, const QVector<QPointF> &transformedCage);
+    QPointF transformedPoint(int pointIndex, const QVector<QPointF> &transformedCage) const;
 
 private:
     struct Private;
@@ -11,12 +11,14 @@
 #include <algorithm>
 
 #include <QImage>
+#include <QThread>
 
 #include "kis_algebra_2d.h"
 #include "kis_four_point_interpolator_forward.h"
 #include "kis_four_point_interpolator_backward.h"
 #include "kis_iterator_ng.h"
 #include "kis_random_sub_accessor.h"
+#include "KisParallelDeviceProcessingUtils.h"
 
 //#define DEBUG_PAINTING_POLYGONS
 
@@ -167,12 +169,25 @@ struct PaintDevicePolygonOp
     PaintDevicePolygonOp(KisPaintDeviceSP srcDev, KisPaintDeviceSP dstDev)
         : m_srcDev(srcDev), m_dstDev(dstDev) {}
 
+    /**
+     * Limit all the writes of the op to \p rect of the destination
+     * device. It allows a few ops to write into the same device from
+     * different threads, as long as their clip rects are tile-aligned
+     * and do not intersect.
+     */
+    void setDstClipRect(const QRect &rect) {
+        m_dstClipRect = rect;
+    }
+
     void operator() (const QPolygonF &srcPolygon, const QPolygonF &dstPolygon) {
         this->operator() (srcPolygon, dstPolygon, dstPolygon);
     }
 
     void operator() (const QPolygonF &srcPolygon, const QPolygonF &dstPolygon, const QPolygonF &clipDstPolygon) {
         QRect boundRect = clipDstPolygon.boundingRect().toAlignedRect();
+        if (!m_dstClipRect.isNull()) {
+            boundRect &= m_dstClipRect;
+        }
         if (boundRect.isEmpty()) return;
 
         KisSequentialIterator dstIt(m_dstDev, boundRect);
@@ -232,6 +247,7 @@ struct PaintDevicePolygonOp
 
     KisPaintDeviceSP m_srcDev;
     KisPaintDeviceSP m_dstDev;
+    QRect m_dstClipRect;
 };
 
 struct QImagePolygonOp
@@ -243,16 +259,47 @@ struct QImagePolygonOp
           m_srcImageOffset(srcImageOffset),
           m_dstImageOffset(dstImageOffset),
           m_srcImageRect(m_srcImage.rect()),
-          m_dstImageRect(m_dstImage.rect())
+          m_dstImageRect(m_dstImage.rect()),
+          m_dstBits(m_dstImage.bits()),
+          m_dstBytesPerLine(m_dstImage.bytesPerLine())
     {
+        /**
+         * The pixels are written through the raw pointer fetched
+         * above, because QImage::setPixel() detaches the image on
+         * every call, which is not thread-safe. The destination
+         * image is detached only once, here, before the operation
+         * is copied into the concurrent stripes.
+         */
+        KIS_SAFE_ASSERT_RECOVER_NOOP(m_dstImage.format() == QImage::Format_ARGB32 ||
+                                     m_dstImage.format() == QImage::Format_ARGB32_Premultiplied ||
+                                     m_dstImage.format() == QImage::Format_RGB32);
     }
 
     void operator() (const QPolygonF &srcPolygon, const QPolygonF &dstPolygon) {
         this->operator() (srcPolygon, dstPolygon, dstPolygon);
     }
 
+    /**
+     * \see PaintDevicePolygonOp::setDstClipRect()
+     *
+     * NOTE: the rect is defined in the coordinate system of the
+     *       destination image, not in the image space
+     */
+    void setDstClipRect(const QRect &rect) {
+        m_dstImageRect = rect & m_dstImage.rect();
+        m_hasDstClipRect = true;
+    }
+
     void operator() (const QPolygonF &srcPolygon, const QPolygonF &dstPolygon, const QPolygonF &clipDstPolygon) {
         QRect boundRect = clipDstPolygon.boundingRect().toAlignedRect();
+
+        if (m_hasDstClipRect) {
+            // the per-pixel check below does the exact clipping, here we
+            // only reject the polygons that are obviously outside
+            boundRect &= m_dstImageRect.translated(m_dstImageOffset.toPoint()).adjusted(-1, -1, 1, 1);
+            if (boundRect.isEmpty()) return;
+        }
+
         KisFourPointInterpolatorBackward interp(srcPolygon, dstPolygon);
 
         for (int y = boundRect.top(); y <= boundRect.bottom(); y++) {
@@ -277,7 +324,8 @@ struct QImagePolygonOp
                     if (!m_dstImageRect.contains(srcPointI)) continue;
                     if (!m_srcImageRect.contains(dstPointI)) continue;
 
-                    m_dstImage.setPixel(srcPointI, m_srcImage.pixel(dstPointI));
+                    QRgb *dstLine = reinterpret_cast<QRgb*>(m_dstBits + srcPointI.y() * m_dstBytesPerLine);
+                    dstLine[srcPointI.x()] = m_srcImage.pixel(dstPointI);
                 }
             }
         }
@@ -304,6 +352,9 @@ struct QImagePolygonOp
 
     QRect m_srcImageRect;
     QRect m_dstImageRect;
+    uchar *m_dstBits;
+    int m_dstBytesPerLine;
+    bool m_hasDstClipRect = false;
 };
 
 /*************************************************************/
@@ -341,13 +392,14 @@ inline int pointToIndex(const QPoint &cellPt, const QSize &gridSize)
 namespace Private {
     inline QPoint pointPolygonIndexToColRow(QPoint baseColRow, int index)
     {
-        static QVector<QPoint> pointOffsets;
-        if (pointOffsets.isEmpty()) {
-            pointOffsets << QPoint(0,0);
-            pointOffsets << QPoint(1,0);
-            pointOffsets << QPoint(1,1);
-            pointOffsets << QPoint(0,1);
-        }
+        // the grid may be iterated from several threads concurrently,
+        // so the table must be initialized in a thread-safe way
+        static const QPoint pointOffsets[4] = {
+            QPoint(0,0),
+            QPoint(1,0),
+            QPoint(1,1),
+            QPoint(0,1)
+        };
 
         return baseColRow + pointOffsets[index];
     }
@@ -639,6 +691,200 @@ void iterateThroughGrid(PolygonOp &polygonOp,
     }
 }
 
+/*************************************************************/
+/*      Parallel evaluation of the grid                      */
+/*************************************************************/
+
+/**
+ * Runs \p func(index) for every index in range [0, size). The range is
+ * split into chunks that are processed with
+ * KritaUtils::processIndexesInParallel(), so the chunks are processed
+ * in the calling thread only when it is a worker thread of the
+ * scheduler (e.g. inside a stroke job).
+ *
+ * The function is expected to write into non-intersecting memory only.
+ */
+template <class Func>
+void parallelForEachIndex(int size, Func func, int minChunkSize = 64)
+{
+    if (size <= 0) return;
+
+    const int numThreads = qMax(1, QThread::idealThreadCount());
+    const int chunkSize = qMax(minChunkSize, (size + 4 * numThreads - 1) / (4 * numThreads));
+    const int numChunks = (size + chunkSize - 1) / chunkSize;
+
+    KritaUtils::processIndexesInParallel(numChunks,
+        [&func, chunkSize, size] (int chunk) {
+            const int end = qMin(size, (chunk + 1) * chunkSize);
+            for (int i = chunk * chunkSize; i < end; i++) {
+                func(i);
+            }
+        });
+}
+
+/**
+ * Splits \p rect into horizontal stripes, whose borders are aligned
+ * to \p alignment. When \p alignment is equal to the tile size, the
+ * stripes never share any tile, so they can be written into the same
+ * paint device concurrently.
+ */
+inline QVector<QRect> splitIntoAlignedStripes(const QRect &rect, int alignment)
+{
+    QVector<QRect> stripes;
+    if (rect.isEmpty()) return stripes;
+
+    const int numThreads = qMax(1, QThread::idealThreadCount());
+    const int idealHeight = rect.height() / (2 * numThreads);
+    const int stripeHeight = qMax(alignment, idealHeight / alignment * alignment);
+
+    int top = rect.top();
+    while (top <= rect.bottom()) {
+        int bottom = (top / stripeHeight + 1) * stripeHeight - 1;
+
+        // division of negative numbers rounds towards zero
+        if (top < 0 && top % stripeHeight != 0) {
+            bottom -= stripeHeight;
+        }
+
+        bottom = qMin(bottom, rect.bottom());
+        stripes.append(QRect(rect.left(), top, rect.width(), bottom - top + 1));
+        top = bottom + 1;
+    }
+
+    return stripes;
+}
+
+/**
+ * Runs \p func(stripe) for every stripe concurrently, using the rules
+ * of KritaUtils::processRectsInParallel()
+ */
+template <class Func>
+void processStripesConcurrently(const QVector<QRect> &stripes, Func func)
+{
+    KritaUtils::processRectsInParallel(stripes, func);
+}
+
+struct GridPointsCollectorOp
+{
+    inline void processPoint(int col, int row,
+                             int prevCol, int prevRow,
+                             int colIndex, int rowIndex) {
+
+        Q_UNUSED(prevCol);
+        Q_UNUSED(prevRow);
+        Q_UNUSED(colIndex);
+        Q_UNUSED(rowIndex);
+
+        m_points << QPointF(col, row);
+    }
+
+    inline void nextLine() {
+    }
+
+    QVector<QPointF> m_points;
+};
+
+/**
+ * Evaluates the forward transformation \p transformOp on the regular
+ * lattice defined by \p srcBounds and \p pixelPrecision. The points of
+ * the lattice are independent, so they are evaluated concurrently. The
+ * points are stored in the same order as processGrid() visits them, so
+ * the result can be fed into PrecalculatedTransformOp or
+ * iterateThroughGrid() afterwards.
+ */
+template <class ForwardTransform>
+void calculateGridPoints(const QRect &srcBounds, const int pixelPrecision,
+                         const ForwardTransform &transformOp,
+                         QSize *gridSize,
+                         QVector<QPointF> *originalPoints,
+                         QVector<QPointF> *transformedPoints)
+{
+    GridPointsCollectorOp pointsOp;
+    processGrid(pointsOp, srcBounds, pixelPrecision);
+
+    *gridSize = calcGridSize(srcBounds, pixelPrecision);
+    *originalPoints = pointsOp.m_points;
+
+    const QVector<QPointF> &srcPoints = *originalPoints;
+    QVector<QPointF> &dstPoints = *transformedPoints;
+    dstPoints.resize(srcPoints.size());
+
+    parallelForEachIndex(srcPoints.size(),
+        [&] (int i) {
+            dstPoints[i] = transformOp(srcPoints[i]);
+        });
+}
+
+/**
+ * A forward transformation op that returns precalculated points in the
+ * order processGrid() requests them. Each op can be used for a single
+ * pass of processGrid() only.
+ */
+struct PrecalculatedTransformOp
+{
+    PrecalculatedTransformOp(const QVector<QPointF> &transformedPoints)
+        : m_transformedPoints(transformedPoints)
+    {
+    }
+
+    inline QPointF operator() (const QPointF &pt) {
+        Q_UNUSED(pt);
+        KIS_SAFE_ASSERT_RECOVER_NOOP(m_currentIndex < m_transformedPoints.size());
+        return m_transformedPoints[m_currentIndex++];
+    }
+
+    const QVector<QPointF> &m_transformedPoints;
+    int m_currentIndex = 0;
+};
+
+/**
+ * Rasterizes the grid into \p dstRect of the destination concurrently.
+ * The rect is split into tile-aligned stripes, and each stripe gets its own
+ * copy of \p polygonOp clipped to this stripe. Every stripe visits the
+ * polygons in the same order as the sequential version, so the result is
+ * exactly the same.
+ *
+ * If \p clipToDstRect is false, the outer stripes are extended to infinity,
+ * so the polygons lying outside \p dstRect (e.g. the extrapolated incomplete
+ * polygons) are still rasterized.
+ */
+template <template <class PolygonOp, class IndexesOp> class IncompletePolygonPolicy,
+          class PolygonOp,
+          class IndexesOp>
+void iterateThroughGridConcurrently(const PolygonOp &polygonOp,
+                                    IndexesOp &indexesOp,
+                                    const QSize &gridSize,
+                                    const QVector<QPointF> &originalPoints,
+                                    const QVector<QPointF> &transformedPoints,
+                                    const QRect &dstRect,
+                                    bool clipToDstRect,
+                                    int stripeAlignment = 64)
+{
+    QVector<QRect> stripes = splitIntoAlignedStripes(dstRect, stripeAlignment);
+
+    if (!clipToDstRect && !stripes.isEmpty()) {
+        const int unboundedMargin = 1 << 24;
+
+        for (auto it = stripes.begin(); it != stripes.end(); ++it) {
+            it->adjust(-unboundedMargin, 0, unboundedMargin, 0);
+        }
+
+        stripes.first().adjust(0, -unboundedMargin, 0, 0);
+        stripes.last().adjust(0, 0, 0, unboundedMargin);
+    }
+
+    processStripesConcurrently(stripes,
+        [&] (const QRect &stripe) {
+            PolygonOp stripeOp(polygonOp);
+            stripeOp.setDstClipRect(stripe);
+
+            iterateThroughGrid<IncompletePolygonPolicy>(stripeOp, indexesOp,
+                                                        gridSize,
+                                                        originalPoints,
+                                                        transformedPoints);
+        });
+}
+
 }
 
 #endif /* __KIS_GRID_INTERPOLATION_TOOLS_H */
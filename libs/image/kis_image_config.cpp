@@ -22,6 +22,7 @@
 #include <QDir>
 
 #include "kis_global.h"
+#include "KisParallelDeviceProcessingUtils.h"
 #include <cmath>
 #include <QTemporaryFile>
 
@@ -168,6 +169,28 @@ void KisImageConfig::setSwapWindowSize(int value)
     m_config.writeEntry("swapWindowSize", value);
 }
 
+bool KisImageConfig::deduplicateSwappedTiles(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("deduplicateSwappedTiles", true) : true;
+}
+
+void KisImageConfig::setDeduplicateSwappedTiles(bool value)
+{
+    m_config.writeEntry("deduplicateSwappedTiles", value);
+}
+
+int KisImageConfig::undoMemoryLimit(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("undoMemoryLimit", 0) : 0;
+}
+
+void KisImageConfig::setUndoMemoryLimit(int value)
+{
+    m_config.writeEntry("undoMemoryLimit", value);
+}
+
 int KisImageConfig::tilesHardLimit() const
 {
     qreal hp = qreal(memoryHardLimitPercent()) / 100.0;
@@ -559,6 +582,8 @@ int KisImageConfig::maxNumberOfThreads(bool defaultValue) const
 
 void KisImageConfig::setMaxNumberOfThreads(int value)
 {
+    KritaUtils::setMaxNumberOfParallelThreads(value);
+
     if (value == QThread::idealThreadCount()) {
         m_config.deleteEntry("maxNumberOfThreads");
     } else {
@@ -46,6 +46,17 @@ public:
     int swapWindowSize() const;
     void setSwapWindowSize(int value);
 
+    bool deduplicateSwappedTiles(bool requestDefault = false) const;
+    void setDeduplicateSwappedTiles(bool value);
+
+    /**
+     * The amount of undo data (in MiB) allowed to stay uncompressed in
+     * memory. When the history grows larger, the oldest undo tiles are
+     * moved into the swap store. Zero means no limit.
+     */
+    int undoMemoryLimit(bool requestDefault = false) const; // MiB
+    void setUndoMemoryLimit(int value);
+
     int tilesHardLimit() const; // MiB
     int tilesSoftLimit() const; // MiB
     int poolLimit() const; // MiB
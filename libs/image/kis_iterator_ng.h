@@ -28,6 +28,21 @@ public:
      * @return return number of consequential numbers of pixels, useful for optimization
      */
     virtual qint32 nConseqPixels() const = 0;
+    /**
+     * @return the number of pixels along the line, starting from the
+     * current one, that belong to the areas of the device that have never
+     * been written to. All these pixels are guaranteed to be equal to the
+     * default pixel of the device, so the caller may process them in bulk
+     * and skip them with nextPixels(). Zero is returned if the current
+     * pixel may differ from the default one.
+     *
+     * NOTE: only the current data of the device is checked, the pixels
+     *       returned by oldRawData() may still differ from the default
+     *       pixel.
+     *
+     * Writable iterators always return zero.
+     */
+    virtual qint32 nConseqDefaultPixels() const = 0;
 };
 
 //class KRITAIMAGE_EXPORT KisBaseIteratorNG : public virtual KisBaseConstIteratorNG, public virtual KisBaseAccessor
@@ -6,6 +6,8 @@
 
 #include "kis_liquify_transform_worker.h"
 
+#include <QPainter>
+
 #include <KoColorSpace.h>
 #include "kis_grid_interpolation_tools.h"
 #include "kis_dom_utils.h"
@@ -32,8 +34,28 @@ struct Q_DECL_HIDDEN KisLiquifyTransformWorker::Private
     int pixelPrecision;
     QSize gridSize;
 
+    /**
+     * Dirty state of the grid since the last call to resetDirtyState():
+     *
+     * dirtyGridRect --- the rect of all the modified points in grid
+     *                   (col, row) coordinates
+     * dirtyOldDstRect --- the bounding rect of the positions of the
+     *                     modified points *before* the modification
+     * allPointsDirty --- the whole grid has been changed, e.g. translated
+     */
+    QRect dirtyGridRect;
+    QRectF dirtyOldDstRect;
+    bool allPointsDirty = true;
+
     void preparePoints();
 
+    inline void markPointDirty(int index, const QPointF &oldPos) {
+        dirtyGridRect |= QRect(index % gridSize.width(), index / gridSize.width(), 1, 1);
+        KisAlgebra2D::accumulateBounds(oldPos, &dirtyOldDstRect);
+    }
+
+    QRectF calcDirtyDstRect() const;
+
     struct MapIndexesOp;
 
     template <class ProcessOp>
@@ -69,6 +91,9 @@ KisLiquifyTransformWorker::KisLiquifyTransformWorker(const QRect &srcBounds,
 KisLiquifyTransformWorker::KisLiquifyTransformWorker(const KisLiquifyTransformWorker &rhs)
     : m_d(new Private(*rhs.m_d.data()))
 {
+    // the copy has never been rendered by anyone, so there is
+    // nothing that could be updated incrementally
+    m_d->allPointsDirty = true;
 }
 
 KisLiquifyTransformWorker::~KisLiquifyTransformWorker()
@@ -174,6 +199,8 @@ void KisLiquifyTransformWorker::translate(const QPointF &offset)
         *it += offset;
         *refIt += offset;
     }
+
+    m_d->allPointsDirty = true;
 }
 
 void KisLiquifyTransformWorker::translateDstSpace(const QPointF &offset)
@@ -184,6 +211,8 @@ void KisLiquifyTransformWorker::translateDstSpace(const QPointF &offset)
     for (; it != end; ++it) {
         *it += offset;
     }
+
+    m_d->allPointsDirty = true;
 }
 
 void KisLiquifyTransformWorker::undoPoints(const QPointF &base,
@@ -211,6 +240,8 @@ void KisLiquifyTransformWorker::undoPoints(const QPointF &base,
 
         qreal lambda = exp(-0.5 * pow2(dist / sigma));
         lambda *= amount;
+
+        m_d->markPointDirty(it - m_d->transformedPoints.begin(), *it);
         *it = *refIt * lambda + *it * (1.0 - lambda);
     }
 }
@@ -236,6 +267,8 @@ processTransformedPixelsBuildUp(ProcessOp op,
         if (dist > maxDist) continue;
 
         const qreal lambda = exp(-0.5 * pow2(dist / sigma));
+
+        markPointDirty(it - transformedPoints.begin(), *it);
         *it = op(*it, base, diff, lambda);
     }
 }
@@ -269,6 +302,7 @@ processTransformedPixelsWash(ProcessOp op,
         QPointF dstPt = op(*refIt, base, diff, lambda);
 
         if (kisDistance(dstPt, *refIt) > kisDistance(*it, *refIt)) {
+            markPointDirty(it - transformedPoints.begin(), *it);
             *it = (1.0 - flow) * (*it) + flow * dstPt;
         }
     }
@@ -445,6 +479,8 @@ void KisLiquifyTransformWorker::transformSrcAndDst(const QTransform &t)
     for (auto it = m_d->transformedPoints.begin(); it != m_d->transformedPoints.end(); ++it) {
         *it = t.map(*it);
     }
+
+    m_d->allPointsDirty = true;
 }
 
 #include <functional>
@@ -514,6 +550,124 @@ QImage KisLiquifyTransformWorker::runOnQImage(const QImage &srcImage,
     return dstImage;
 }
 
+QRectF KisLiquifyTransformWorker::Private::calcDirtyDstRect() const
+{
+    QRectF dirtyRect = dirtyOldDstRect;
+
+    /**
+     * The modified points have moved, so all the cells having these
+     * points as their corners have changed. Therefore we should
+     * include the neighbouring points as well.
+     */
+    const QRect neighbourhood =
+        dirtyGridRect.adjusted(-1, -1, 1, 1) & QRect(QPoint(), gridSize);
+
+    for (int row = neighbourhood.top(); row <= neighbourhood.bottom(); row++) {
+        for (int col = neighbourhood.left(); col <= neighbourhood.right(); col++) {
+            const int index = GridIterationTools::pointToIndex(QPoint(col, row), gridSize);
+            KisAlgebra2D::accumulateBounds(transformedPoints[index], &dirtyRect);
+        }
+    }
+
+    return dirtyRect;
+}
+
+bool KisLiquifyTransformWorker::updateQImageIncrementally(const QImage &srcImage,
+                                                          const QPointF &srcImageOffset,
+                                                          const QTransform &imageToThumbTransform,
+                                                          QImage *dstImage,
+                                                          const QPointF &dstImageOffset)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_d->originalPoints.size() == m_d->transformedPoints.size(), false);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(dstImage, false);
+
+    if (m_d->allPointsDirty || dstImage->isNull() ||
+        srcImage.format() != QImage::Format_ARGB32 ||
+        dstImage->format() != srcImage.format()) {
+
+        return false;
+    }
+
+    if (m_d->dirtyGridRect.isEmpty()) return true;
+
+    const QRectF dirtyThumbRect = imageToThumbTransform.mapRect(m_d->calcDirtyDstRect());
+    const QRectF dstImageThumbRect(dstImageOffset, dstImage->size());
+
+    /**
+     * If the points went outside the previously generated image, we
+     * cannot just patch it, the image should be regenerated fully
+     */
+    if (!dstImageThumbRect.contains(dirtyThumbRect)) return false;
+
+    const QRect dirtyImageRect =
+        dirtyThumbRect.translated(-dstImageOffset).toAlignedRect()
+            .adjusted(-1, -1, 1, 1) & dstImage->rect();
+
+    if (dirtyImageRect.isEmpty()) return true;
+
+    // make sure the image is not shared before writing into it concurrently
+    dstImage->detach();
+
+    {
+        QPainter gc(dstImage);
+        gc.setCompositionMode(QPainter::CompositionMode_Source);
+        gc.fillRect(dirtyImageRect, Qt::transparent);
+    }
+
+    QVector<QPointF> originalPointsLocal(m_d->originalPoints);
+    QVector<QPointF> transformedPointsLocal(m_d->transformedPoints);
+
+    PointMapFunction mapFunc = bindPointMapTransform(imageToThumbTransform);
+
+    std::transform(originalPointsLocal.begin(), originalPointsLocal.end(),
+                   originalPointsLocal.begin(), mapFunc);
+
+    std::transform(transformedPointsLocal.begin(), transformedPointsLocal.end(),
+                   transformedPointsLocal.begin(), mapFunc);
+
+    /**
+     * Every polygon of the grid is rasterized in the same order as in
+     * runOnQImage(), but the writes are clipped to the dirty rect, so the
+     * result is exactly the same as after the full regeneration.
+     *
+     * The destination image has already been detached above, so the
+     * concurrent stripes write through the raw scanlines fetched by the
+     * polygon op only.
+     */
+    GridIterationTools::QImagePolygonOp polygonOp(srcImage, *dstImage, srcImageOffset, dstImageOffset);
+    GridIterationTools::RegularGridIndexesOp indexesOp(m_d->gridSize);
+    GridIterationTools::iterateThroughGridConcurrently
+        <GridIterationTools::AlwaysCompletePolygonPolicy>(polygonOp, indexesOp,
+                                                          m_d->gridSize,
+                                                          originalPointsLocal,
+                                                          transformedPointsLocal,
+                                                          dirtyImageRect,
+                                                          true, 16);
+
+    return true;
+}
+
+QRectF KisLiquifyTransformWorker::dirtyDstRect() const
+{
+    if (m_d->allPointsDirty) {
+        return KisAlgebra2D::approximateRectFromPoints(m_d->transformedPoints);
+    }
+
+    return m_d->dirtyGridRect.isEmpty() ? QRectF() : m_d->calcDirtyDstRect();
+}
+
+bool KisLiquifyTransformWorker::hasDirtyPoints() const
+{
+    return m_d->allPointsDirty || !m_d->dirtyGridRect.isEmpty();
+}
+
+void KisLiquifyTransformWorker::resetDirtyState()
+{
+    m_d->dirtyGridRect = QRect();
+    m_d->dirtyOldDstRect = QRectF();
+    m_d->allPointsDirty = false;
+}
+
 void KisLiquifyTransformWorker::toXML(QDomElement *e) const
 {
     QDomDocument doc = e->ownerDocument();
@@ -15,6 +15,8 @@
 
 class QImage;
 class QRect;
+class QRectF;
+class QPointF;
 class QSize;
 class QTransform;
 class QDomElement;
@@ -69,6 +71,31 @@ public:
                        const QTransform &imageToThumbTransform,
                        QPointF *newOffset);
 
+    /**
+     * Updates \p dstImage generated by a previous call to runOnQImage()
+     * with the same source image and transform. Only the area touched by
+     * the points modified since the last call to resetDirtyState() is
+     * regenerated, the rest of the image is reused as it is.
+     *
+     * \return false if the incremental update is impossible (e.g. the
+     *         whole grid was moved or the points went outside \p dstImage),
+     *         in which case the caller should regenerate the image with
+     *         runOnQImage()
+     */
+    bool updateQImageIncrementally(const QImage &srcImage,
+                                   const QPointF &srcImageOffset,
+                                   const QTransform &imageToThumbTransform,
+                                   QImage *dstImage,
+                                   const QPointF &dstImageOffset);
+
+    /**
+     * The area in the image space affected by the points modified since
+     * the last call to resetDirtyState()
+     */
+    QRectF dirtyDstRect() const;
+    bool hasDirtyPoints() const;
+    void resetDirtyState();
+
     void toXML(QDomElement *e) const;
     static KisLiquifyTransformWorker* fromXML(const QDomElement &e);
 
@@ -6,6 +6,8 @@
 
 #include "kis_memory_statistics_server.h"
 
+#include <algorithm>
+
 #include <QGlobalStatic>
 #include <QApplication>
 
@@ -55,7 +57,8 @@ inline void addDevice(KisPaintDeviceSP dev,
                       qint64 &memBound,
                       qint64 &layersSize,
                       qint64 &projectionsSize,
-                      qint64 &lodSize)
+                      qint64 &lodSize,
+                      qint64 &historySize)
 {
     if (dev && !devices.contains(dev.data())) {
         devices.insert(dev.data());
@@ -63,8 +66,9 @@ inline void addDevice(KisPaintDeviceSP dev,
         qint64 imageData = 0;
         qint64 temporaryData = 0;
         qint64 lodData = 0;
+        qint64 historyData = 0;
 
-        dev->estimateMemoryStats(imageData, temporaryData, lodData);
+        dev->estimateMemoryStats(imageData, temporaryData, lodData, historyData);
         memBound += imageData + temporaryData + lodData;
 
         KIS_SAFE_ASSERT_RECOVER_NOOP(!temporaryData || isProjection);
@@ -76,6 +80,7 @@ inline void addDevice(KisPaintDeviceSP dev,
         }
 
         lodSize += lodData;
+        historySize += historyData;
     }
 }
 
@@ -83,23 +88,32 @@ qint64 calculateNodeMemoryHiBoundStep(KisNodeSP node,
                                       QSet<KisPaintDevice*> &devices,
                                       qint64 &layersSize,
                                       qint64 &projectionsSize,
-                                      qint64 &lodSize)
+                                      qint64 &lodSize,
+                                      qint64 &historySize,
+                                      QVector<QPair<QString, qint64>> &layersHistorySize)
 {
     qint64 memBound = 0;
+    qint64 nodeHistorySize = 0;
 
     const bool originalIsProjection =
             node->inherits("KisGroupLayer") ||
             node->inherits("KisAdjustmentLayer");
 
 
-    addDevice(node->paintDevice(), false, devices, memBound, layersSize, projectionsSize, lodSize);
-    addDevice(node->original(), originalIsProjection, devices, memBound, layersSize, projectionsSize, lodSize);
-    addDevice(node->projection(), true, devices, memBound, layersSize, projectionsSize, lodSize);
+    addDevice(node->paintDevice(), false, devices, memBound, layersSize, projectionsSize, lodSize, nodeHistorySize);
+    addDevice(node->original(), originalIsProjection, devices, memBound, layersSize, projectionsSize, lodSize, nodeHistorySize);
+    addDevice(node->projection(), true, devices, memBound, layersSize, projectionsSize, lodSize, nodeHistorySize);
+
+    if (nodeHistorySize > 0) {
+        historySize += nodeHistorySize;
+        layersHistorySize.append(qMakePair(node->name(), nodeHistorySize));
+    }
 
     node = node->firstChild();
     while (node) {
         memBound += calculateNodeMemoryHiBoundStep(node, devices,
-                                                   layersSize, projectionsSize, lodSize);
+                                                   layersSize, projectionsSize, lodSize,
+                                                   historySize, layersHistorySize);
         node = node->nextSibling();
     }
 
@@ -109,18 +123,32 @@ qint64 calculateNodeMemoryHiBoundStep(KisNodeSP node,
 qint64 calculateNodeMemoryHiBound(KisNodeSP node,
                                   qint64 &layersSize,
                                   qint64 &projectionsSize,
-                                  qint64 &lodSize)
+                                  qint64 &lodSize,
+                                  qint64 &historySize,
+                                  QVector<QPair<QString, qint64>> &layersHistorySize)
 {
     layersSize = 0;
     projectionsSize = 0;
     lodSize = 0;
+    historySize = 0;
+    layersHistorySize.clear();
 
     QSet<KisPaintDevice*> devices;
-    return calculateNodeMemoryHiBoundStep(node,
-                                          devices,
-                                          layersSize,
-                                          projectionsSize,
-                                          lodSize);
+    const qint64 memBound =
+        calculateNodeMemoryHiBoundStep(node,
+                                       devices,
+                                       layersSize,
+                                       projectionsSize,
+                                       lodSize,
+                                       historySize,
+                                       layersHistorySize);
+
+    std::sort(layersHistorySize.begin(), layersHistorySize.end(),
+              [] (const QPair<QString, qint64> &lhs, const QPair<QString, qint64> &rhs) {
+                  return lhs.second > rhs.second;
+              });
+
+    return memBound;
 }
 
 
@@ -136,7 +164,9 @@ KisMemoryStatisticsServer::fetchMemoryStatistics(KisImageSP image) const
             calculateNodeMemoryHiBound(image->root(),
                                        stats.layersSize,
                                        stats.projectionsSize,
-                                       stats.lodSize);
+                                       stats.lodSize,
+                                       stats.historySize,
+                                       stats.layersHistorySize);
     }
     stats.totalMemorySize = tileStats.totalMemorySize;
     stats.realMemorySize = tileStats.realMemorySize;
@@ -144,6 +174,7 @@ KisMemoryStatisticsServer::fetchMemoryStatistics(KisImageSP image) const
     stats.poolSize = tileStats.poolSize;
 
     stats.swapSize = tileStats.swapSize;
+    stats.swapDeduplicatedSize = tileStats.swapDeduplicatedSize;
 
     KisImageConfig cfg(true);
 
@@ -10,6 +10,9 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QScopedPointer>
+#include <QVector>
+#include <QPair>
+#include <QString>
 
 #include "kritaimage_export.h"
 #include "kis_types.h"
@@ -26,6 +29,7 @@ public:
               layersSize(0),
               projectionsSize(0),
               lodSize(0),
+              historySize(0),
 
               totalMemorySize(0),
               realMemorySize(0),
@@ -33,6 +37,7 @@ public:
               poolSize(0),
 
               swapSize(0),
+              swapDeduplicatedSize(0),
 
               totalMemoryLimit(0),
               tilesHardLimit(0),
@@ -46,12 +51,16 @@ public:
         qint64 projectionsSize;
         qint64 lodSize;
 
+        qint64 historySize; ///< estimated size of the undo history of all the layers
+        QVector<QPair<QString, qint64>> layersHistorySize; ///< per-layer undo history size, largest first
+
         qint64 totalMemorySize;
         qint64 realMemorySize;
         qint64 historicalMemorySize;
         qint64 poolSize;
 
         qint64 swapSize;
+        qint64 swapDeduplicatedSize; ///< swap space saved by sharing equal tiles
 
         qint64 totalMemoryLimit;
         qint64 tilesHardLimit;
@@ -42,9 +42,98 @@ void KisMergeWalker::startTripImpl(KisProjectionLeafSP startLeaf, KisMergeWalker
 
 void KisMergeWalker::startTrip(KisProjectionLeafSP startLeaf)
 {
+    if (m_tripToReplay) {
+        replayTrip(*m_tripToReplay);
+        return;
+    }
+
     startTripImpl(startLeaf, m_flags);
 }
 
+QVector<KisBaseRectsWalkerSP> KisMergeWalker::collectRectsBatch(KisNodeSP node,
+                                                                const QVector<QRect> &rects,
+                                                                const QRect &cropRect,
+                                                                Flags flags)
+{
+    QVector<KisBaseRectsWalkerSP> walkers;
+    walkers.reserve(rects.size());
+
+    const int graphSequenceNumber = node->graphSequenceNumber();
+    Trip trip;
+
+    for (int i = 0; i < rects.size(); i++) {
+        KisMergeWalkerSP walker = new KisMergeWalker(cropRect, flags);
+
+        if (i == 0) {
+            walker->m_tripRecorder = &trip;
+            walker->collectRects(node, rects[i]);
+            walker->m_tripRecorder = nullptr;
+        } else {
+            walker->m_tripToReplay = &trip;
+            walker->collectRects(node, rects[i]);
+            walker->m_tripToReplay = nullptr;
+        }
+
+        walkers.append(walker);
+    }
+
+    /**
+     * The graph might have been changed while we were replaying
+     * the trip, then just walk through the graph honestly
+     */
+    if (node->graphSequenceNumber() != graphSequenceNumber) {
+        for (int i = 1; i < walkers.size(); i++) {
+            walkers[i]->collectRects(node, rects[i]);
+        }
+    }
+
+    return walkers;
+}
+
+void KisMergeWalker::replayTrip(const Trip &trip)
+{
+    Q_FOREACH (const TripStep &step, trip) {
+        switch (step.type) {
+        case TripStep::ChangeRect:
+            registerChangeRect(step.leaf, step.position);
+            break;
+        case TripStep::NeedRect:
+            registerNeedRect(step.leaf, step.position);
+            break;
+        case TripStep::MasksChangeRect:
+            adjustMasksChangeRect(step.leaf);
+            break;
+        }
+    }
+}
+
+void KisMergeWalker::registerChangeRect(KisProjectionLeafSP leaf, NodePosition position)
+{
+    if (m_tripRecorder) {
+        m_tripRecorder->append({TripStep::ChangeRect, leaf, position});
+    }
+
+    KisBaseRectsWalker::registerChangeRect(leaf, position);
+}
+
+void KisMergeWalker::registerNeedRect(KisProjectionLeafSP leaf, NodePosition position)
+{
+    if (m_tripRecorder) {
+        m_tripRecorder->append({TripStep::NeedRect, leaf, position});
+    }
+
+    KisBaseRectsWalker::registerNeedRect(leaf, position);
+}
+
+void KisMergeWalker::adjustMasksChangeRect(KisProjectionLeafSP firstMask)
+{
+    if (m_tripRecorder) {
+        m_tripRecorder->append({TripStep::MasksChangeRect, firstMask, N_NORMAL});
+    }
+
+    KisBaseRectsWalker::adjustMasksChangeRect(firstMask);
+}
+
 void KisMergeWalker::startTripWithMask(KisProjectionLeafSP filthyMask, KisMergeWalker::Flags flags)
 {
     /**
@@ -7,6 +7,8 @@
 #ifndef __KIS_MERGE_WALKER_H
 #define __KIS_MERGE_WALKER_H
 
+#include <QVector>
+
 #include "kis_types.h"
 #include "kis_base_rects_walker.h"
 
@@ -35,6 +37,21 @@ public:
 
     UpdateType type() const override;
 
+    /**
+     * Creates a walker for each of \p rects, the result is the same
+     * as if every walker was created separately with collectRects().
+     *
+     * The path of the merge walker through the graph doesn't depend
+     * on the requested rect, so the graph is traversed only once, for
+     * the first rect. The visits recorded during this trip are just
+     * replayed for the rest of the rects. It saves a lot of time when
+     * a big update is split into patches.
+     */
+    static QVector<KisBaseRectsWalkerSP> collectRectsBatch(KisNodeSP node,
+                                                           const QVector<QRect> &rects,
+                                                           const QRect &cropRect,
+                                                           Flags flags = DEFAULT);
+
 protected:
     KisMergeWalker() : m_flags(DEFAULT) {}
     KisMergeWalker(Flags flags) : m_flags(flags) {}
@@ -52,6 +69,27 @@ protected:
 
     void startTripWithMask(KisProjectionLeafSP filthyMask, KisMergeWalker::Flags flags);
 
+    void registerChangeRect(KisProjectionLeafSP leaf, NodePosition position) override;
+    void registerNeedRect(KisProjectionLeafSP leaf, NodePosition position) override;
+    void adjustMasksChangeRect(KisProjectionLeafSP firstMask) override;
+
+private:
+    struct TripStep {
+        enum Type {
+            ChangeRect,
+            NeedRect,
+            MasksChangeRect
+        };
+
+        Type type;
+        KisProjectionLeafSP leaf;
+        NodePosition position;
+    };
+
+    typedef QVector<TripStep> Trip;
+
+    void replayTrip(const Trip &trip);
+
 private:
     void startTripImpl(KisProjectionLeafSP startLeaf, Flags flags);
 
@@ -73,6 +111,14 @@ private:
 
 private:
     const Flags m_flags;
+
+    /**
+     * When set, all the visits of the nodes are recorded into
+     * m_tripRecorder, or taken from m_tripToReplay instead of
+     * traversing the graph. Used by collectRectsBatch() only.
+     */
+    Trip *m_tripRecorder {nullptr};
+    const Trip *m_tripToReplay {nullptr};
 };
 
 
@@ -13,8 +13,10 @@
 #include <QImage>
 #include <QList>
 #include <QHash>
+#include <QMap>
 #include <QIODevice>
 #include <qmath.h>
+#include <algorithm>
 #include <KisRegion.h>
 
 #include <klocalizedstring.h>
@@ -159,6 +161,7 @@ public:
     {
 
         m_lodData.reset();
+        dropLodPyramid();
         m_externalFrameData.reset();
 
         if (!m_frames.isEmpty()) {
@@ -398,6 +401,24 @@ public:
         return data->dataManager()->write(store);
     }
 
+    int shareTilesBetweenFrames()
+    {
+        KisTiledDataManager::TileContentIndex index;
+        int numSharedTiles = 0;
+
+        // process the frames in a stable order, so that the earlier
+        // frames keep their own tiles and the later ones share them
+        QList<int> frameIds = m_frames.keys();
+        std::sort(frameIds.begin(), frameIds.end());
+
+        Q_FOREACH (int frameId, frameIds) {
+            DataSP data = m_frames[frameId];
+            numSharedTiles += data->dataManager()->shareTilesWithEqualContent(index);
+        }
+
+        return numSharedTiles;
+    }
+
     void setFrameDefaultPixel(const KoColor &defPixel, int frameId)
     {
         DataSP data = m_frames[frameId];
@@ -442,25 +463,43 @@ private:
 
 public:
 
-    void estimateMemoryStats(qint64 &imageData, qint64 &temporaryData, qint64 &lodData) const {
+    void estimateMemoryStats(qint64 &imageData, qint64 &temporaryData, qint64 &lodData, qint64 &historyData) const {
         imageData = 0;
         temporaryData = 0;
         lodData = 0;
+        historyData = 0;
 
         if (m_data) {
             imageData += estimateDataSize(m_data.data());
+            historyData += m_data->dataManager()->historyMemorySize();
         }
 
         if (m_lodData) {
             lodData += estimateDataSize(m_lodData.data());
         }
 
+        {
+            QMutexLocker l(&m_dataSwitchLock);
+
+            for (auto it = m_lodPyramid.constBegin(); it != m_lodPyramid.constEnd(); ++it) {
+                /**
+                 * The level of the current LoD plane shares all its
+                 * tiles with m_lodData, so it doesn't consume any
+                 * additional memory
+                 */
+                if (m_lodData && it.key() == m_lodData->levelOfDetail()) continue;
+
+                lodData += estimateDataSize(it->data.data());
+            }
+        }
+
         if (m_externalFrameData) {
             temporaryData += estimateDataSize(m_externalFrameData.data());
         }
 
         Q_FOREACH (DataSP value, m_frames.values()) {
             imageData += estimateDataSize(value.data());
+            historyData += value->dataManager()->historyMemorySize();
         }
     }
 
@@ -588,6 +627,12 @@ private:
 
     void transferFromData(Data *data, KisPaintDeviceSP targetDevice);
 
+    void dropLodPyramid()
+    {
+        QMutexLocker l(&m_dataSwitchLock);
+        m_lodPyramid.clear();
+    }
+
     struct Q_DECL_HIDDEN StrategyPolicy;
     typedef KisSequentialIteratorBase<ReadOnlyIteratorPolicy<StrategyPolicy>, StrategyPolicy> InternalSequentialConstIterator;
     typedef KisSequentialIteratorBase<WritableIteratorPolicy<StrategyPolicy>, StrategyPolicy> InternalSequentialIterator;
@@ -596,8 +641,20 @@ private:
     friend class KisPaintDeviceFramesInterface;
 
 private:
+    /**
+     * A copy of the LoD plane uploaded for some level of detail,
+     * together with the version of the lod0 data it has been
+     * generated from
+     */
+    struct LodPyramidLevel {
+        QSharedPointer<Data> data;
+        KisWeakSharedPtr<KisDataManager> sourceDataManager;
+        int sourceSequenceNumber = -1;
+    };
+
     DataSP m_data;
     mutable QScopedPointer<Data> m_lodData;
+    QMap<int, LodPyramidLevel> m_lodPyramid;
     mutable QScopedPointer<Data> m_externalFrameData;
     mutable QMutex m_dataSwitchLock;
 
@@ -681,6 +738,21 @@ struct KisPaintDevice::Private::StrategyPolicy {
 struct KisPaintDevice::Private::LodDataStructImpl : public KisPaintDevice::LodDataStruct {
     LodDataStructImpl(Data *_lodData) : lodData(_lodData) {}
     QScopedPointer<Data> lodData;
+
+    KisWeakSharedPtr<KisDataManager> sourceDataManager;
+    int sourceSequenceNumber = -1;
+
+    /**
+     * The area of the source device that has been downsampled
+     * into lodData
+     */
+    QRect updatedRect;
+
+    /**
+     * The struct has been restored from the pyramid and
+     * doesn't need any updates
+     */
+    bool isUpToDate = false;
 };
 
 KisRegion KisPaintDevice::Private::regionForLodSyncing() const
@@ -694,13 +766,53 @@ KisPaintDevice::LodDataStruct* KisPaintDevice::Private::createLodDataStruct(int
     KIS_SAFE_ASSERT_RECOVER_NOOP(newLod > 0);
 
     Data *srcData = currentNonLodData();
-
-    Data *lodData = new Data(q, srcData, false);
-    LodDataStruct *lodStruct = new LodDataStructImpl(lodData);
+    const KisDataManagerSP srcDataManager = srcData->dataManager();
+    const int srcSequenceNumber = srcData->cache()->sequenceNumber();
 
     int expectedX = KisLodTransform::coordToLodCoord(srcData->x(), newLod);
     int expectedY = KisLodTransform::coordToLodCoord(srcData->y(), newLod);
 
+    {
+        QMutexLocker l(&m_dataSwitchLock);
+
+        /**
+         * The levels generated from a different version of the source
+         * data will never be reused, so release their memory right away
+         */
+        for (auto it = m_lodPyramid.begin(); it != m_lodPyramid.end();) {
+            if (!it->sourceDataManager.isValid() ||
+                it->sourceDataManager != srcDataManager.data() ||
+                it->sourceSequenceNumber != srcSequenceNumber) {
+
+                it = m_lodPyramid.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        auto it = m_lodPyramid.constFind(newLod);
+        if (it != m_lodPyramid.constEnd() &&
+            it->data->colorSpace() == srcData->colorSpace() &&
+            it->data->x() == expectedX &&
+            it->data->y() == expectedY) {
+
+            LodDataStructImpl *lodStruct =
+                new LodDataStructImpl(new Data(q, it->data.data(), true));
+
+            lodStruct->sourceDataManager = srcDataManager;
+            lodStruct->sourceSequenceNumber = srcSequenceNumber;
+            lodStruct->isUpToDate = true;
+            lodStruct->lodData->cache()->invalidate();
+
+            return lodStruct;
+        }
+    }
+
+    Data *lodData = new Data(q, srcData, false);
+    LodDataStructImpl *lodStruct = new LodDataStructImpl(lodData);
+    lodStruct->sourceDataManager = srcDataManager;
+    lodStruct->sourceSequenceNumber = srcSequenceNumber;
+
     /**
      * We compare color spaces as pure pointers, because they must be
      * exactly the same, since they come from the common source.
@@ -814,9 +926,17 @@ void KisPaintDevice::Private::updateLodDataStruct(LodDataStruct *_dst, const QRe
     LodDataStructImpl *dst = dynamic_cast<LodDataStructImpl*>(_dst);
     KIS_SAFE_ASSERT_RECOVER_RETURN(dst);
 
+    if (dst->isUpToDate) return;
+
     Data *lodData = dst->lodData.data();
     Data *srcData = currentNonLodData();
 
+    {
+        // the patches may be updated concurrently
+        QMutexLocker l(&m_dataSwitchLock);
+        dst->updatedRect |= originalRect;
+    }
+
     const int lod = lodData->levelOfDetail();
 
     updateLodDataManager(srcData->dataManager().data(), lodData->dataManager().data(),
@@ -848,6 +968,25 @@ void KisPaintDevice::Private::uploadLodDataStruct(LodDataStruct *_dst)
 
     m_lodData->prepareClone(dst->lodData.data());
     m_lodData->dataManager()->bitBltRough(dst->lodData->dataManager(), dst->lodData->dataManager()->extent());
+
+    /**
+     * Keep a (copy-on-write) copy of the uploaded plane, so that switching
+     * back to this level of detail would not need to regenerate it, unless
+     * the source data changes. The plane is kept only if it covers the
+     * whole source device.
+     */
+    Data *srcData = currentNonLodData();
+    const QRect srcExtent = srcData->dataManager()->extent().translated(srcData->x(), srcData->y());
+
+    if (dst->isUpToDate || dst->updatedRect.contains(srcExtent) || srcExtent.isEmpty()) {
+        LodPyramidLevel level;
+        level.data = toQShared(new Data(q, dst->lodData.data(), true));
+        level.sourceDataManager = dst->sourceDataManager;
+        level.sourceSequenceNumber = dst->sourceSequenceNumber;
+
+        QMutexLocker l(&m_dataSwitchLock);
+        m_lodPyramid.insert(dst->lodData->levelOfDetail(), level);
+    }
 }
 
 void KisPaintDevice::Private::transferFromData(Data *data, KisPaintDeviceSP targetDevice)
@@ -1190,9 +1329,9 @@ int KisPaintDevice::sequenceNumber() const
     return m_d->cache()->sequenceNumber();
 }
 
-void KisPaintDevice::estimateMemoryStats(qint64 &imageData, qint64 &temporaryData, qint64 &lodData) const
+void KisPaintDevice::estimateMemoryStats(qint64 &imageData, qint64 &temporaryData, qint64 &lodData, qint64 &historyData) const
 {
-    m_d->estimateMemoryStats(imageData, temporaryData, lodData);
+    m_d->estimateMemoryStats(imageData, temporaryData, lodData, historyData);
 }
 
 void KisPaintDevice::setParentNode(KisNodeWSP parent)
@@ -1438,7 +1577,6 @@ QRect calculateExactBoundsImpl(const KisPaintDevice *device, const QRect &startR
 
 QRect KisPaintDevice::calculateExactBounds(bool nonDefaultOnly) const
 {
-    QRect startRect = extent();
     QRect endRect;
 
     quint8 defaultOpacity = defaultPixel().opacityU8();
@@ -1451,22 +1589,37 @@ QRect KisPaintDevice::calculateExactBounds(bool nonDefaultOnly) const
 
             endRect = defaultBounds()->bounds();
             nonDefaultOnly = true;
-
-        } else {
-            startRect = region().boundingRect();
         }
     }
 
+    /**
+     * The data manager caches the bounds of every tile, so the cache
+     * key should identify the pixels we consider as empty. The key
+     * starts with the mode of the check, then goes either the default
+     * pixel or the color space the opacity is taken from.
+     */
+    QByteArray cacheKey;
+    QRect rc;
+
     if (nonDefaultOnly) {
         const KoColor defaultPixel = this->defaultPixel();
         Impl::CheckNonDefault compareOp(pixelSize(), defaultPixel.data());
-        endRect = Impl::calculateExactBoundsImpl(this, startRect, endRect, compareOp);
+
+        cacheKey.append('D');
+        cacheKey.append(reinterpret_cast<const char*>(defaultPixel.data()), pixelSize());
+
+        rc = m_d->dataManager()->calculateExactBounds(cacheKey, compareOp);
     } else {
-        Impl::CheckFullyTransparent compareOp(m_d->colorSpace());
-        endRect = Impl::calculateExactBoundsImpl(this, startRect, endRect, compareOp);
+        const KoColorSpace *cs = m_d->colorSpace();
+        Impl::CheckFullyTransparent compareOp(cs);
+
+        cacheKey.append('T');
+        cacheKey.append(reinterpret_cast<const char*>(&cs), sizeof(cs));
+
+        rc = m_d->dataManager()->calculateExactBounds(cacheKey, compareOp);
     }
 
-    return endRect;
+    return rc.translated(x(), y()) | endRect;
 }
 
 KisRegion KisPaintDevice::regionExact() const
@@ -2289,6 +2442,11 @@ bool KisPaintDeviceFramesInterface::writeFrame(KisPaintDeviceWriter &store, int
     return q->m_d->writeFrame(store, frameId);
 }
 
+int KisPaintDeviceFramesInterface::shareTilesBetweenFrames()
+{
+    return q->m_d->shareTilesBetweenFrames();
+}
+
 bool KisPaintDeviceFramesInterface::readFrame(QIODevice *stream, int frameId)
 {
     KIS_ASSERT_RECOVER(frameId >= 0) {
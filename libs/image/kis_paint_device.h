@@ -825,7 +825,11 @@ public:
     int sequenceNumber() const;
 
 
-    void estimateMemoryStats(qint64 &imageData, qint64 &temporaryData, qint64 &lodData) const;
+    /**
+     * Estimates the memory used by the device. \p historyData is the
+     * size of the undo/redo history stored in the device's tiles.
+     */
+    void estimateMemoryStats(qint64 &imageData, qint64 &temporaryData, qint64 &lodData, qint64 &historyData) const;
 
 public:
 
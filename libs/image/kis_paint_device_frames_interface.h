@@ -98,6 +98,19 @@ public:
      */
     bool readFrame(QIODevice *stream, int frameId);
 
+    /**
+     * Makes the tiles with equal content in different frames share
+     * the same tile data (copy-on-write). Frames created by copying
+     * another frame share their tiles anyway, but frames that were
+     * loaded or imported independently have a separate copy of every
+     * tile, even if the background never changes.
+     *
+     * The device must not be modified while the call is in progress.
+     *
+     * @return the number of tiles that started sharing their data
+     */
+    int shareTilesBetweenFrames();
+
 
     /**
      * Returns frameId of the currently active frame.
@@ -437,6 +437,13 @@ const KoCompositeOp *KisPainter::Private::compositeOp(const KoColorSpace *srcCS)
     return cachedCompositeOp;
 }
 
+inline bool KisPainter::Private::transparentSourceIsNoop() const
+{
+    return compositeOpId != COMPOSITE_COPY &&
+        compositeOpId != COMPOSITE_DESTINATION_IN  &&
+        compositeOpId != COMPOSITE_DESTINATION_ATOP;
+}
+
 inline bool KisPainter::Private::tryReduceSourceRect(const KisPaintDevice *srcDev,
                                                      QRect *srcRect,
                                                      qint32 *srcX,
@@ -454,9 +461,7 @@ inline bool KisPainter::Private::tryReduceSourceRect(const KisPaintDevice *srcDe
      * directly copied (former case) or cloned from another area of
      * the image.
      */
-    if (compositeOpId != COMPOSITE_COPY &&
-        compositeOpId != COMPOSITE_DESTINATION_IN  &&
-        compositeOpId != COMPOSITE_DESTINATION_ATOP &&
+    if (transparentSourceIsNoop() &&
         !srcDev->defaultBounds()->wrapAroundMode()) {
 
         /**
@@ -703,6 +708,17 @@ void KisPainter::bitBltImpl(qint32 dstX, qint32 dstY,
 
     const KoCompositeOp *compositeOp = d->compositeOp(srcDev->colorSpace());
 
+    /**
+     * The areas of the source device that have never been written to
+     * contain only the default pixel. When it is transparent, blending
+     * them is a no-op, so they are skipped in bulk. It also keeps the
+     * destination sparse, since its tiles are not even touched.
+     */
+    const bool skipDefaultSrcAreas =
+        !useOldSrcData &&
+        d->transparentSourceIsNoop() &&
+        srcDev->colorSpace()->opacityU8(srcDev->defaultPixel().data()) == OPACITY_TRANSPARENT_U8;
+
     // Read below
     KisRandomConstAccessorSP srcIt = srcDev->createRandomConstAccessorNG();
     KisRandomAccessorSP dstIt = d->device->createRandomAccessorNG();
@@ -737,9 +753,17 @@ void KisPainter::bitBltImpl(qint32 dstX, qint32 dstY,
                 columns = qMin(columns, numContiguousSelColumns);
                 columns = qMin(columns, columnsRemaining);
 
-                qint32 srcRowStride = srcIt->rowStride(srcX_, srcY_);
                 srcIt->moveTo(srcX_, srcY_);
 
+                if (skipDefaultSrcAreas && srcIt->isDefaultPixelArea()) {
+                    srcX_ += columns;
+                    dstX_ += columns;
+                    columnsRemaining -= columns;
+                    continue;
+                }
+
+                qint32 srcRowStride = srcIt->rowStride(srcX_, srcY_);
+
                 qint32 dstRowStride = dstIt->rowStride(dstX_, dstY_);
                 dstIt->moveTo(dstX_, dstY_);
 
@@ -788,9 +812,17 @@ void KisPainter::bitBltImpl(qint32 dstX, qint32 dstY,
                 qint32 columns = qMin(numContiguousDstColumns, numContiguousSrcColumns);
                 columns = qMin(columns, columnsRemaining);
 
-                qint32 srcRowStride = srcIt->rowStride(srcX_, srcY_);
                 srcIt->moveTo(srcX_, srcY_);
 
+                if (skipDefaultSrcAreas && srcIt->isDefaultPixelArea()) {
+                    srcX_ += columns;
+                    dstX_ += columns;
+                    columnsRemaining -= columns;
+                    continue;
+                }
+
+                qint32 srcRowStride = srcIt->rowStride(srcX_, srcY_);
+
                 qint32 dstRowStride = dstIt->rowStride(dstX_, dstY_);
                 dstIt->moveTo(dstX_, dstY_);
 
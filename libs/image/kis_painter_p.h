@@ -69,6 +69,12 @@ struct Q_DECL_HIDDEN KisPainter::Private {
 
     const KoCompositeOp*        compositeOp(const KoColorSpace *srcCS);
 
+    /**
+     * Returns true if the current composite op leaves the destination
+     * pixels untouched where the source pixels are fully transparent
+     */
+    bool transparentSourceIsNoop() const;
+
     bool tryReduceSourceRect(const KisPaintDevice *srcDev,
                              QRect *srcRect,
                              qint32 *srcX,
@@ -26,6 +26,7 @@
 #include "kis_image.h"
 #include "kis_fill_painter.h"
 #include "kis_outline_generator.h"
+#include "kis_tiled_outline_generator.h"
 #include <kis_iterator_ng.h>
 #include "kis_lod_transform.h"
 #include "kundo2command.h"
@@ -38,6 +39,12 @@ struct Q_DECL_HIDDEN KisPixelSelection::Private {
     bool outlineCacheValid;
     QMutex outlineCacheMutex;
 
+    /**
+     * Traced edges of the selection, used for incremental
+     * regeneration of the outline cache
+     */
+    KisTiledOutlineGenerator outlineTiles {KoColorSpaceRegistry::instance()->alpha8(), MIN_SELECTED};
+
     bool thumbnailImageValid;
     QImage thumbnailImage;
     QTransform thumbnailImageTransform;
@@ -49,6 +56,24 @@ struct Q_DECL_HIDDEN KisPixelSelection::Private {
         thumbnailImage = QImage();
         thumbnailImageTransform = QTransform();
     }
+
+    void addOutlineDirtyRect(const QRect &rc) {
+        QMutexLocker locker(&outlineCacheMutex);
+        outlineTiles.addDirtyRect(rc);
+    }
+
+    void resetOutlineTiles() {
+        QMutexLocker locker(&outlineCacheMutex);
+        outlineTiles.invalidate();
+    }
+
+    void updateOutlineTiles(const QRect &rc, bool defaultPixelChanged) {
+        if (defaultPixelChanged) {
+            resetOutlineTiles();
+        } else {
+            addOutlineDirtyRect(rc);
+        }
+    }
 };
 
 KisPixelSelection::KisPixelSelection(KisDefaultBoundsBaseSP defaultBounds, KisSelectionWSP parentSelection)
@@ -111,6 +136,7 @@ bool KisPixelSelection::read(QIODevice *stream)
 {
     bool retval = KisPaintDevice::read(stream);
     m_d->outlineCacheValid = false;
+    m_d->resetOutlineTiles();
     m_d->invalidateThumbnailImage();
     return retval;
 }
@@ -123,6 +149,7 @@ void KisPixelSelection::select(const QRect & rc, quint8 selectedness)
     KisFillPainter painter(KisPaintDeviceSP(this));
     const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
     painter.fillRect(r, KoColor(Qt::white, cs), selectedness);
+    m_d->addOutlineDirtyRect(r);
 
     if (m_d->outlineCacheValid) {
         QPainterPath path;
@@ -177,6 +204,7 @@ void KisPixelSelection::copyAlphaFrom(KisPaintDeviceSP src, const QRect &process
 
     m_d->outlineCacheValid = false;
     m_d->outlineCache = QPainterPath();
+    m_d->addOutlineDirtyRect(processRect);
     m_d->invalidateThumbnailImage();
 }
 
@@ -200,6 +228,7 @@ void KisPixelSelection::addSelection(KisPixelSelectionSP selection)
     }
 
     const quint8 defPixel = qMax(*defaultPixel().data(), *selection->defaultPixel().data());
+    m_d->updateOutlineTiles(r, defPixel != *defaultPixel().data());
     setDefaultPixel(KoColor(&defPixel, colorSpace()));
 
     m_d->outlineCacheValid &= selection->outlineCacheValid();
@@ -234,6 +263,7 @@ void KisPixelSelection::subtractSelection(KisPixelSelectionSP selection)
     const quint8 defPixel = *selection->defaultPixel().data() > *defaultPixel().data()
                             ? MIN_SELECTED
                             : *defaultPixel().data() - *selection->defaultPixel().data();
+    m_d->updateOutlineTiles(r, defPixel != *defaultPixel().data());
     setDefaultPixel(KoColor(&defPixel, colorSpace()));
 
     m_d->outlineCacheValid &= selection->outlineCacheValid();
@@ -264,6 +294,7 @@ void KisPixelSelection::intersectSelection(KisPixelSelectionSP selection)
     }
 
     const quint8 defPixel = qMin(*defaultPixel().data(), *selection->defaultPixel().data());
+    m_d->updateOutlineTiles(r, defPixel != *defaultPixel().data());
     setDefaultPixel(KoColor(&defPixel, colorSpace()));
 
     crop(r);
@@ -296,6 +327,7 @@ void KisPixelSelection::symmetricdifferenceSelection(KisPixelSelectionSP selecti
     }
 
     const quint8 defPixel = abs(*defaultPixel().data() - *selection->defaultPixel().data());
+    m_d->updateOutlineTiles(r, defPixel != *defaultPixel().data());
     setDefaultPixel(KoColor(&defPixel, colorSpace()));
     
     m_d->outlineCacheValid &= selection->outlineCacheValid();
@@ -317,6 +349,8 @@ void KisPixelSelection::clear(const QRect & r)
         KisPaintDevice::clear(r);
     }
 
+    m_d->addOutlineDirtyRect(r);
+
     if (m_d->outlineCacheValid) {
         QPainterPath path;
         path.addRect(r);
@@ -334,6 +368,7 @@ void KisPixelSelection::clear()
 
     m_d->outlineCacheValid = true;
     m_d->outlineCache = QPainterPath();
+    m_d->resetOutlineTiles();
 
     // Empty the thumbnail image. It is a valid state.
     m_d->invalidateThumbnailImage();
@@ -354,6 +389,7 @@ void KisPixelSelection::invert()
     }
     quint8 defPixel = MAX_SELECTED - *defaultPixel().data();
     setDefaultPixel(KoColor(&defPixel, colorSpace()));
+    m_d->resetOutlineTiles();
 
     if (m_d->outlineCacheValid) {
         QPainterPath path;
@@ -384,6 +420,7 @@ void KisPixelSelection::moveTo(const QPoint &pt)
     }
 
     m_d->lod0CachesOffset = lod0Point;
+    m_d->resetOutlineTiles();
 
     KisPaintDevice::moveTo(pt);
 }
@@ -406,7 +443,7 @@ QRect KisPixelSelection::selectedExactRect() const
     return exactBounds();
 }
 
-QVector<QPolygon> KisPixelSelection::outline() const
+QRect KisPixelSelection::outlineRect() const
 {
     QRect selectionExtent = selectedExactRect();
 
@@ -420,6 +457,13 @@ QVector<QPolygon> KisPixelSelection::outline() const
         selectionExtent &= defaultBounds()->bounds();
     }
 
+    return selectionExtent;
+}
+
+QVector<QPolygon> KisPixelSelection::outline() const
+{
+    const QRect selectionExtent = outlineRect();
+
     qint32 xOffset = selectionExtent.x();
     qint32 yOffset = selectionExtent.y();
     qint32 width = selectionExtent.width();
@@ -461,6 +505,9 @@ void KisPixelSelection::setOutlineCache(const QPainterPath &cache)
     m_d->outlineCache = cache;
     m_d->outlineCacheValid = true;
     m_d->thumbnailImageValid = false;
+
+    // we don't know which pixels have changed
+    m_d->outlineTiles.invalidate();
 }
 
 bool KisPixelSelection::outlineCacheValid() const
@@ -474,6 +521,15 @@ void KisPixelSelection::invalidateOutlineCache()
     QMutexLocker locker(&m_d->outlineCacheMutex);
     m_d->outlineCacheValid = false;
     m_d->thumbnailImageValid = false;
+    m_d->outlineTiles.invalidate();
+}
+
+void KisPixelSelection::invalidateOutlineCache(const QRect &changedRect)
+{
+    QMutexLocker locker(&m_d->outlineCacheMutex);
+    m_d->outlineCacheValid = false;
+    m_d->thumbnailImageValid = false;
+    m_d->outlineTiles.addDirtyRect(changedRect);
 }
 
 void KisPixelSelection::recalculateOutlineCache()
@@ -482,18 +538,14 @@ void KisPixelSelection::recalculateOutlineCache()
 
     m_d->outlineCache = QPainterPath();
 
-    Q_FOREACH (const QPolygon &polygon, outline()) {
-        m_d->outlineCache.addPolygon(polygon);
+    /**
+     * The tiled generator retraces only the areas that have changed
+     * since the previous call, the rest of the edges are reused
+     */
+    const QVector<QPolygon> polygons = m_d->outlineTiles.outline(this, outlineRect());
 
-        /**
-         * The outline generation algorithm has a small bug, which
-         * results in the starting point be repeated twice in the
-         * beginning of the path, instead of being put to the
-         * end. Here we just explicitly close the path to workaround
-         * it.
-         *
-         * \see KisSelectionTest::testOutlineGeneration()
-         */
+    Q_FOREACH (const QPolygon &polygon, polygons) {
+        m_d->outlineCache.addPolygon(polygon);
         m_d->outlineCache.closeSubpath();
     }
 
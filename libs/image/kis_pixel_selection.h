@@ -118,6 +118,13 @@ public:
     void setOutlineCache(const QPainterPath &cache);
     void invalidateOutlineCache();
 
+    /**
+     * Invalidates the outline cache, when it is known that only the
+     * pixels inside \p changedRect have been changed. Then only this
+     * area will be retraced by the next recalculateOutlineCache().
+     */
+    void invalidateOutlineCache(const QRect &changedRect);
+
     bool thumbnailImageValid() const;
     QImage thumbnailImage() const;
     QTransform thumbnailImageTransform() const;
@@ -151,6 +158,11 @@ private:
      */
     void symmetricdifferenceSelection(KisPixelSelectionSP selection);
 
+    /**
+     * The area of the selection the outline is generated for
+     */
+    QRect outlineRect() const;
+
 private:
     // We don't want these methods to be used on selections:
     using KisPaintDevice::extent;
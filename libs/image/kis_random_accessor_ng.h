@@ -19,6 +19,20 @@ public:
     virtual qint32 numContiguousColumns(qint32 x) const = 0;
     virtual qint32 numContiguousRows(qint32 y) const = 0;
     virtual qint32 rowStride(qint32 x, qint32 y) const = 0;
+    /**
+     * @return true if the current pixel belongs to an area of the device
+     * that has never been written to. In such a case, all the
+     * numContiguousColumns() x numContiguousRows() pixels starting from
+     * the current position are guaranteed to be equal to the default pixel
+     * of the device.
+     *
+     * NOTE: only the current data of the device is checked, the pixels
+     *       returned by oldRawData() may still differ from the default
+     *       pixel.
+     *
+     * Writable accessors always return false.
+     */
+    virtual bool isDefaultPixelArea() const = 0;
 };
 
 class KRITAIMAGE_EXPORT KisRandomAccessorNG : public KisRandomConstAccessorNG, public KisBaseAccessor
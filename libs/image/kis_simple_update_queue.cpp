@@ -109,8 +109,13 @@ bool KisSimpleUpdateQueue::processOneJob(KisUpdaterContext &updaterContext)
         if ((currentLevelOfDetail < 0 || currentLevelOfDetail == item->levelOfDetail()) &&
             updaterContext.isJobAllowed(item)) {
 
-            updaterContext.addMergeJob(item);
             iter.remove();
+
+            QVector<KisBaseRectsWalkerSP> batch;
+            batch << item;
+            collectMergeJobsBatch(batch, iter, updaterContext);
+
+            updaterContext.addMergeJobs(batch);
             jobAdded = true;
             break;
         }
@@ -146,6 +151,40 @@ bool KisSimpleUpdateQueue::processOneJob(KisUpdaterContext &updaterContext)
     return jobAdded;
 }
 
+void KisSimpleUpdateQueue::collectMergeJobsBatch(QVector<KisBaseRectsWalkerSP> &batch,
+                                                 KisMutableWalkersListIterator &iter,
+                                                 KisUpdaterContext &updaterContext)
+{
+    /**
+     * When the queue is long (e.g. a big update has just been split
+     * into patches), the patches of the same update are passed to
+     * a single thread at once. It saves the cost of waking up the
+     * threads for every tiny patch. The batch is small enough to
+     * keep all the threads of the context busy.
+     */
+    const int maxBatchSize =
+        qBound(1, (m_updatesList.size() + 1) / qMax(1, updaterContext.threadsLimit()), m_maxBatchSize);
+
+    const KisBaseRectsWalkerSP baseWalker = batch.first();
+
+    while (batch.size() < maxBatchSize && iter.hasNext()) {
+        KisBaseRectsWalkerSP item = iter.next();
+
+        if (item->type() != baseWalker->type() ||
+            item->startNode() != baseWalker->startNode() ||
+            item->cropRect() != baseWalker->cropRect() ||
+            item->levelOfDetail() != baseWalker->levelOfDetail() ||
+            !item->checksumValid() ||
+            !updaterContext.isJobAllowed(item)) {
+
+            continue;
+        }
+
+        batch << item;
+        iter.remove();
+    }
+}
+
 void KisSimpleUpdateQueue::addUpdateJob(KisNodeSP node, const QVector<QRect> &rects, const QRect& cropRect, int levelOfDetail)
 {
     addJob(node, rects, cropRect, levelOfDetail, KisBaseRectsWalker::UPDATE);
@@ -186,39 +225,47 @@ void KisSimpleUpdateQueue::addJob(KisNodeSP node, const QVector<QRect> &rects,
                                   int levelOfDetail,
                                   KisBaseRectsWalker::UpdateType type)
 {
-    QList<KisBaseRectsWalkerSP> walkers;
+    QVector<QRect> pendingRects;
 
     Q_FOREACH (const QRect &rc, rects) {
         if (rc.isEmpty()) continue;
 
-        KisBaseRectsWalkerSP walker;
-
         if(trySplitJob(node, rc, cropRect, levelOfDetail, type)) continue;
         if(tryMergeJob(node, rc, cropRect, levelOfDetail, type)) continue;
 
-        if (type == KisBaseRectsWalker::UPDATE) {
-            walker = new KisMergeWalker(cropRect, KisMergeWalker::DEFAULT);
-        }
-        else if (type == KisBaseRectsWalker::FULL_REFRESH)  {
-            walker = new KisFullRefreshWalker(cropRect);
-        }
-        else if (type == KisBaseRectsWalker::UPDATE_NO_FILTHY) {
-            walker = new KisMergeWalker(cropRect, KisMergeWalker::NO_FILTHY);
-        }
-        else if (type == KisBaseRectsWalker::FULL_REFRESH_NO_FILTHY)  {
-            walker = new KisFullRefreshWalker(cropRect, KisFullRefreshWalker::NoFilthyMode);
-        }
-        /* else if(type == KisBaseRectsWalker::UNSUPPORTED) fatalKrita; */
-
-        walker->collectRects(node, rc);
-        walkers.append(walker);
+        pendingRects.append(rc);
     }
 
-    if (!walkers.isEmpty()) {
-        m_lock.lock();
-        m_updatesList.append(walkers);
-        m_lock.unlock();
+    if (pendingRects.isEmpty()) return;
+
+    QVector<KisBaseRectsWalkerSP> walkers;
+
+    if (type == KisBaseRectsWalker::UPDATE) {
+        walkers = KisMergeWalker::collectRectsBatch(node, pendingRects, cropRect, KisMergeWalker::DEFAULT);
+    }
+    else if (type == KisBaseRectsWalker::UPDATE_NO_FILTHY) {
+        walkers = KisMergeWalker::collectRectsBatch(node, pendingRects, cropRect, KisMergeWalker::NO_FILTHY);
     }
+    else {
+        Q_FOREACH (const QRect &rc, pendingRects) {
+            KisBaseRectsWalkerSP walker;
+
+            if (type == KisBaseRectsWalker::FULL_REFRESH)  {
+                walker = new KisFullRefreshWalker(cropRect);
+            }
+            else if (type == KisBaseRectsWalker::FULL_REFRESH_NO_FILTHY)  {
+                walker = new KisFullRefreshWalker(cropRect, KisFullRefreshWalker::NoFilthyMode);
+            }
+            /* else if(type == KisBaseRectsWalker::UNSUPPORTED) fatalKrita; */
+
+            walker->collectRects(node, rc);
+            walkers.append(walker);
+        }
+    }
+
+    m_lock.lock();
+    m_updatesList.append(walkers.toList());
+    m_lock.unlock();
 }
 
 void KisSimpleUpdateQueue::addSpontaneousJob(KisSpontaneousJob *spontaneousJob)
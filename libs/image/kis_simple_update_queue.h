@@ -50,6 +50,9 @@ protected:
     void addJob(KisNodeSP node, const QVector<QRect> &rects, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type);
 
     bool processOneJob(KisUpdaterContext &updaterContext);
+    void collectMergeJobsBatch(QVector<KisBaseRectsWalkerSP> &batch,
+                               KisMutableWalkersListIterator &iter,
+                               KisUpdaterContext &updaterContext);
 
     bool trySplitJob(KisNodeSP node, const QRect& rc, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type);
     bool tryMergeJob(KisNodeSP node, const QRect& rc, const QRect& cropRect, int levelOfDetail, KisBaseRectsWalker::UpdateType type);
@@ -94,6 +97,12 @@ protected:
     qreal m_maxMergeCollectAlpha;
 
     int m_overrideLevelOfDetail;
+
+    /**
+     * The maximum number of patches passed to
+     * a single thread in one merge job
+     */
+    int m_maxBatchSize {8};
 };
 
 class KRITAIMAGE_EXPORT KisTestableSimpleUpdateQueue : public KisSimpleUpdateQueue
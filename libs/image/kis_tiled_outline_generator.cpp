@@ -0,0 +1,371 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_tiled_outline_generator.h"
+
+#include <QHash>
+
+#include <KoColorSpace.h>
+
+#include "kis_algebra_2d.h"
+#include "kis_debug.h"
+#include "kis_paint_device.h"
+
+static inline uint qHash(const QPoint &value, uint seed = 0) {
+    return ::qHash((quint64(quint32(value.y())) << 32) | quint32(value.x()), seed);
+}
+
+namespace {
+
+/**
+ * The size of the cells the outline is traced in. It is equal
+ * to the size of the tiles of the paint device, so the cells
+ * are read without any copying overhead.
+ */
+const int cellSize = 64;
+
+/**
+ * A directed boundary edge, the selected pixels are always on
+ * its right side (in the screen coordinates)
+ */
+struct Segment {
+    QPoint start;
+    QPoint end;
+};
+
+struct Cell {
+    QRect rect; ///< the area of the cell the segments were traced in
+    QVector<Segment> segments;
+};
+
+struct CellJob {
+    QPoint index;
+    Cell cell;
+};
+
+inline QRect cellRect(const QPoint &index)
+{
+    return QRect(index.x() * cellSize, index.y() * cellSize, cellSize, cellSize);
+}
+
+inline QRect cellIndexRange(const QRect &rc)
+{
+    const int x0 = KisAlgebra2D::divideFloor(rc.left(), cellSize);
+    const int y0 = KisAlgebra2D::divideFloor(rc.top(), cellSize);
+    const int x1 = KisAlgebra2D::divideFloor(rc.right(), cellSize);
+    const int y1 = KisAlgebra2D::divideFloor(rc.bottom(), cellSize);
+
+    return QRect(QPoint(x0, y0), QPoint(x1, y1));
+}
+
+inline quint64 pointKey(const QPoint &pt)
+{
+    return (quint64(quint32(pt.y())) << 32) | quint32(pt.x());
+}
+
+inline bool isCollinear(const QPoint &a, const QPoint &b, const QPoint &c)
+{
+    return (a.x() == b.x() && b.x() == c.x()) ||
+           (a.y() == b.y() && b.y() == c.y());
+}
+
+inline void appendPoint(QPolygon &polygon, const QPoint &pt)
+{
+    const int size = polygon.size();
+
+    if (size >= 2 && isCollinear(polygon[size - 2], polygon[size - 1], pt)) {
+        polygon[size - 1] = pt;
+    } else {
+        polygon << pt;
+    }
+}
+
+}
+
+struct KisTiledOutlineGenerator::Private
+{
+    const KoColorSpace *cs;
+    quint8 defaultOpacity;
+
+    QHash<QPoint, Cell> cells;
+    QVector<QRect> dirtyRects;
+    bool allDirty = true;
+
+    void traceCell(const KisPaintDevice *device, const QRect &clipRect, CellJob &job) const;
+    QVector<QPolygon> stitch() const;
+};
+
+KisTiledOutlineGenerator::KisTiledOutlineGenerator(const KoColorSpace *cs, quint8 defaultOpacity)
+    : m_d(new Private)
+{
+    m_d->cs = cs;
+    m_d->defaultOpacity = defaultOpacity;
+}
+
+KisTiledOutlineGenerator::~KisTiledOutlineGenerator()
+{
+}
+
+void KisTiledOutlineGenerator::invalidate()
+{
+    m_d->allDirty = true;
+    m_d->dirtyRects.clear();
+    m_d->cells.clear();
+}
+
+void KisTiledOutlineGenerator::addDirtyRect(const QRect &rc)
+{
+    if (m_d->allDirty || rc.isEmpty()) return;
+
+    /**
+     * The edges of the neighbouring pixels depend on
+     * the changed pixels as well
+     */
+    m_d->dirtyRects.append(rc.adjusted(-1, -1, 1, 1));
+}
+
+QVector<QPolygon> KisTiledOutlineGenerator::outline(const KisPaintDevice *device, const QRect &rect)
+{
+    if (rect.isEmpty()) {
+        invalidate();
+        return QVector<QPolygon>();
+    }
+
+    if (m_d->allDirty) {
+        m_d->cells.clear();
+    } else {
+        Q_FOREACH (const QRect &rc, m_d->dirtyRects) {
+            const QRect range = cellIndexRange(rc);
+
+            for (int row = range.top(); row <= range.bottom(); row++) {
+                for (int col = range.left(); col <= range.right(); col++) {
+                    m_d->cells.remove(QPoint(col, row));
+                }
+            }
+        }
+
+        /**
+         * The pixels outside the processed rect are considered as
+         * unselected, so the cells crossed by the old or the new
+         * border of the rect should be retraced as well
+         */
+        for (auto it = m_d->cells.begin(); it != m_d->cells.end();) {
+            if (it->rect != (cellRect(it.key()) & rect)) {
+                it = m_d->cells.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    m_d->allDirty = false;
+    m_d->dirtyRects.clear();
+
+    QVector<CellJob> jobs;
+
+    const QRect range = cellIndexRange(rect);
+    for (int row = range.top(); row <= range.bottom(); row++) {
+        for (int col = range.left(); col <= range.right(); col++) {
+            const QPoint index(col, row);
+
+            if (!m_d->cells.contains(index)) {
+                CellJob job;
+                job.index = index;
+                jobs.append(job);
+            }
+        }
+    }
+
+    /**
+     * The outline is usually regenerated from KisUpdateOutlineJob, that
+     * is, from a worker thread of the updates scheduler, and with the
+     * outline cache lock held. So the cells are traced serially here,
+     * the generator shouldn't block the worker on a separate thread pool.
+     * Since only the dirty cells are retraced, it is cheap enough.
+     */
+    for (auto it = jobs.begin(); it != jobs.end(); ++it) {
+        m_d->traceCell(device, rect, *it);
+        m_d->cells.insert(it->index, it->cell);
+    }
+
+    return m_d->stitch();
+}
+
+void KisTiledOutlineGenerator::Private::traceCell(const KisPaintDevice *device, const QRect &clipRect, CellJob &job) const
+{
+    const QRect rc = cellRect(job.index) & clipRect;
+    job.cell.rect = rc;
+
+    /**
+     * The mask of the cell has a one-pixel border around it, the
+     * pixels outside the clip rect are left unselected.
+     */
+    const int maskWidth = rc.width() + 2;
+    const int maskHeight = rc.height() + 2;
+    QVector<quint8> mask(maskWidth * maskHeight, 0);
+
+    const QRect readRect = rc.adjusted(-1, -1, 1, 1) & clipRect;
+    const int pixelSize = cs->pixelSize();
+
+    QVector<quint8> pixels(readRect.width() * readRect.height() * pixelSize);
+    device->readBytes(pixels.data(), readRect);
+
+    QVector<quint8> opacity(readRect.width());
+
+    for (int y = 0; y < readRect.height(); y++) {
+        cs->copyOpacityU8(pixels.data() + y * readRect.width() * pixelSize,
+                          opacity.data(), readRect.width());
+
+        quint8 *maskPtr = mask.data() +
+            (readRect.y() + y - rc.y() + 1) * maskWidth +
+            (readRect.x() - rc.x() + 1);
+
+        for (int x = 0; x < readRect.width(); x++) {
+            maskPtr[x] = opacity[x] != defaultOpacity;
+        }
+    }
+
+    const quint8 *maskData = mask.constData();
+
+    auto isSelected = [maskData, maskWidth] (int x, int y) {
+        return bool(maskData[(y + 1) * maskWidth + x + 1]);
+    };
+
+    QVector<Segment> &segments = job.cell.segments;
+
+    // horizontal edges
+
+    for (int y = 0; y < rc.height(); y++) {
+        int topStart = -1;
+        int bottomStart = -1;
+
+        for (int x = 0; x <= rc.width(); x++) {
+            const bool selected = x < rc.width() && isSelected(x, y);
+            const bool top = selected && !isSelected(x, y - 1);
+            const bool bottom = selected && !isSelected(x, y + 1);
+
+            if (top && topStart < 0) {
+                topStart = x;
+            } else if (!top && topStart >= 0) {
+                segments.append(Segment{QPoint(rc.x() + topStart, rc.y() + y),
+                                         QPoint(rc.x() + x, rc.y() + y)});
+                topStart = -1;
+            }
+
+            if (bottom && bottomStart < 0) {
+                bottomStart = x;
+            } else if (!bottom && bottomStart >= 0) {
+                segments.append(Segment{QPoint(rc.x() + x, rc.y() + y + 1),
+                                         QPoint(rc.x() + bottomStart, rc.y() + y + 1)});
+                bottomStart = -1;
+            }
+        }
+    }
+
+    // vertical edges
+
+    for (int x = 0; x < rc.width(); x++) {
+        int leftStart = -1;
+        int rightStart = -1;
+
+        for (int y = 0; y <= rc.height(); y++) {
+            const bool selected = y < rc.height() && isSelected(x, y);
+            const bool left = selected && !isSelected(x - 1, y);
+            const bool right = selected && !isSelected(x + 1, y);
+
+            if (left && leftStart < 0) {
+                leftStart = y;
+            } else if (!left && leftStart >= 0) {
+                segments.append(Segment{QPoint(rc.x() + x, rc.y() + y),
+                                         QPoint(rc.x() + x, rc.y() + leftStart)});
+                leftStart = -1;
+            }
+
+            if (right && rightStart < 0) {
+                rightStart = y;
+            } else if (!right && rightStart >= 0) {
+                segments.append(Segment{QPoint(rc.x() + x + 1, rc.y() + rightStart),
+                                         QPoint(rc.x() + x + 1, rc.y() + y)});
+                rightStart = -1;
+            }
+        }
+    }
+}
+
+QVector<QPolygon> KisTiledOutlineGenerator::Private::stitch() const
+{
+    QVector<Segment> segments;
+
+    for (auto it = cells.constBegin(); it != cells.constEnd(); ++it) {
+        segments += it->segments;
+    }
+
+    /**
+     * Every vertex of the outline has at most two outgoing edges
+     * (when two selected areas touch each other diagonally), so
+     * the edges starting at the same point are chained in a list.
+     */
+    QHash<quint64, int> firstByStart;
+    firstByStart.reserve(segments.size());
+    QVector<int> nextByStart(segments.size(), -1);
+
+    for (int i = 0; i < segments.size(); i++) {
+        auto it = firstByStart.find(pointKey(segments[i].start));
+        if (it != firstByStart.end()) {
+            nextByStart[i] = *it;
+            *it = i;
+        } else {
+            firstByStart.insert(pointKey(segments[i].start), i);
+        }
+    }
+
+    QVector<bool> used(segments.size(), false);
+    QVector<QPolygon> polygons;
+
+    for (int i = 0; i < segments.size(); i++) {
+        if (used[i]) continue;
+
+        const QPoint startPoint = segments[i].start;
+
+        QPolygon polygon;
+        polygon << startPoint;
+
+        int current = i;
+
+        forever {
+            used[current] = true;
+
+            const QPoint pt = segments[current].end;
+            appendPoint(polygon, pt);
+
+            if (pt == startPoint) break;
+
+            int next = firstByStart.value(pointKey(pt), -1);
+            while (next >= 0 && used[next]) {
+                next = nextByStart[next];
+            }
+
+            KIS_SAFE_ASSERT_RECOVER(next >= 0) { break; }
+            current = next;
+        }
+
+        /**
+         * The starting point may lie in the middle of a straight
+         * line, then it can be dropped as well
+         */
+        if (polygon.size() > 3 &&
+            polygon.first() == polygon.last() &&
+            isCollinear(polygon[polygon.size() - 2], polygon.first(), polygon[1])) {
+
+            polygon.removeFirst();
+            polygon.last() = polygon.first();
+        }
+
+        polygons.append(polygon);
+    }
+
+    return polygons;
+}
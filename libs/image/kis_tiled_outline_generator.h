@@ -0,0 +1,74 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_TILED_OUTLINE_GENERATOR_H
+#define KIS_TILED_OUTLINE_GENERATOR_H
+
+#include <QPolygon>
+#include <QRect>
+#include <QScopedPointer>
+#include <QVector>
+
+#include "kritaimage_export.h"
+
+class KisPaintDevice;
+class KoColorSpace;
+
+
+/**
+ * Generates the outline of a paint device (e.g. the marching ants of a
+ * selection) tile by tile.
+ *
+ * The boundary edges of every 64x64 tile are traced independently and
+ * cached. Then the edges of all the tiles are
+ * stitched into closed polygons, and the vertices lying in the middle
+ * of straight lines (e.g. on tile borders) are dropped.
+ *
+ * When only a part of the device changes, the changed area can be
+ * passed to addDirtyRect(), and the next call to outline() will
+ * retrace only the tiles touched by it.
+ *
+ * Unlike KisOutlineGenerator, the generated polygons do not have any
+ * specific order or orientation, so they are supposed to be filled
+ * with Qt::OddEvenFill rule (which is the default for QPainterPath).
+ */
+class KRITAIMAGE_EXPORT KisTiledOutlineGenerator
+{
+public:
+    /**
+     * @param cs colorspace of the device passed to the generator
+     * @param defaultOpacity opacity of pixels that shouldn't be included in the outline
+     */
+    KisTiledOutlineGenerator(const KoColorSpace *cs, quint8 defaultOpacity);
+    ~KisTiledOutlineGenerator();
+
+    /**
+     * Drops all the cached tiles, the next call to outline()
+     * will retrace the whole device
+     */
+    void invalidate();
+
+    /**
+     * Notifies the generator that the pixels inside \p rc have
+     * been changed since the last call to outline()
+     */
+    void addDirtyRect(const QRect &rc);
+
+    /**
+     * Generates the outline of the pixels of \p device lying inside
+     * \p rect. The pixels outside \p rect are considered as having
+     * the default opacity.
+     */
+    QVector<QPolygon> outline(const KisPaintDevice *device, const QRect &rect);
+
+private:
+    Q_DISABLE_COPY(KisTiledOutlineGenerator)
+
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KIS_TILED_OUTLINE_GENERATOR_H
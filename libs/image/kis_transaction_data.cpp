@@ -62,6 +62,7 @@ public:
     void possiblySwitchCurrentTime();
     KisDataManagerSP dataManager();
     void moveDevice(const QPoint newOffset);
+    void invalidateSelectionOutline(KisPixelSelection *pixelSelection);
 };
 
 KisTransactionData::KisTransactionData(const KUndo2MagicString& name, KisPaintDeviceSP device, bool resetSelectionOutlineCache, KisTransactionWrapperFactory *interstrokeDataFactory, KUndo2Command* parent, bool suppressUpdates)
@@ -129,6 +130,22 @@ void KisTransactionData::Private::moveDevice(const QPoint newOffset)
     }
 }
 
+void KisTransactionData::Private::invalidateSelectionOutline(KisPixelSelection *pixelSelection)
+{
+    /**
+     * When only the pixels of the current frame have changed, the
+     * selection can regenerate its outline incrementally. Before the
+     * transaction is finished the memento is still empty.
+     */
+    if (transactionFrameId >= 0 || defaultPixelChanged ||
+        (transactionFinished && newOffset != oldOffset)) {
+
+        pixelSelection->invalidateOutlineCache();
+    } else {
+        pixelSelection->invalidateOutlineCache(memento->extent().translated(device->x(), device->y()));
+    }
+}
+
 void KisTransactionData::endTransaction()
 {
     if(!m_d->transactionFinished) {
@@ -202,7 +219,7 @@ void KisTransactionData::possiblyResetOutlineCache()
         (pixelSelection =
          dynamic_cast<KisPixelSelection*>(m_d->device.data()))) {
 
-        pixelSelection->invalidateOutlineCache();
+        m_d->invalidateSelectionOutline(pixelSelection.data());
     }
 }
 
@@ -347,7 +364,7 @@ void KisTransactionData::restoreSelectionOutlineCache(bool undo)
         if (m_d->savedOutlineCacheValid) {
             pixelSelection->setOutlineCache(m_d->savedOutlineCache);
         } else {
-            pixelSelection->invalidateOutlineCache();
+            m_d->invalidateSelectionOutline(pixelSelection.data());
         }
 
         m_d->savedOutlineCacheValid = savedOutlineCacheValid;
@@ -11,12 +11,14 @@
 
 #include <QRunnable>
 #include <QReadWriteLock>
+#include <QVector>
 
 #include "kis_stroke_job.h"
 #include "kis_spontaneous_job.h"
 #include "kis_base_rects_walker.h"
 #include "kis_async_merger.h"
 #include "kis_updater_context.h"
+#include "KisParallelDeviceProcessingUtils.h"
 #include <KoAlwaysInline.h>
 
 //#define DEBUG_JOBS_SEQUENCE
@@ -46,6 +48,10 @@ public:
     }
 
     void run() override {
+        // the jobs are already executed concurrently, so they
+        // shouldn't fan out into more threads
+        KritaUtils::WorkerThreadScope workerScope;
+
         runImpl();
 
         // notify that the job is exiting and wake everybody
@@ -123,28 +129,42 @@ public:
 
     inline void runMergeJob() {
         KIS_SAFE_ASSERT_RECOVER_RETURN(m_atomicType == Type::MERGE);
-        KIS_SAFE_ASSERT_RECOVER_RETURN(m_walker);
-        // dbgKrita << "Executing merge job" << m_walker->changeRect()
-        //          << "on thread" << QThread::currentThreadId();
+        KIS_SAFE_ASSERT_RECOVER_RETURN(!m_walkers.isEmpty());
+
+        for (const KisBaseRectsWalkerSP &walker : std::as_const(m_walkers)) {
+            // dbgKrita << "Executing merge job" << walker->changeRect()
+            //          << "on thread" << QThread::currentThreadId();
 
 #ifdef DEBUG_JOBS_SEQUENCE
-        qDebug() << "running: merge " << m_walker->startNode() << m_walker->changeRect();
+            qDebug() << "running: merge " << walker->startNode() << walker->changeRect();
 
 #endif
 
-        m_merger.startMerge(*m_walker);
+            m_merger.startMerge(*walker);
 
-        QRect changeRect = m_walker->changeRect();
-        m_updaterContext->continueUpdate(changeRect);
+            QRect changeRect = walker->changeRect();
+            m_updaterContext->continueUpdate(changeRect);
+        }
     }
 
     // return true if the thread should actually be started
     inline bool setWalker(KisBaseRectsWalkerSP walker) {
+        return setWalkers({walker});
+    }
+
+    // return true if the thread should actually be started
+    inline bool setWalkers(const QVector<KisBaseRectsWalkerSP> &walkers) {
         KIS_ASSERT(m_atomicType <= Type::WAITING);
 
-        m_accessRect = walker->accessRect();
-        m_changeRect = walker->changeRect();
-        m_walker = walker;
+        m_accessRect = QRect();
+        m_changeRect = QRect();
+
+        for (const KisBaseRectsWalkerSP &walker : walkers) {
+            m_accessRect |= walker->accessRect();
+            m_changeRect |= walker->changeRect();
+        }
+
+        m_walkers = walkers;
 
         m_exclusive = false;
         m_runnableJob = 0;
@@ -161,7 +181,7 @@ public:
         m_strokeJobSequentiality = strokeJob->sequentiality();
 
         m_exclusive = strokeJob->isExclusive();
-        m_walker = 0;
+        m_walkers.clear();
         m_accessRect = m_changeRect = QRect();
 
         const Type oldState = m_atomicType.exchange(Type::STROKE);
@@ -175,7 +195,7 @@ public:
         m_runnableJob = spontaneousJob;
 
         m_exclusive = spontaneousJob->isExclusive();
-        m_walker = 0;
+        m_walkers.clear();
         m_accessRect = m_changeRect = QRect();
 
         const Type oldState = m_atomicType.exchange(Type::SPONTANEOUS);
@@ -183,7 +203,7 @@ public:
     }
 
     inline void setDone() {
-        m_walker = 0;
+        m_walkers.clear();
         delete m_runnableJob;
         m_runnableJob = 0;
         m_atomicType = Type::WAITING;
@@ -221,7 +241,11 @@ private:
     friend class KisUpdaterContext;
 
     inline KisBaseRectsWalkerSP walker() const {
-        return m_walker;
+        return !m_walkers.isEmpty() ? m_walkers.first() : KisBaseRectsWalkerSP();
+    }
+
+    inline const QVector<KisBaseRectsWalkerSP>& walkers() const {
+        return m_walkers;
     }
 
     inline KisStrokeJob* strokeJob() const {
@@ -248,14 +272,16 @@ private:
     KisRunnableWithDebugName *m_runnableJob {0};
 
     /**
-     * Merge jobs part
+     * Merge jobs part. The walkers of a batch are merged
+     * one after another in the same thread.
      */
-    KisBaseRectsWalkerSP m_walker;
+    QVector<KisBaseRectsWalkerSP> m_walkers;
     KisAsyncMerger m_merger;
 
     /**
-     * These rects cache actual values from the walker
-     * to eliminate concurrent access to a walker structure
+     * These rects cache actual values from the walkers (united
+     * for the whole batch) to eliminate concurrent access to
+     * a walker structure
      */
     QRect m_accessRect;
     QRect m_changeRect;
@@ -162,11 +162,18 @@ void KisUpdaterContext::startThread(int index)
  */
 void KisUpdaterContext::addMergeJob(KisBaseRectsWalkerSP walker)
 {
-    m_lodCounter.addLod(walker->levelOfDetail());
+    addMergeJobs({walker});
+}
+
+void KisUpdaterContext::addMergeJobs(const QVector<KisBaseRectsWalkerSP> &walkers)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(!walkers.isEmpty());
+
+    m_lodCounter.addLod(walkers.first()->levelOfDetail());
     qint32 jobIndex = findSpareThread();
     Q_ASSERT(jobIndex >= 0);
 
-    const bool shouldStartThread = m_jobs[jobIndex]->setWalker(walker);
+    const bool shouldStartThread = m_jobs[jobIndex]->setWalkers(walkers);
 
     // it might happen that we call this function from within
     // the thread itself, right when it finished its work
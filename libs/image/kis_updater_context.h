@@ -78,6 +78,15 @@ public:
      */
     void addMergeJob(KisBaseRectsWalkerSP walker);
 
+    /**
+     * Registers a batch of merge jobs that are executed one after
+     * another in a single thread. All the walkers should have the
+     * same level of detail and should be allowed with isJobAllowed().
+     *
+     * \see addMergeJob()
+     */
+    void addMergeJobs(const QVector<KisBaseRectsWalkerSP> &walkers);
+
     /**
      * Adds a stroke job to the context. The prerequisites are
      * the same as for addMergeJob()
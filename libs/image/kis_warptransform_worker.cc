@@ -245,9 +245,32 @@ void KisWarpTransformWorker::run(KisPaintDeviceSP srcDev, KisPaintDeviceSP dstDe
     const int pixelPrecision = 8;
 
     FunctionTransformOp functionOp(m_warpMathFunction, m_origPoint, m_transfPoint, m_alpha);
-    GridIterationTools::PaintDevicePolygonOp polygonOp(srcDev, dstDev);
-    GridIterationTools::processGrid(polygonOp, functionOp,
-                                    srcBounds, pixelPrecision);
+
+    /**
+     * Evaluating the warp function is the most expensive part of the
+     * transformation, so we evaluate it only once per grid point (and
+     * concurrently) and then reuse the cached lattice for rasterizing
+     * the tile-aligned stripes of the destination in parallel.
+     */
+    QSize gridSize;
+    QVector<QPointF> originalPoints;
+    QVector<QPointF> transformedPoints;
+    GridIterationTools::calculateGridPoints(srcBounds, pixelPrecision, functionOp,
+                                            &gridSize, &originalPoints, &transformedPoints);
+
+    const QRect dstBounds =
+        KisAlgebra2D::approximateRectFromPoints(transformedPoints).toAlignedRect().adjusted(-1, -1, 1, 1);
+
+    GridIterationTools::processStripesConcurrently(
+        GridIterationTools::splitIntoAlignedStripes(dstBounds, 64),
+        [&] (const QRect &stripe) {
+            GridIterationTools::PaintDevicePolygonOp polygonOp(srcDev, dstDev);
+            polygonOp.setDstClipRect(stripe);
+
+            GridIterationTools::PrecalculatedTransformOp transformOp(transformedPoints);
+            GridIterationTools::processGrid(polygonOp, transformOp,
+                                            srcBounds, pixelPrecision);
+        });
 }
 
 #include "krita_utils.h"
@@ -346,8 +369,29 @@ QImage KisWarpTransformWorker::transformQImage(WarpType warpType,
     dstImage.fill(0);
 
     const int pixelPrecision = 32;
-    GridIterationTools::QImagePolygonOp polygonOp(srcImage, dstImage, srcQImageOffset, dstQImageOffset);
-    GridIterationTools::processGrid(polygonOp, functionOp, srcBounds.toAlignedRect(), pixelPrecision);
+
+    QSize gridSize;
+    QVector<QPointF> originalPoints;
+    QVector<QPointF> transformedPoints;
+    GridIterationTools::calculateGridPoints(srcBounds.toAlignedRect(), pixelPrecision, functionOp,
+                                            &gridSize, &originalPoints, &transformedPoints);
+
+    /**
+     * The constructor of the op detaches the destination image, so it
+     * should be called only once, before the fan-out. The stripes get
+     * the copies of the op sharing the same pre-detached pointer.
+     */
+    const GridIterationTools::QImagePolygonOp basePolygonOp(srcImage, dstImage, srcQImageOffset, dstQImageOffset);
+
+    GridIterationTools::processStripesConcurrently(
+        GridIterationTools::splitIntoAlignedStripes(dstImage.rect(), 16),
+        [&] (const QRect &stripe) {
+            GridIterationTools::QImagePolygonOp polygonOp(basePolygonOp);
+            polygonOp.setDstClipRect(stripe);
+
+            GridIterationTools::PrecalculatedTransformOp transformOp(transformedPoints);
+            GridIterationTools::processGrid(polygonOp, transformOp, srcBounds.toAlignedRect(), pixelPrecision);
+        });
 
     return dstImage;
 }
@@ -92,6 +92,13 @@ public:
                     m_iterationAreaSize.width() - m_currentPos.x());
     }
 
+    qint32 nConseqDefaultPixels() const {
+        qint32 iteratorChunk =
+            m_currentIterator->nConseqDefaultPixels();
+        return qMin(iteratorChunk,
+                    m_iterationAreaSize.width() - m_currentPos.x());
+    }
+
     qint32 x() const {
         return (m_splitRect.originalRect().topLeft() +
                 m_strategy.columnRowToXY(m_currentPos)).x();
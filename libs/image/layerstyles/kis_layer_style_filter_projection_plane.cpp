@@ -17,6 +17,97 @@
 #include "kis_painter.h"
 #include "kis_multiple_projection.h"
 #include "KisLayerStyleKnockoutBlower.h"
+#include "KisRegion.h"
+#include "kis_algebra_2d.h"
+#include "kis_datamanager.h"
+#include "tiles3/kis_tile_data.h"
+
+#include <QtMath>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+static inline uint qHash(const QPoint &value, uint seed = 0) {
+    return ::qHash((quint64(quint32(value.y())) << 32) | quint32(value.x()), seed);
+}
+
+namespace {
+
+/**
+ * The size of the cells the style's output is cached in. It is equal
+ * to the size of the tiles, so that a change of a single tile of the
+ * source invalidates as few cells as possible.
+ */
+static const int cacheCellSize = 64;
+
+inline QPoint cellIndex(const QPoint &pt) {
+    return QPoint(qFloor(qreal(pt.x()) / cacheCellSize),
+                  qFloor(qreal(pt.y()) / cacheCellSize));
+}
+
+inline QRect cellRect(const QPoint &index) {
+    return QRect(index * cacheCellSize, QSize(cacheCellSize, cacheCellSize));
+}
+
+inline void combineKey(quint64 *key, quint64 value) {
+    // FNV-1a-like combination of two 64-bit values
+    *key = (*key ^ value) * 0x100000001b3ULL;
+}
+
+inline quint64 pointKey(const QPoint &pt) {
+    return (quint64(quint32(pt.x())) << 32) | quint32(pt.y());
+}
+
+/**
+ * Calculates the keys of the source content from the revisions of
+ * the tiles of the source device (see KisTileData::revision()). The
+ * pixels themselves are never read. The revisions are fetched lazily,
+ * because the need rects of the neighbouring cells overlap a lot.
+ */
+struct SourceContentHasher
+{
+    SourceContentHasher(KisPaintDeviceSP dev)
+        : m_dataManager(dev->dataManager()),
+          m_offset(dev->x(), dev->y())
+    {
+    }
+
+    quint64 rectKey(const QRect &rc, quint64 seed) {
+        const QRect dataRect = rc.translated(-m_offset);
+
+        const int firstCol = KisAlgebra2D::divideFloor(dataRect.left(), KisTileData::WIDTH);
+        const int firstRow = KisAlgebra2D::divideFloor(dataRect.top(), KisTileData::HEIGHT);
+        const int lastCol = KisAlgebra2D::divideFloor(dataRect.right(), KisTileData::WIDTH);
+        const int lastRow = KisAlgebra2D::divideFloor(dataRect.bottom(), KisTileData::HEIGHT);
+
+        quint64 key = seed;
+        combineKey(&key, pointKey(m_offset));
+
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int col = firstCol; col <= lastCol; col++) {
+                combineKey(&key, tileRevision(QPoint(col, row)));
+            }
+        }
+
+        return key;
+    }
+
+private:
+    quint64 tileRevision(const QPoint &index) {
+        auto it = m_revisions.find(index);
+        if (it == m_revisions.end()) {
+            it = m_revisions.insert(index, m_dataManager->tileRevision(index.x(), index.y()));
+        }
+        return *it;
+    }
+
+private:
+    KisDataManagerSP m_dataManager;
+    QPoint m_offset;
+    QHash<QPoint, quint64> m_revisions;
+};
+
+}
 
 
 struct KisLayerStyleFilterProjectionPlane::Private
@@ -34,7 +125,8 @@ struct KisLayerStyleFilterProjectionPlane::Private
           style(clonedStyle),
           environment(new KisLayerStyleFilterEnvironment(_sourceLayer)),
           knockoutBlower(rhs.knockoutBlower),
-          projection(rhs.projection)
+          projection(rhs.projection),
+          cachedCellKeys(rhs.cachedCellKeys)
     {
         KIS_SAFE_ASSERT_RECOVER_NOOP(_sourceLayer);
     }
@@ -48,8 +140,115 @@ struct KisLayerStyleFilterProjectionPlane::Private
     KisLayerStyleKnockoutBlower knockoutBlower;
 
     KisMultipleProjection projection;
+
+    /**
+     * The style's output is cached in \p projection. For every cell of
+     * the projection we store a key of the content it was generated from:
+     * the revisions of the source tiles in the need-rect of the cell and
+     * the environment of the filter. The revisions are unique, so the keys
+     * of different contents never collide, unless the 64-bit combination
+     * of the revisions itself does. When the cell is requested for
+     * recalculation, but its key has not changed, the cached output is
+     * reused as it is.
+     *
+     * The keys are stored separately for every level of detail.
+     */
+    QMutex cacheLock;
+    QHash<int, QHash<QPoint, quint64>> cachedCellKeys;
+
+    /// statistics for the unittests, guarded by cacheLock
+    int cachedCellHits = 0;
+    int cachedCellMisses = 0;
+
+    quint64 environmentKey() const;
+    QVector<QRect> fetchDirtyCells(const QRect &rect,
+                                   KisPaintDeviceSP src,
+                                   QHash<QPoint, quint64> *newKeys);
 };
 
+quint64 KisLayerStyleFilterProjectionPlane::Private::environmentKey() const
+{
+    /**
+     * The style plane is recreated on every change of the layer style,
+     * so the style itself is constant for this object. Though the output
+     * of some filters (e.g. gradient overlay) depends on the bounds of
+     * the layer and the image.
+     */
+    const QRect layerBounds = environment->layerBounds();
+    const QRect imageBounds = environment->defaultBounds();
+
+    quint64 key = 0xcbf29ce484222325ULL;
+    combineKey(&key, quintptr(style.data()));
+    combineKey(&key, style && style->isEnabled());
+    combineKey(&key, (quint64(quint32(layerBounds.x())) << 32) | quint32(layerBounds.y()));
+    combineKey(&key, (quint64(quint32(layerBounds.width())) << 32) | quint32(layerBounds.height()));
+    combineKey(&key, (quint64(quint32(imageBounds.x())) << 32) | quint32(imageBounds.y()));
+    combineKey(&key, (quint64(quint32(imageBounds.width())) << 32) | quint32(imageBounds.height()));
+
+    return key;
+}
+
+QVector<QRect> KisLayerStyleFilterProjectionPlane::Private::fetchDirtyCells(const QRect &rect,
+                                                                            KisPaintDeviceSP src,
+                                                                            QHash<QPoint, quint64> *newKeys)
+{
+    const int lod = environment->currentLevelOfDetail();
+    const quint64 envKey = environmentKey();
+
+    SourceContentHasher hasher(src);
+
+    const QPoint tl = cellIndex(rect.topLeft());
+    const QPoint br = cellIndex(rect.bottomRight());
+
+    QVector<QPair<QPoint, quint64>> cellKeys;
+
+    for (int y = tl.y(); y <= br.y(); y++) {
+        for (int x = tl.x(); x <= br.x(); x++) {
+            const QPoint index(x, y);
+            const QRect needRect = filter->neededRect(cellRect(index), style, environment.data());
+            cellKeys.append(qMakePair(index, hasher.rectKey(needRect, envKey)));
+        }
+    }
+
+    QVector<QRect> dirtyRects;
+
+    QMutexLocker l(&cacheLock);
+    QHash<QPoint, quint64> &cache = cachedCellKeys[lod];
+
+    for (auto it = cellKeys.begin(); it != cellKeys.end(); ++it) {
+        const QRect fullCell = cellRect(it->first);
+        const QRect requestedRect = fullCell & rect;
+        const bool isFullCell = requestedRect == fullCell;
+
+        auto cachedIt = cache.find(it->first);
+
+        if (isFullCell &&
+            cachedIt != cache.end() &&
+            *cachedIt == it->second) {
+
+            cachedCellHits++;
+            continue;
+        }
+
+        cachedCellMisses++;
+        dirtyRects.append(requestedRect);
+
+        /**
+         * Only the cells that are regenerated fully can be cached,
+         * the partially updated cells are just invalidated
+         */
+        if (isFullCell) {
+            newKeys->insert(it->first, it->second);
+        }
+
+        if (cachedIt != cache.end()) {
+            cache.erase(cachedIt);
+        }
+    }
+
+    return dirtyRects;
+}
+
 KisLayerStyleFilterProjectionPlane::
 KisLayerStyleFilterProjectionPlane(KisLayer *sourceLayer)
     : m_d(new Private(sourceLayer))
@@ -80,13 +279,32 @@ QRect KisLayerStyleFilterProjectionPlane::recalculate(const QRect& rect, KisNode
         return QRect();
     }
 
-    m_d->projection.clear(rect);
-    m_d->filter->processDirectly(m_d->sourceLayer->projection(),
-                                 &m_d->projection,
-                                 &m_d->knockoutBlower,
-                                 rect,
-                                 m_d->style,
-                                 m_d->environment.data());
+    KisPaintDeviceSP src = m_d->sourceLayer->projection();
+
+    QHash<QPoint, quint64> newKeys;
+    const QVector<QRect> dirtyRects = m_d->fetchDirtyCells(rect, src, &newKeys);
+
+    Q_FOREACH (const QRect &dirtyRect, KisRegion(dirtyRects).rects()) {
+        m_d->projection.clear(dirtyRect);
+        m_d->filter->processDirectly(src,
+                                     &m_d->projection,
+                                     &m_d->knockoutBlower,
+                                     dirtyRect,
+                                     m_d->style,
+                                     m_d->environment.data());
+    }
+
+    if (!newKeys.isEmpty()) {
+        const int lod = m_d->environment->currentLevelOfDetail();
+
+        QMutexLocker l(&m_d->cacheLock);
+        QHash<QPoint, quint64> &cache = m_d->cachedCellKeys[lod];
+
+        for (auto it = newKeys.constBegin(); it != newKeys.constEnd(); ++it) {
+            cache.insert(it.key(), it.value());
+        }
+    }
+
     return rect;
 }
 
@@ -105,6 +323,18 @@ bool KisLayerStyleFilterProjectionPlane::isEmpty() const
     return m_d->projection.isEmpty();
 }
 
+int KisLayerStyleFilterProjectionPlane::cachedCellHits() const
+{
+    QMutexLocker l(&m_d->cacheLock);
+    return m_d->cachedCellHits;
+}
+
+int KisLayerStyleFilterProjectionPlane::cachedCellMisses() const
+{
+    QMutexLocker l(&m_d->cacheLock);
+    return m_d->cachedCellMisses;
+}
+
 KisLayerStyleKnockoutBlower *KisLayerStyleFilterProjectionPlane::knockoutBlower() const
 {
     return &m_d->knockoutBlower;
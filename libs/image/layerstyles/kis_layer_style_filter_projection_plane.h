@@ -45,6 +45,14 @@ public:
 
     KisLayerStyleKnockoutBlower *knockoutBlower() const;
 
+    /**
+     * The number of the cells that recalculate() has reused from the
+     * cache and that it has regenerated, since the creation of the
+     * plane. Used for testing only.
+     */
+    int cachedCellHits() const;
+    int cachedCellMisses() const;
+
 protected:
 
     KisLayerStyleFilter* filter() const;
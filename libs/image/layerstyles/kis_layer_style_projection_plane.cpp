@@ -328,6 +328,24 @@ void KisLayerStyleProjectionPlane::apply(KisPainter *painter, const QRect &rect)
     }
 }
 
+int KisLayerStyleProjectionPlane::cachedCellHits() const
+{
+    int result = 0;
+    Q_FOREACH (KisLayerStyleFilterProjectionPlaneSP plane, m_d->allStyles()) {
+        result += plane->cachedCellHits();
+    }
+    return result;
+}
+
+int KisLayerStyleProjectionPlane::cachedCellMisses() const
+{
+    int result = 0;
+    Q_FOREACH (KisLayerStyleFilterProjectionPlaneSP plane, m_d->allStyles()) {
+        result += plane->cachedCellMisses();
+    }
+    return result;
+}
+
 KisPaintDeviceList KisLayerStyleProjectionPlane::getLodCapableDevices() const
 {
     KisPaintDeviceList list;
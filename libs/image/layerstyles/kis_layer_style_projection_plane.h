@@ -47,6 +47,10 @@ private:
 
     QRect stylesNeedRect(const QRect &rect) const;
 
+    /// the cache statistics of all the style planes, used for testing only
+    int cachedCellHits() const;
+    int cachedCellMisses() const;
+
 private:
     struct Private;
     const QScopedPointer<Private> m_d;
@@ -7,6 +7,7 @@
 
 #include "kis_iterators_ng_test.h"
 #include <QApplication>
+#include <QThread>
 
 #include <simpletest.h>
 #include <KoColor.h>
@@ -20,6 +21,9 @@
 #include "kis_paint_device.h"
 #include <kis_iterator_ng.h>
 #include "kis_global.h"
+#include "KisParallelDeviceProcessingUtils.h"
+#include <KisSequentialIteratorProgress.h>
+#include "kis_painter.h"
 #include <testutil.h>
 #include <testimage.h>
 
@@ -422,8 +426,6 @@ void KisIteratorNGTest::sequentialIter()
     allCsApplicator(&KisIteratorNGTest::sequentialIter);
 }
 
-#include <KisSequentialIteratorProgress.h>
-
 void KisIteratorNGTest::sequentialIteratorWithProgress()
 {
     KisPaintDeviceSP dev = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
@@ -482,4 +484,138 @@ void KisIteratorNGTest::randomAccessor()
     allCsApplicator(&KisIteratorNGTest::randomAccessor);
 }
 
+void KisIteratorNGTest::defaultPixelSpans()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    // only tiles (1, 0) and (1, 3) exist
+    dev->fill(QRect(64, 0, 64, 64), KoColor(Qt::red, cs));
+    dev->fill(QRect(64, 192, 64, 64), KoColor(Qt::red, cs));
+
+    {
+        KisHLineConstIteratorSP it = dev->createHLineConstIteratorNG(10, 0, 246);
+        QCOMPARE(it->nConseqDefaultPixels(), 54);
+
+        it->nextPixels(54);
+        QCOMPARE(it->x(), 64);
+        QCOMPARE(it->nConseqDefaultPixels(), 0);
+
+        it->nextPixels(64);
+        QCOMPARE(it->x(), 128);
+        QCOMPARE(it->nConseqDefaultPixels(), 128);
+    }
+
+    {
+        KisVLineConstIteratorSP it = dev->createVLineConstIteratorNG(70, 0, 250);
+        QCOMPARE(it->nConseqDefaultPixels(), 0);
+
+        it->nextPixels(64);
+        QCOMPARE(it->y(), 64);
+        QCOMPARE(it->nConseqDefaultPixels(), 128);
+
+        it->nextPixels(128);
+        QCOMPARE(it->y(), 192);
+        QCOMPARE(it->nConseqDefaultPixels(), 0);
+    }
+
+    {
+        KisRandomConstAccessorSP it = dev->createRandomConstAccessorNG();
+
+        it->moveTo(10, 10);
+        QVERIFY(it->isDefaultPixelArea());
+
+        it->moveTo(70, 10);
+        QVERIFY(!it->isDefaultPixelArea());
+
+        it->moveTo(70, 100);
+        QVERIFY(it->isDefaultPixelArea());
+    }
+
+    {
+        // the empty areas of the source are skipped while blending
+        KisPaintDeviceSP dst = new KisPaintDevice(cs);
+
+        KisPainter gc(dst);
+        gc.bitBlt(QPoint(), dev, QRect(0, 0, 256, 256));
+        gc.end();
+
+        QCOMPARE(dst->exactBounds(), QRect(64, 0, 64, 256));
+
+        KisRandomConstAccessorSP it = dst->createRandomConstAccessorNG();
+        it->moveTo(70, 100);
+        QVERIFY(it->isDefaultPixelArea());
+
+        it->moveTo(70, 200);
+        QVERIFY(!it->isDefaultPixelArea());
+
+        QColor c;
+        dst->pixel(70, 200, &c);
+        QCOMPARE(c, QColor(Qt::red));
+    }
+
+    {
+        KisHLineIteratorSP it = dev->createHLineIteratorNG(0, 0, 64);
+        QCOMPARE(it->nConseqDefaultPixels(), 0);
+    }
+}
+
+void KisIteratorNGTest::parallelSpans()
+{
+    {
+        const QVector<QRect> bands =
+            KritaUtils::splitRectIntoTileAlignedBands(QRect(10, 30, 500, 300), 3);
+
+        QCOMPARE(bands, QVector<QRect>({QRect(10, 30, 500, 98),
+                                        QRect(10, 128, 500, 128),
+                                        QRect(10, 256, 500, 74)}));
+    }
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    const QRect rc(-30, -20, 700, 600);
+    dev->fill(rc, KoColor(Qt::red, cs));
+
+    KritaUtils::processRectInParallel(rc,
+        [dev] (const QRect &band) {
+            KritaUtils::processSpans(dev, band,
+                [] (const quint8 *src, quint8 *dst, int numPixels) {
+                    for (int i = 0; i < numPixels; i++) {
+                        // swap the red and the blue channels
+                        const quint8 blue = src[4 * i];
+                        const quint8 red = src[4 * i + 2];
+                        dst[4 * i] = red;
+                        dst[4 * i + 2] = blue;
+                    }
+                });
+        });
+
+    QCOMPARE(dev->exactBounds(), rc);
+
+    KisSequentialConstIterator it(dev, rc);
+    while (it.nextPixel()) {
+        const quint8 *pixel = it.rawDataConst();
+        QCOMPARE(pixel[0], quint8(255));
+        QCOMPARE(pixel[2], quint8(0));
+    }
+
+    {
+        // the worker threads should never fan out into more threads
+        KritaUtils::WorkerThreadScope workerScope;
+
+        QThread *callingThread = QThread::currentThread();
+        bool processedInCallingThread = true;
+
+        KritaUtils::processRectInParallel(rc,
+            [&] (const QRect &) {
+                processedInCallingThread &= QThread::currentThread() == callingThread;
+            });
+
+        QVERIFY(processedInCallingThread);
+    }
+
+    QVERIFY(!KritaUtils::isWorkerThread());
+}
+
 KISTEST_MAIN(KisIteratorNGTest)
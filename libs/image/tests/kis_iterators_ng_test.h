@@ -37,6 +37,8 @@ private Q_SLOTS:
     void sequentialIteratorWithProgressIncomplete();
     void hLineIter();
     void randomAccessor();
+    void defaultPixelSpans();
+    void parallelSpans();
 };
 
 #endif
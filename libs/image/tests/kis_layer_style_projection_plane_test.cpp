@@ -658,4 +658,80 @@ void KisLayerStyleProjectionPlaneTest::testBlending()
     KIS_DUMP_DEVICE_2(originalBg, rc, "04_knockout", "dd");
 }
 
+void KisLayerStyleProjectionPlaneTest::testCachedRecalculation()
+{
+    KisPSDLayerStyleSP style(new KisPSDLayerStyle());
+    style->dropShadow()->setSize(15);
+    style->dropShadow()->setDistance(15);
+    style->dropShadow()->setOpacity(70);
+    style->dropShadow()->setEffectEnabled(true);
+
+    style->outerGlow()->setSize(15);
+    style->outerGlow()->setSpread(10);
+    style->outerGlow()->setOpacity(70);
+    style->outerGlow()->setEffectEnabled(true);
+
+    const QRect imageRect(0, 0, 300, 300);
+    const QRect rFillRect(10, 10, 100, 100);
+    const QRect rChangedRect(200, 200, 30, 30);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "styles test");
+
+    KisPaintLayerSP layer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+    image->addNode(layer);
+
+    layer->paintDevice()->fill(rFillRect, KoColor(Qt::red, cs));
+
+    KisLayerStyleProjectionPlane plane(layer.data(), style);
+    plane.recalculate(imageRect, layer);
+
+    QCOMPARE(plane.cachedCellHits(), 0);
+    const int initialMisses = plane.cachedCellMisses();
+    QVERIFY(initialMisses > 0);
+
+    /**
+     * The second pass over unchanged data is served from the cache. The
+     * rect is aligned to the cells, because the partially requested cells
+     * are never cached.
+     */
+    const QRect cellAlignedRect(0, 0, 256, 256);
+    plane.recalculate(cellAlignedRect, layer);
+
+    QVERIFY(plane.cachedCellHits() > 0);
+    QCOMPARE(plane.cachedCellMisses(), initialMisses);
+
+    const int hitsBeforeChange = plane.cachedCellHits();
+
+    layer->paintDevice()->fill(rChangedRect, KoColor(Qt::blue, cs));
+    plane.recalculate(plane.changeRect(rChangedRect, KisLayer::N_FILTHY), layer);
+
+    // the changed cells are regenerated
+    QVERIFY(plane.cachedCellMisses() > initialMisses);
+    QCOMPARE(plane.cachedCellHits(), hitsBeforeChange);
+
+    // a rect that covers the cached cells only partially
+    plane.recalculate(QRect(15, 15, 50, 50), layer);
+
+    KisPaintDeviceSP cachedProjection = new KisPaintDevice(cs);
+    {
+        KisPainter painter(cachedProjection);
+        plane.apply(&painter, imageRect);
+    }
+
+    KisLayerStyleProjectionPlane referencePlane(layer.data(), style);
+    referencePlane.recalculate(imageRect, layer);
+
+    KisPaintDeviceSP referenceProjection = new KisPaintDevice(cs);
+    {
+        KisPainter painter(referenceProjection);
+        referencePlane.apply(&painter, imageRect);
+    }
+
+    QPoint pt;
+    if (!TestUtil::comparePaintDevices(pt, cachedProjection, referenceProjection)) {
+        QFAIL(QString("Cached layer style differs from the reference at %1,%2").arg(pt.x()).arg(pt.y()).toLatin1());
+    }
+}
+
 KISTEST_MAIN(KisLayerStyleProjectionPlaneTest)
@@ -36,6 +36,8 @@ private Q_SLOTS:
 
     void testBlending();
 
+    void testCachedRecalculation();
+
 private:
     void test(KisPSDLayerStyleSP style, const QString testName);
 
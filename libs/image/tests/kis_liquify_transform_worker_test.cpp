@@ -148,4 +148,59 @@ void KisLiquifyTransformWorkerTest::testIdentityTransform()
     TestUtil::checkQImage(result, "liquify_transform_test", "liquify_dev", "identity");
 }
 
+void KisLiquifyTransformWorkerTest::testIncrementalQImageUpdate()
+{
+    QImage image(TestUtil::fetchDataFileLazy("test_transform_quality_second.png"));
+    image = image.convertToFormat(QImage::Format_ARGB32);
+
+    const int pixelPrecision = 8;
+    const QPointF srcImageOffset(10, 10);
+    const QTransform imageToThumbTransform;
+
+    KisLiquifyTransformWorker worker(QRect(srcImageOffset.toPoint(), image.size()),
+                                     0,
+                                     pixelPrecision);
+
+    worker.translatePoints(QPointF(100,100),
+                           QPointF(50, 0),
+                           50, false, 0.2);
+
+    QPointF offset;
+    QImage incrementalResult = worker.runOnQImage(image, srcImageOffset, imageToThumbTransform, &offset);
+    worker.resetDirtyState();
+
+    QVERIFY(!worker.hasDirtyPoints());
+
+    // nothing has changed, so the update is a no-op
+    QVERIFY(worker.updateQImageIncrementally(image, srcImageOffset, imageToThumbTransform,
+                                             &incrementalResult, offset));
+
+    worker.rotatePoints(QPointF(200,200),
+                        M_PI / 8,
+                        30, false, 0.2);
+
+    worker.scalePoints(QPointF(300,250),
+                       0.3,
+                       20, true, 0.5);
+
+    QVERIFY(worker.hasDirtyPoints());
+    QVERIFY(!worker.dirtyDstRect().isEmpty());
+
+    QVERIFY(worker.updateQImageIncrementally(image, srcImageOffset, imageToThumbTransform,
+                                             &incrementalResult, offset));
+
+    QPointF fullOffset;
+    QImage fullResult = worker.runOnQImage(image, srcImageOffset, imageToThumbTransform, &fullOffset);
+
+    QCOMPARE(fullOffset, offset);
+    QCOMPARE(incrementalResult, fullResult);
+
+    // moving the whole grid cannot be handled incrementally
+    worker.resetDirtyState();
+    worker.translateDstSpace(QPointF(5, 5));
+
+    QVERIFY(!worker.updateQImageIncrementally(image, srcImageOffset, imageToThumbTransform,
+                                              &incrementalResult, offset));
+}
+
 SIMPLE_TEST_MAIN(KisLiquifyTransformWorkerTest)
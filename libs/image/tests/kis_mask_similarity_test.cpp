@@ -249,4 +249,17 @@ void KisMaskSimilarityTest::testSoftRectMask()
     KisMaskSimilarityTester::runMaskGenTest(generator,RECT_SOFT);
 }
 
+void KisMaskSimilarityTest::testSpikedCircleMask()
+{
+    KisCircleMaskGenerator generator(499.5, 0.5, 0.5, 0.5, 5, true);
+    KisMaskSimilarityTester::runMaskGenTest(generator,DEFAULT);
+}
+
+void KisMaskSimilarityTest::testSpikedSoftRectMask()
+{
+    const KisCubicCurve pointsCurve(QString("0,1;1,0"));
+    KisCurveRectangleMaskGenerator generator(499.5, 0.5, 0.5, 0.5, 3, pointsCurve, true);
+    KisMaskSimilarityTester::runMaskGenTest(generator,RECT_SOFT);
+}
+
 SIMPLE_TEST_MAIN(KisMaskSimilarityTest)
@@ -21,6 +21,9 @@ private Q_SLOTS:
     void testRectMask();
     void testGaussRectMask();
     void testSoftRectMask();
+
+    void testSpikedCircleMask();
+    void testSpikedSoftRectMask();
 };
 
 #endif
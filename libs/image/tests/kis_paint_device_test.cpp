@@ -1537,6 +1537,48 @@ void KisPaintDeviceTest::testLodDevice()
                                   "lod", "lod1-offset-6-14"));
 }
 
+void KisPaintDeviceTest::testLodPyramid()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    TestingLodDefaultBounds *bounds = new TestingLodDefaultBounds();
+    dev->setDefaultBounds(bounds);
+
+    fillGradientDevice(dev, QRect(50,50,30,30));
+
+    bounds->testingSetLevelOfDetail(1);
+    syncLodCache(dev, 1);
+    const QImage lod1 = dev->convertToQImage(0,0,0,100,100);
+
+    bounds->testingSetLevelOfDetail(2);
+    syncLodCache(dev, 2);
+    const QImage lod2 = dev->convertToQImage(0,0,0,100,100);
+
+    // the levels are restored from the pyramid
+    bounds->testingSetLevelOfDetail(1);
+    syncLodCache(dev, 1);
+    QCOMPARE(dev->exactBounds(), QRect(25,25,15,15));
+    QCOMPARE(dev->convertToQImage(0,0,0,100,100), lod1);
+
+    bounds->testingSetLevelOfDetail(2);
+    syncLodCache(dev, 2);
+    QCOMPARE(dev->exactBounds(), QRect(12,12,8,8));
+    QCOMPARE(dev->convertToQImage(0,0,0,100,100), lod2);
+
+    // the change of the source data invalidates the levels
+    bounds->testingSetLevelOfDetail(0);
+    dev->fill(QRect(0,0,20,20), KoColor(Qt::red, cs));
+
+    bounds->testingSetLevelOfDetail(1);
+    syncLodCache(dev, 1);
+    QCOMPARE(dev->exactBounds(), QRect(0,0,40,40));
+
+    const QImage result = dev->convertToQImage(0,0,0,100,100);
+    QCOMPARE(QColor(result.pixel(5,5)), QColor(Qt::red));
+    QCOMPARE(result.copy(25,25,15,15), lod1.copy(25,25,15,15));
+}
+
 void KisPaintDeviceTest::benchmarkLod1Generation()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
@@ -1903,6 +1945,56 @@ void KisPaintDeviceTest::testFramesLeaking()
     }
 }
 
+void KisPaintDeviceTest::testShareTilesBetweenFrames()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    TestUtil::TestingTimedDefaultBounds *bounds = new TestUtil::TestingTimedDefaultBounds();
+    dev->setDefaultBounds(bounds);
+
+    KisRasterKeyframeChannel *channel = dev->createKeyframeChannel(KisKeyframeChannel::Raster);
+    QVERIFY(channel);
+
+    KisPaintDeviceFramesInterface *i = dev->framesInterface();
+    QVERIFY(i);
+
+    // a new keyframe is created empty, so it doesn't share anything
+    channel->addKeyframe(10);
+    QCOMPARE(i->frames().size(), 2);
+
+    const QRect backgroundRect(0, 0, 256, 256); // 16 tiles
+    const QRect spriteRect(64, 64, 64, 64); // a single tile
+
+    // frame 0: background only
+    bounds->testingSetTime(0);
+    dev->fill(backgroundRect, KoColor(Qt::white, cs));
+
+    // frame 10: the same background with a sprite
+    bounds->testingSetTime(10);
+    dev->fill(backgroundRect, KoColor(Qt::white, cs));
+    dev->fill(spriteRect, KoColor(Qt::red, cs));
+
+    // all the tiles of frame 10 except the sprite one have a twin in frame 0
+    QCOMPARE(i->shareTilesBetweenFrames(), 15);
+
+    // the tiles are already shared
+    QCOMPARE(i->shareTilesBetweenFrames(), 0);
+
+    // the content of the frames is not changed
+    QCOMPARE(dev->exactBounds(), backgroundRect);
+    QCOMPARE(dev->pixel(QPoint(10, 10)), KoColor(Qt::white, cs));
+    QCOMPARE(dev->pixel(QPoint(70, 70)), KoColor(Qt::red, cs));
+
+    // writing into a shared tile doesn't affect the other frame
+    dev->fill(QRect(0, 0, 10, 10), KoColor(Qt::blue, cs));
+    QCOMPARE(dev->pixel(QPoint(5, 5)), KoColor(Qt::blue, cs));
+
+    bounds->testingSetTime(0);
+    QCOMPARE(dev->pixel(QPoint(5, 5)), KoColor(Qt::white, cs));
+    QCOMPARE(dev->pixel(QPoint(70, 70)), KoColor(Qt::white, cs));
+}
+
 void KisPaintDeviceTest::testFramesUndoRedo()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
@@ -53,6 +53,7 @@ private Q_SLOTS:
 
     void testLodTransform();
     void testLodDevice();
+    void testLodPyramid();
     void benchmarkLod1Generation();
     void benchmarkLod2Generation();
     void benchmarkLod3Generation();
@@ -62,6 +63,7 @@ private Q_SLOTS:
     void testFramesSignals();
 
     void testFramesLeaking();
+    void testShareTilesBetweenFrames();
     void testFramesUndoRedo();
     void testFramesUndoRedoWithChannel();
     void testCrossDeviceFrameCopyDirect();
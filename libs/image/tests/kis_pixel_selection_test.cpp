@@ -9,6 +9,7 @@
 
 
 #include <kis_debug.h>
+#include <QPainter>
 #include <QRect>
 
 #include <KoColorSpace.h>
@@ -580,5 +581,84 @@ void KisPixelSelectionTest::testOutlineArtifacts()
                    QPoint(0,0)})}));
 }
 
+QImage fillOutline(const QPainterPath &path, const QRect &rc)
+{
+    QImage image(rc.size(), QImage::Format_ARGB32);
+    image.fill(Qt::transparent);
+
+    QPainter gc(&image);
+    gc.translate(-rc.topLeft());
+    gc.fillPath(path, Qt::black);
+
+    return image;
+}
+
+bool compareWithLegacyOutline(KisPixelSelectionSP psel)
+{
+    QPainterPath legacyOutline;
+    Q_FOREACH (const QPolygon &polygon, psel->outline()) {
+        legacyOutline.addPolygon(polygon);
+        legacyOutline.closeSubpath();
+    }
+
+    psel->recalculateOutlineCache();
+    const QPainterPath tiledOutline = psel->outlineCache();
+
+    const QRect rc = psel->defaultBounds()->bounds();
+    return fillOutline(tiledOutline, rc) == fillOutline(legacyOutline, rc);
+}
+
+void KisPixelSelectionTest::testTiledOutline()
+{
+    KisDefaultBoundsBaseSP bounds = new TestUtil::TestingTimedDefaultBounds(QRect(0,0,300,200));
+    KisPixelSelectionSP psel = new KisPixelSelection();
+    psel->setDefaultBounds(bounds);
+
+    // the shapes cross the borders of the tiles
+    psel->select(QRect(10,10,100,80));
+    psel->select(QRect(120,30,60,150));
+    psel->clear(QRect(40,40,40,20));
+    psel->clear(QRect(130,60,40,40));
+    psel->select(QRect(140,70,10,10));
+
+    // the areas touching diagonally
+    psel->select(QRect(200,100,30,30));
+    psel->select(QRect(230,130,30,30));
+
+    // single pixels
+    psel->select(QRect(63,63,1,1));
+    psel->select(QRect(64,128,1,1));
+
+    psel->invalidateOutlineCache();
+    QVERIFY(compareWithLegacyOutline(psel));
+
+    // the polygons are closed
+    QPainterPath closedOutline = psel->outlineCache();
+    closedOutline.closeSubpath();
+    QVERIFY(psel->outlineCache() == closedOutline);
+
+    // incremental update of a part of the selection
+    {
+        const KoColor white(Qt::white, KoColorSpaceRegistry::instance()->rgb8());
+
+        KisFillPainter gc(psel);
+        gc.fillRect(QRect(100,50,40,40), white, MIN_SELECTED);
+        gc.fillRect(QRect(50,120,30,30), white, MAX_SELECTED);
+    }
+
+    psel->invalidateOutlineCache(QRect(100,50,40,40));
+    psel->invalidateOutlineCache(QRect(50,120,30,30));
+    QVERIFY(compareWithLegacyOutline(psel));
+
+    // the exact bounds of the selection have changed
+    psel->clear(QRect(0,0,120,200));
+    psel->invalidateOutlineCache(QRect(0,0,120,200));
+    QVERIFY(compareWithLegacyOutline(psel));
+
+    // inverted selection is limited by the image bounds
+    psel->invert();
+    QVERIFY(compareWithLegacyOutline(psel));
+}
+
 KISTEST_MAIN(KisPixelSelectionTest)
 
@@ -35,6 +35,7 @@ private Q_SLOTS:
     void testOutlineCacheTransactions();
 
     void testOutlineArtifacts();
+    void testTiledOutline();
 };
 
 #endif
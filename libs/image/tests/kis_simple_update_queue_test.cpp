@@ -140,6 +140,69 @@ void KisSimpleUpdateQueueTest::testSplit(bool useFullRefresh)
     QVERIFY(checkWalker(walkersList[3], QRect(512,512,488,488)));
 }
 
+void KisSimpleUpdateQueueTest::testBatchedMergeJobs()
+{
+    QRect imageRect(0,0,1024,1024);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "merge test");
+
+    KisPaintLayerSP paintLayer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+
+    KisFilterSP filter = KisFilterRegistry::instance()->value("blur");
+    Q_ASSERT(filter);
+    KisFilterConfigurationSP configuration = filter->defaultConfiguration(KisGlobalResourcesInterface::instance());
+    KisAdjustmentLayerSP adjustmentLayer = new KisAdjustmentLayer(image, "adj", configuration->cloneWithResourcesSnapshot(), 0);
+
+    image->barrierLock();
+    image->addNode(paintLayer);
+    image->addNode(adjustmentLayer);
+    image->unlock();
+
+    QRect dirtyRect1(0,0,1000,1000);
+
+    KisTestableSimpleUpdateQueue queue;
+    KisWalkersList& walkersList = queue.getWalkersList();
+
+    queue.addUpdateJob(paintLayer, dirtyRect1, imageRect, 0);
+    QCOMPARE(walkersList.size(), 4);
+
+    /**
+     * The walkers collected in one trip should be the same
+     * as the walkers collected separately
+     */
+    Q_FOREACH (KisBaseRectsWalkerSP walker, walkersList) {
+        KisMergeWalkerSP refWalker = new KisMergeWalker(imageRect);
+        refWalker->collectRects(paintLayer, walker->requestedRect());
+
+        QCOMPARE(walker->changeRect(), refWalker->changeRect());
+        QCOMPARE(walker->accessRect(), refWalker->accessRect());
+        QCOMPARE(walker->leafStack().size(), refWalker->leafStack().size());
+        QVERIFY(walker->checksumValid());
+
+        for (int i = 0; i < walker->leafStack().size(); i++) {
+            QCOMPARE(walker->leafStack()[i].m_leaf, refWalker->leafStack()[i].m_leaf);
+            QCOMPARE(walker->leafStack()[i].m_position, refWalker->leafStack()[i].m_position);
+            QCOMPARE(walker->leafStack()[i].m_applyRect, refWalker->leafStack()[i].m_applyRect);
+        }
+    }
+
+    /**
+     * With a single thread all the patches are passed to it in one batch
+     */
+    KisTestableUpdaterContext context(1);
+    queue.processQueue(context);
+
+    QVector<KisUpdateJobItem*> jobs = context.getJobs();
+    QCOMPARE(jobs.size(), 1);
+    QCOMPARE(jobs[0]->walkers().size(), 4);
+    QVERIFY(checkWalker(jobs[0]->walkers()[0], QRect(0,0,512,512)));
+    QVERIFY(checkWalker(jobs[0]->walkers()[3], QRect(512,512,488,488)));
+    QCOMPARE(jobs[0]->changeRect(),
+             jobs[0]->walkers()[0]->changeRect() | jobs[0]->walkers()[3]->changeRect());
+    QVERIFY(walkersList.isEmpty());
+}
+
 void KisSimpleUpdateQueueTest::testChecksum()
 {
     QRect imageRect(0,0,512,512);
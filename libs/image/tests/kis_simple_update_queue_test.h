@@ -21,6 +21,7 @@ private Q_SLOTS:
     void testJobProcessing();
     void testSplitUpdate();
     void testSplitFullRefresh();
+    void testBatchedMergeJobs();
     void testChecksum();
     void testMixingTypes();
     void testSpontaneousJobsCompression();
@@ -286,6 +286,60 @@ void KisWarpTransformWorkerTest::testGridSize()
     QCOMPARE(GridIterationTools::calcGridDimension(0, 300, 8), 39);
 }
 
+void KisWarpTransformWorkerTest::testAlignedStripes()
+{
+    const QRect rc(-100, -30, 500, 1000);
+    const QVector<QRect> stripes = GridIterationTools::splitIntoAlignedStripes(rc, 64);
+
+    QVERIFY(!stripes.isEmpty());
+    QCOMPARE(stripes.first().top(), rc.top());
+    QCOMPARE(stripes.last().bottom(), rc.bottom());
+
+    QRect unitedRect;
+
+    for (int i = 0; i < stripes.size(); i++) {
+        const QRect &stripe = stripes[i];
+
+        QCOMPARE(stripe.left(), rc.left());
+        QCOMPARE(stripe.width(), rc.width());
+
+        if (i > 0) {
+            QCOMPARE(stripe.top(), stripes[i - 1].bottom() + 1);
+            QCOMPARE(qAbs(stripe.top()) % 64, 0);
+        }
+
+        unitedRect |= stripe;
+    }
+
+    QCOMPARE(unitedRect, rc);
+}
+
+void KisWarpTransformWorkerTest::testCalculateGridPoints()
+{
+    const QRect rc(3, 5, 300, 200);
+    const int pixelPrecision = 8;
+
+    auto transformOp = [] (const QPointF &pt) { return 2.0 * pt + QPointF(10, 20); };
+
+    QSize gridSize;
+    QVector<QPointF> originalPoints;
+    QVector<QPointF> transformedPoints;
+
+    GridIterationTools::calculateGridPoints(rc, pixelPrecision, transformOp,
+                                            &gridSize, &originalPoints, &transformedPoints);
+
+    QCOMPARE(gridSize, GridIterationTools::calcGridSize(rc, pixelPrecision));
+    QCOMPARE(originalPoints.size(), gridSize.width() * gridSize.height());
+    QCOMPARE(transformedPoints.size(), originalPoints.size());
+
+    GridIterationTools::PrecalculatedTransformOp cachedOp(transformedPoints);
+
+    for (int i = 0; i < originalPoints.size(); i++) {
+        QCOMPARE(transformedPoints[i], transformOp(originalPoints[i]));
+        QCOMPARE(cachedOp(originalPoints[i]), transformOp(originalPoints[i]));
+    }
+}
+
 void KisWarpTransformWorkerTest::testBackwardInterpolatorExtrapolation()
 {
     QPolygonF src;
@@ -21,6 +21,8 @@ private Q_SLOTS:
     void testBackwardInterpolatorXYShear();
     void testBackwardInterpolatorRoundTrip();
     void testGridSize();
+    void testAlignedStripes();
+    void testCalculateGridPoints();
     void testBackwardInterpolatorExtrapolation();
 
     void testNeedChangeRects();
@@ -120,6 +120,19 @@ qint32 KisHLineIterator2::nConseqPixels() const
     return qMin(m_rightmostInTile, m_right) - m_x + 1;
 }
 
+qint32 KisHLineIterator2::nConseqDefaultPixels() const
+{
+    if (!m_tilesCache[m_index].isDefault) return 0;
+
+    qint32 rightmostDefault = m_rightmostInTile;
+
+    for (quint32 i = m_index + 1; i < m_tilesCacheSize && m_tilesCache[i].isDefault; i++) {
+        rightmostDefault += KisTileData::WIDTH;
+    }
+
+    return qMin(rightmostDefault, m_right) - m_x + 1;
+}
+
 
 
 bool KisHLineIterator2::nextPixels(qint32 n)
@@ -190,7 +203,9 @@ void KisHLineIterator2::switchToTile(qint32 xInTile)
 
 void KisHLineIterator2::fetchTileDataForCache(KisTileInfo& kti, qint32 col, qint32 row)
 {
-    m_dataManager->getTilesPair(col, row, m_writable, &kti.tile, &kti.oldtile);
+    bool existingTile = true;
+    m_dataManager->getTilesPair(col, row, m_writable, &kti.tile, &kti.oldtile, &existingTile);
+    kti.isDefault = !existingTile;
 
     lockTile(kti.tile);
     kti.data = kti.tile->data();
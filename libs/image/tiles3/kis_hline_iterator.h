@@ -21,6 +21,7 @@ public:
         KisTileSP oldtile;
         quint8* data {nullptr};
         quint8* oldData {nullptr};
+        bool isDefault {false};
     };
 
 
@@ -34,6 +35,7 @@ public:
     const quint8* rawDataConst() const override;
     quint8* rawData() override;
     qint32 nConseqPixels() const override;
+    qint32 nConseqDefaultPixels() const override;
     bool nextPixels(qint32 n) override;
     qint32 x() const override;
     qint32 y() const override;
@@ -64,7 +64,8 @@
 KisMementoManager::KisMementoManager()
     : m_index(0),
       m_headsHashTable(0),
-      m_registrationBlocked(false)
+      m_registrationBlocked(false),
+      m_historyMemoryMetric(0)
 {
     /**
      * Tile change/delete registration is enabled for all
@@ -78,7 +79,8 @@ KisMementoManager::KisMementoManager(const KisMementoManager& rhs)
         m_cancelledRevisions(rhs.m_cancelledRevisions),
         m_headsHashTable(rhs.m_headsHashTable, 0),
         m_currentMemento(rhs.m_currentMemento),
-        m_registrationBlocked(rhs.m_registrationBlocked)
+        m_registrationBlocked(rhs.m_registrationBlocked),
+        m_historyMemoryMetric(rhs.m_historyMemoryMetric.loadAcquire())
 {
     Q_ASSERT_X(!m_registrationBlocked,
                "KisMementoManager", "(impossible happened) "
@@ -202,6 +204,7 @@ void KisMementoManager::commit()
     hItem.itemList = revisionList;
     hItem.memento = m_currentMemento.data();
     m_revisions.append(hItem);
+    m_historyMemoryMetric.fetchAndAddOrdered(revisionMemoryMetric(revisionList));
 
     m_currentMemento = 0;
     KIS_ASSERT(m_index.isEmpty());
@@ -244,6 +247,9 @@ KisMementoSP KisMementoManager::getMemento()
     // KIS_SAFE_ASSERT_RECOVER_NOOP(m_index.isEmpty());
 
     // Clear redo() information
+    Q_FOREACH (const KisHistoryItem &changeList, m_cancelledRevisions) {
+        m_historyMemoryMetric.fetchAndAddOrdered(-revisionMemoryMetric(changeList.itemList));
+    }
     m_cancelledRevisions.clear();
 
     commit();
@@ -327,6 +333,9 @@ void KisMementoManager::rollforward(KisTileHashTable *ht, KisMementoSP memento)
 
     KisHistoryItem changeList = m_cancelledRevisions.takeFirst();
 
+    // the items will be accounted again by commit()
+    m_historyMemoryMetric.fetchAndAddOrdered(-revisionMemoryMetric(changeList.itemList));
+
     // SANITY CHECK: the transaction's memento must be in sync with
     //               the revisions list we have locally
     KIS_SAFE_ASSERT_RECOVER_NOOP(changeList.memento == memento);
@@ -361,6 +370,7 @@ void KisMementoManager::purgeHistory(KisMementoSP oldestMemento)
 
     for(; revisionIndex > 0; revisionIndex--) {
         resetRevisionHistory(m_revisions.first().itemList);
+        m_historyMemoryMetric.fetchAndAddOrdered(-revisionMemoryMetric(m_revisions.first().itemList));
         m_revisions.removeFirst();
     }
 
@@ -398,6 +408,29 @@ void KisMementoManager::resetRevisionHistory(KisMementoItemList list)
     }
 }
 
+qint32 KisMementoManager::revisionMemoryMetric(const KisMementoItemList &list)
+{
+    qint32 metric = 0;
+
+    Q_FOREACH (const KisMementoItemSP &mi, list) {
+        /**
+         * Deleted tiles reference the default tile data,
+         * which costs nothing
+         */
+        if (mi->type() == KisMementoItem::CHANGED && mi->tileData()) {
+            metric += mi->tileData()->pixelSize();
+        }
+    }
+
+    return metric;
+}
+
+qint64 KisMementoManager::historyMemorySize() const
+{
+    return qint64(m_historyMemoryMetric.loadAcquire()) *
+        KisTileData::WIDTH * KisTileData::HEIGHT;
+}
+
 void KisMementoManager::setDefaultTileData(KisTileData *defaultTileData)
 {
     m_headsHashTable.setDefaultTileData(defaultTileData);
@@ -113,9 +113,21 @@ public:
      */
     void purgeHistory(KisMementoSP oldestMemento);
 
+    /**
+     * Returns the estimated amount of memory (in bytes) occupied by
+     * the tiles stored in the undo/redo history of the device. The
+     * value is a high bound: the tiles of the newest revision are
+     * usually still shared with the device itself.
+     *
+     * The value is updated on every commit, so it is safe to read
+     * it from any thread.
+     */
+    qint64 historyMemorySize() const;
+
 protected:
     qint32 findRevisionByMemento(KisMementoSP memento) const;
     void resetRevisionHistory(KisMementoItemList list);
+    static qint32 revisionMemoryMetric(const KisMementoItemList &list);
 
 protected:
     /**
@@ -158,6 +170,13 @@ protected:
      * \see rollforward()
      */
     bool m_registrationBlocked;
+
+    /**
+     * The volume of the tiles referenced by m_revisions and
+     * m_cancelledRevisions, measured in the tile data store's
+     * metric (num_bytes / (KisTileData::WIDTH * KisTileData::HEIGHT))
+     */
+    QAtomicInt m_historyMemoryMetric;
 };
 
 #endif /* KIS_MEMENTO_MANAGER_ */
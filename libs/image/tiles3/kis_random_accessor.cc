@@ -19,6 +19,7 @@ KisRandomAccessor2::KisRandomAccessor2(KisTiledDataManager *ktm, qint32 offsetX,
         m_pixelSize(m_ktm->pixelSize()),
         m_data(0),
         m_oldData(0),
+        m_isDefault(false),
         m_writable(writable),
         m_lastX(0),
         m_lastY(0),
@@ -60,6 +61,7 @@ void KisRandomAccessor2::moveTo(qint32 x, qint32 y)
             offset *= m_pixelSize;
             m_data = kti->data + offset;
             m_oldData = kti->oldData + offset;
+            m_isDefault = kti->isDefault;
             if (i > 0) {
                 memmove(m_tilesCache + 1, m_tilesCache, i * sizeof(KisTileInfo*));
                 m_tilesCache[0] = kti;
@@ -82,6 +84,7 @@ void KisRandomAccessor2::moveTo(qint32 x, qint32 y)
     offset *= m_pixelSize;
     m_data = kti->data + offset;
     m_oldData = kti->oldData + offset;
+    m_isDefault = kti->isDefault;
     memmove(m_tilesCache + 1, m_tilesCache, (KisRandomAccessor2::CACHESIZE - 1) * sizeof(KisTileInfo*));
     m_tilesCache[0] = kti;
 }
@@ -110,7 +113,9 @@ KisRandomAccessor2::KisTileInfo* KisRandomAccessor2::fetchTileData(qint32 col, q
 {
     KisTileInfo* kti = new KisTileInfo;
 
-    m_ktm->getTilesPair(col, row, m_writable, &kti->tile, &kti->oldtile);
+    bool existingTile = true;
+    m_ktm->getTilesPair(col, row, m_writable, &kti->tile, &kti->oldtile, &existingTile);
+    kti->isDefault = !existingTile;
 
     lockTile(kti->tile);
     kti->data = kti->tile->data();
@@ -141,6 +146,11 @@ qint32 KisRandomAccessor2::rowStride(qint32 x, qint32 y) const
     return m_ktm->rowStride(x - m_offsetX, y - m_offsetY);
 }
 
+bool KisRandomAccessor2::isDefaultPixelArea() const
+{
+    return m_isDefault;
+}
+
 qint32 KisRandomAccessor2::x() const
 {
     return m_lastX;
@@ -24,6 +24,7 @@ class KisRandomAccessor2 : public KisRandomAccessorNG
         quint8* data;
         const quint8* oldData;
         qint32 area_x1, area_y1, area_x2, area_y2;
+        bool isDefault;
     };
 
 public:
@@ -76,6 +77,7 @@ public:
     qint32 numContiguousColumns(qint32 x) const override;
     qint32 numContiguousRows(qint32 y) const override;
     qint32 rowStride(qint32 x, qint32 y) const override;
+    bool isDefaultPixelArea() const override;
     qint32 x() const override;
     qint32 y() const override;
 
@@ -86,6 +88,7 @@ private:
     qint32 m_pixelSize;
     quint8* m_data;
     const quint8* m_oldData;
+    bool m_isDefault;
     bool m_writable;
     int m_lastX, m_lastY;
     qint32 m_offsetX, m_offsetY;
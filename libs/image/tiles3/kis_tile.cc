@@ -262,6 +262,13 @@ void KisTile::lockForWrite()
 
 void KisTile::unlockForWrite()
 {
+    /**
+     * The writer has accessed the data via a raw pointer, so we
+     * cannot know what has actually been changed. Just invalidate
+     * all the metadata cached in the tile data.
+     */
+    m_tileData->notifyContentChanged();
+
     unblockSwapping();
     DEBUG_LOG_ACTION("unlock [W]");
 
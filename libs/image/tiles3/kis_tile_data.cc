@@ -25,6 +25,7 @@ const qint32 KisTileData::WIDTH = __TILE_DATA_WIDTH;
 const qint32 KisTileData::HEIGHT = __TILE_DATA_HEIGHT;
 
 SimpleCache KisTileData::m_cache;
+QAtomicInteger<quint64> KisTileData::m_lastRevision(0);
 
 SimpleCache::~SimpleCache()
 {
@@ -57,7 +58,10 @@ KisTileData::KisTileData(qint32 pixelSize, const quint8 *defPixel, KisTileDataSt
       m_usersCount(0),
       m_refCount(0),
       m_pixelSize(pixelSize),
-      m_store(store)
+      m_store(store),
+      m_contentVersion(0),
+      m_revision(m_lastRevision.fetchAndAddOrdered(1) + 1),
+      m_exactBoundsVersion(-1)
 {
     if (checkFreeMemory) {
         m_store->checkFreeMemory();
@@ -86,7 +90,10 @@ KisTileData::KisTileData(const KisTileData& rhs, bool checkFreeMemory)
       m_usersCount(0),
       m_refCount(0),
       m_pixelSize(rhs.m_pixelSize),
-      m_store(rhs.m_store)
+      m_store(rhs.m_store),
+      m_contentVersion(0),
+      m_revision(m_lastRevision.fetchAndAddOrdered(1) + 1),
+      m_exactBoundsVersion(-1)
 {
     if (checkFreeMemory) {
         m_store->checkFreeMemory();
@@ -102,6 +109,27 @@ KisTileData::~KisTileData()
     releaseMemory();
 }
 
+bool KisTileData::cachedExactBounds(const QByteArray &key, QRect *bounds) const
+{
+    QMutexLocker l(&m_exactBoundsLock);
+
+    if (m_exactBoundsVersion != contentVersion() || m_exactBoundsKey != key) {
+        return false;
+    }
+
+    *bounds = m_exactBounds;
+    return true;
+}
+
+void KisTileData::setCachedExactBounds(const QByteArray &key, const QRect &bounds, int version) const
+{
+    QMutexLocker l(&m_exactBoundsLock);
+
+    m_exactBoundsKey = key;
+    m_exactBounds = bounds;
+    m_exactBoundsVersion = version;
+}
+
 void KisTileData::fillWithPixel(const quint8 *defPixel)
 {
     quint8 *it = m_data;
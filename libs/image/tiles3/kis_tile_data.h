@@ -26,6 +26,7 @@ inline quint8* KisTileData::data() const {
 void KisTileData::setData(const quint8 *data) {
     Q_ASSERT(m_data);
     memcpy(m_data, data, m_pixelSize*WIDTH*HEIGHT);
+    notifyContentChanged();
 }
 
 inline quint32 KisTileData::pixelSize() const {
@@ -107,6 +108,18 @@ inline bool KisTileData::historical() const {
     return mementoed() && numUsers() <= 1;
 }
 
+inline int KisTileData::contentVersion() const {
+    return m_contentVersion.loadAcquire();
+}
+inline void KisTileData::notifyContentChanged() {
+    m_contentVersion.ref();
+    m_revision.storeRelease(m_lastRevision.fetchAndAddOrdered(1) + 1);
+}
+
+inline quint64 KisTileData::revision() const {
+    return m_revision.loadAcquire();
+}
+
 inline int KisTileData::age() const {
     return m_age;
 }
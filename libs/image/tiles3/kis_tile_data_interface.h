@@ -10,6 +10,10 @@
 
 #include <QReadWriteLock>
 #include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QByteArray>
+#include <QMutex>
+#include <QRect>
 
 #include "kis_lockless_stack.h"
 #include "swap/kis_chunk_allocator.h"
@@ -180,6 +184,41 @@ public:
      */
     inline bool historical() const;
 
+    /**
+     * The version of the pixel data. It is incremented every time
+     * the data is (possibly) modified, that is when a tile locks
+     * or unlocks it for writing.
+     */
+    inline int contentVersion() const;
+    inline void notifyContentChanged();
+
+    /**
+     * A revision of the pixel data that is unique among all the tile
+     * data objects ever created in the process. It is updated together
+     * with contentVersion(). Unlike the address of the tile data or its
+     * contentVersion(), the revision is never reused, so it can be used
+     * as a key of the content of the tile for external caches.
+     */
+    inline quint64 revision() const;
+
+    /**
+     * The tight bounds of the non-empty pixels of the tile data
+     * (in the tile's coordinates) cached by
+     * KisTiledDataManager::calculateExactBounds(). \p key identifies
+     * the definition of the "empty" pixel used for calculating them.
+     *
+     * Returns false if the cached bounds are calculated for a different
+     * key or the data has been modified since then.
+     */
+    bool cachedExactBounds(const QByteArray &key, QRect *bounds) const;
+
+    /**
+     * Stores the bounds calculated for the data of \p version. If the
+     * data has been modified in the meantime, the bounds will never be
+     * returned by cachedExactBounds()
+     */
+    void setCachedExactBounds(const QByteArray &key, const QRect &bounds, int version) const;
+
     /**
      * Used for swapping purposes only.
      * Frees the memory occupied by the tile data.
@@ -307,6 +346,27 @@ private:
     KisTileDataStore *m_store;
     static SimpleCache m_cache;
 
+    /**
+     * Incremented on every modification of the data,
+     * see contentVersion()
+     */
+    QAtomicInt m_contentVersion;
+
+    /**
+     * See revision()
+     */
+    QAtomicInteger<quint64> m_revision;
+    static QAtomicInteger<quint64> m_lastRevision;
+
+    /**
+     * The cache of the bounds of the non-empty pixels,
+     * see cachedExactBounds()
+     */
+    mutable QMutex m_exactBoundsLock;
+    mutable QByteArray m_exactBoundsKey;
+    mutable QRect m_exactBounds;
+    mutable int m_exactBoundsVersion;
+
 public:
     static const qint32 WIDTH;
     static const qint32 HEIGHT;
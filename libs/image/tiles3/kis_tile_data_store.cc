@@ -99,6 +99,7 @@ KisTileDataStore::MemoryStatistics KisTileDataStore::memoryStatistics()
     stats.totalMemorySize = memoryMetric() * metricCoeff + stats.poolSize;
 
     stats.swapSize = m_swappedStore.totalSwapMemoryUsed();
+    stats.swapDeduplicatedSize = m_swappedStore.totalDeduplicatedMemory();
 
     return stats;
 }
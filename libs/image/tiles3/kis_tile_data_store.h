@@ -42,6 +42,7 @@ public:
         qint64 poolSize;
 
         qint64 swapSize;
+        qint64 swapDeduplicatedSize;
     };
 
     MemoryStatistics memoryStatistics();
@@ -577,6 +577,75 @@ void KisTiledDataManager::bitBltRoughOldData(KisTiledDataManager *srcDM, const Q
     bitBltRoughImpl<true>(srcDM, rect);
 }
 
+qint32 KisTiledDataManager::shareTilesWithEqualContent(TileContentIndex &index)
+{
+    QWriteLocker locker(&m_lock);
+
+    const qint32 tileDataSize = KisTileData::WIDTH * KisTileData::HEIGHT * pixelSize();
+
+    QVector<KisTileSP> tiles;
+
+    {
+        KisTileHashTableIterator iter(m_hashTable);
+        for (; !iter.isDone(); iter.next()) {
+            tiles.append(iter.tile());
+        }
+    }
+
+    qint32 numSharedTiles = 0;
+
+    Q_FOREACH (KisTileSP tile, tiles) {
+        tile->lockForRead();
+
+        KisTileData *td = tile->tileData();
+        const uint hash = qHashBits(td->data(), tileDataSize);
+
+        KisTileSP equalTile;
+
+        for (auto it = index.find(hash); it != index.end() && it.key() == hash; ++it) {
+            KisTileSP candidate = it.value();
+
+            candidate->lockForRead();
+            const bool isEqual =
+                candidate->tileData() == td ||
+                (candidate->tileData()->pixelSize() == td->pixelSize() &&
+                 !memcmp(candidate->data(), td->data(), tileDataSize));
+            candidate->unlockForRead();
+
+            if (isEqual) {
+                equalTile = candidate;
+                break;
+            }
+        }
+
+        tile->unlockForRead();
+
+        if (!equalTile) {
+            index.insert(hash, tile);
+            continue;
+        }
+
+        equalTile->lockForRead();
+        KisTileData *sharedTd = equalTile->tileData();
+        const bool alreadyShared = sharedTd == td;
+        KisTileSP sharedTile = alreadyShared ? KisTileSP() :
+            KisTileSP(new KisTile(tile->col(), tile->row(), sharedTd, m_mementoManager));
+        equalTile->unlockForRead();
+
+        if (alreadyShared) continue;
+
+        /**
+         * The content is the same, so the extent and the cached
+         * bounds of the device stay untouched
+         */
+        m_hashTable->deleteTile(tile->col(), tile->row());
+        m_hashTable->addTile(sharedTile);
+        numSharedTiles++;
+    }
+
+    return numSharedTiles;
+}
+
 void KisTiledDataManager::setExtent(qint32 x, qint32 y, qint32 w, qint32 h)
 {
     setExtent(QRect(x, y, w, h));
@@ -9,6 +9,7 @@
 
 #include <QtGlobal>
 #include <QVector>
+#include <QMultiHash>
 #include <KisRegion.h>
 
 #include <kis_shared.h>
@@ -91,8 +92,15 @@ public:
      * Merging two calls into one allows us to avoid additional tile fetch from
      * the hash table and therefore reduce waiting time.
      */
-    inline void getTilesPair(qint32 col, qint32 row, bool writable, KisTileSP *tile, KisTileSP *oldTile) {
-        *tile = getTile(col, row, writable);
+    /**
+     * Fetches the current and the committed (old) tiles at
+     * (\p col, \p row). If \p existingTile is not null, it is set to
+     * false when the current tile is a detached default tile, i.e. there
+     * is no tile in the data manager and all its pixels are guaranteed to
+     * be equal to the default pixel. Writable tiles always exist.
+     */
+    inline void getTilesPair(qint32 col, qint32 row, bool writable, KisTileSP *tile, KisTileSP *oldTile, bool *existingTile = 0) {
+        *tile = getTile(col, row, writable, existingTile);
 
         bool unused;
         *oldTile = m_mementoManager->getCommittedTile(col, row, unused);
@@ -102,18 +110,25 @@ public:
         }
     }
 
-    inline KisTileSP getTile(qint32 col, qint32 row, bool writable) {
+    inline KisTileSP getTile(qint32 col, qint32 row, bool writable, bool *existingTile = 0) {
         if (writable) {
             bool newTile;
             KisTileSP tile = m_hashTable->getTileLazy(col, row, newTile);
             if (newTile) {
                 m_extentManager.notifyTileAdded(col, row);
             }
+            if (existingTile) {
+                *existingTile = true;
+            }
             return tile;
 
         } else {
-            bool unused;
-            return m_hashTable->getReadOnlyTileLazy(col, row, unused);
+            bool existing;
+            KisTileSP tile = m_hashTable->getReadOnlyTileLazy(col, row, existing);
+            if (existingTile) {
+                *existingTile = existing;
+            }
+            return tile;
         }
     }
 
@@ -190,6 +205,16 @@ public:
         m_mementoManager->purgeHistory(oldestMemento);
     }
 
+    /**
+     * Returns the estimated size of the undo/redo
+     * history of the data manager in bytes
+     *
+     * \see KisMementoManager::historyMemorySize()
+     */
+    qint64 historyMemorySize() const {
+        return m_mementoManager->historyMemorySize();
+    }
+
     static void releaseInternalPools();
 
 protected:
@@ -216,6 +241,33 @@ public:
 
     KisRegion region() const;
 
+    /**
+     * Calculates the bounds of the pixels for which \p emptyPixelOp
+     * returns false. The operation should have the following interface:
+     *
+     * \code
+     * bool isPixelEmpty(const quint8 *pixelData);
+     * \endcode
+     *
+     * The bounds of every tile are cached in its tile data, so only
+     * the tiles changed since the previous call are actually scanned.
+     * Therefore \p cacheKey must uniquely identify the behavior of
+     * \p emptyPixelOp (e.g. contain the default pixel it compares to).
+     */
+    template <class EmptyPixelOp>
+    QRect calculateExactBounds(const QByteArray &cacheKey, EmptyPixelOp emptyPixelOp) const;
+
+    /**
+     * Returns the revision of the data of the tile (\p col, \p row),
+     * see KisTileData::revision(). The tiles that don't exist report
+     * the revision of the default tile data.
+     */
+    inline quint64 tileRevision(qint32 col, qint32 row) const {
+        bool existingTile = false;
+        KisTileSP tile = m_hashTable->getReadOnlyTileLazy(col, row, existingTile);
+        return tile->tileData()->revision();
+    }
+
     void clear(QRect clearRect, quint8 clearValue);
     void clear(QRect clearRect, const quint8 *clearPixel);
     void clear(qint32 x, qint32 y, qint32 w, qint32 h, quint8 clearValue);
@@ -249,6 +301,26 @@ public:
      */
     void bitBltRoughOldData(KisTiledDataManager *srcDM, const QRect &rect);
 
+    /**
+     * Tiles of several data managers, indexed by the hash of their
+     * content. Used by \ref shareTilesWithEqualContent()
+     */
+    typedef QMultiHash<uint, KisTileSP> TileContentIndex;
+
+    /**
+     * Makes every tile of this data manager, whose content is equal to
+     * the content of some tile in \p index, share the tile data with that
+     * tile (copy-on-write). The tiles that have no equal counterpart are
+     * added to \p index, so that the data managers processed after this
+     * one could share them.
+     *
+     * All the data managers passed through the same \p index must have the
+     * same pixel size and must not be modified while the index is in use.
+     *
+     * @return the number of tiles that started sharing their data
+     */
+    qint32 shareTilesWithEqualContent(TileContentIndex &index);
+
     /**
      * write the specified data to x, y. There is no checking on pixelSize!
      */
@@ -402,6 +474,90 @@ public:
 
 };
 
+template <class EmptyPixelOp>
+QRect KisTiledDataManager::calculateExactBounds(const QByteArray &cacheKey, EmptyPixelOp emptyPixelOp) const
+{
+    const int pixelSize = m_pixelSize;
+
+    auto isRowEmpty = [&] (const quint8 *data, int row) {
+        const quint8 *ptr = data + row * KisTileData::WIDTH * pixelSize;
+        for (int x = 0; x < KisTileData::WIDTH; x++, ptr += pixelSize) {
+            if (!emptyPixelOp.isPixelEmpty(ptr)) return false;
+        }
+        return true;
+    };
+
+    auto scanTile = [&] (const quint8 *data) {
+        int top = 0;
+        while (top < KisTileData::HEIGHT && isRowEmpty(data, top)) {
+            top++;
+        }
+
+        if (top >= KisTileData::HEIGHT) return QRect();
+
+        int bottom = KisTileData::HEIGHT - 1;
+        while (bottom > top && isRowEmpty(data, bottom)) {
+            bottom--;
+        }
+
+        int left = KisTileData::WIDTH;
+        int right = -1;
+
+        for (int y = top; y <= bottom; y++) {
+            const quint8 *row = data + y * KisTileData::WIDTH * pixelSize;
+
+            for (int x = 0; x < left; x++) {
+                if (!emptyPixelOp.isPixelEmpty(row + x * pixelSize)) {
+                    left = x;
+                    break;
+                }
+            }
+
+            for (int x = KisTileData::WIDTH - 1; x > right; x--) {
+                if (!emptyPixelOp.isPixelEmpty(row + x * pixelSize)) {
+                    right = x;
+                    break;
+                }
+            }
+        }
+
+        return QRect(left, top, right - left + 1, bottom - top + 1);
+    };
+
+    QRect bounds;
+
+    KisTileHashTableConstIterator iter(m_hashTable);
+    KisTileSP tile;
+
+    while ((tile = iter.tile())) {
+        QRect tileBounds;
+
+        /**
+         * The cached bounds are checked before locking the tile,
+         * so the unchanged tiles are not even fetched from the swap
+         */
+        if (!tile->tileData()->cachedExactBounds(cacheKey, &tileBounds)) {
+            tile->lockForRead();
+
+            KisTileData *tileData = tile->tileData();
+            const int version = tileData->contentVersion();
+
+            tileBounds = scanTile(tileData->data());
+            tileData->setCachedExactBounds(cacheKey, tileBounds, version);
+
+            tile->unlockForRead();
+        }
+
+        if (!tileBounds.isEmpty()) {
+            bounds |= tileBounds.translated(tile->extent().topLeft());
+        }
+
+        iter.next();
+    }
+
+    return bounds;
+}
+
 // during development the following line helps to check the interface is correct
 // it should be safe to keep it here even during normal compilation
 //#include "kis_datamanager.h"
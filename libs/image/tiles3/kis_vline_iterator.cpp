@@ -125,6 +125,19 @@ qint32 KisVLineIterator2::nConseqPixels() const
     return 1;
 }
 
+qint32 KisVLineIterator2::nConseqDefaultPixels() const
+{
+    if (!m_tilesCache[m_index].isDefault) return 0;
+
+    qint32 bottommostDefault = (m_topRow + m_index + 1) * KisTileData::HEIGHT - 1;
+
+    for (qint32 i = m_index + 1; i < m_tilesCacheSize && m_tilesCache[i].isDefault; i++) {
+        bottommostDefault += KisTileData::HEIGHT;
+    }
+
+    return qMin(bottommostDefault, m_bottom) - m_y + 1;
+}
+
 bool KisVLineIterator2::nextPixels(qint32 n)
 {
     Q_ASSERT_X(!(m_y > 0 && (m_y + n) < 0), "vlineIt+=", "Integer overflow");
@@ -193,7 +206,9 @@ void KisVLineIterator2::switchToTile(qint32 yInTile)
 
 void KisVLineIterator2::fetchTileDataForCache(KisTileInfo& kti, qint32 col, qint32 row)
 {
-    m_dataManager->getTilesPair(col, row, m_writable, &kti.tile, &kti.oldtile);
+    bool existingTile = true;
+    m_dataManager->getTilesPair(col, row, m_writable, &kti.tile, &kti.oldtile, &existingTile);
+    kti.isDefault = !existingTile;
 
     lockTile(kti.tile);
     kti.data = kti.tile->data();
@@ -10,13 +10,17 @@
 #include "kis_image_config.h"
 
 #include "kis_tile_compressor_2.h"
+#include "kis_assert.h"
 
 //#define COMPRESSOR_VERSION 2
 
 KisSwappedDataStore::KisSwappedDataStore()
-    : m_totalSwapMemoryUsed(0)
+    : m_totalSwapMemoryUsed(0),
+      m_totalDeduplicatedMemory(0)
 {
     KisImageConfig config(true);
+    m_deduplicateChunks = config.deduplicateSwappedTiles();
+
     const quint64 maxSwapSize = config.maxSwapSize() * MiB;
     const quint64 swapSlabSize = config.swapSlabSize() * MiB;
     const quint64 swapWindowSize = config.swapWindowSize() * MiB;
@@ -37,10 +41,11 @@ KisSwappedDataStore::~KisSwappedDataStore()
 
 quint64 KisSwappedDataStore::numTiles() const
 {
-    // We are not acquiring the lock here...
-    // Hope QLinkedList will ensure atomic access to it's size...
-
-    return m_allocator->numChunks();
+    /**
+     * Several tile data objects may share the same chunk,
+     * so we cannot just count the chunks in the allocator
+     */
+    return m_numTiles.loadAcquire();
 }
 
 bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
@@ -61,6 +66,13 @@ bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
     qint32 bytesWritten;
     m_compressor->compressTileData(td, (quint8*) m_buffer.data(), m_buffer.size(), bytesWritten);
 
+    const uint contentHash =
+        m_deduplicateChunks ? qHashBits(m_buffer.constData(), bytesWritten) : 0;
+
+    if (m_deduplicateChunks && tryShareExistingChunk(td, bytesWritten, contentHash)) {
+        return true;
+    }
+
     KisChunk chunk = m_allocator->getChunk(bytesWritten);
     quint8 *ptr = m_swapSpace->getWriteChunkPtr(chunk);
     if (!ptr) {
@@ -73,10 +85,68 @@ bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
     td->setSwapChunk(chunk);
 
     m_totalSwapMemoryUsed += chunk.size();
+    m_numTiles.ref();
+
+    if (m_deduplicateChunks) {
+        SharedChunk sharedChunk;
+        sharedChunk.chunk = chunk;
+        sharedChunk.dataSize = bytesWritten;
+        sharedChunk.contentHash = contentHash;
+        sharedChunk.numUsers = 1;
+
+        m_sharedChunks.insert(chunk.begin(), sharedChunk);
+        m_chunksByContent.insert(contentHash, chunk.begin());
+    }
 
     return true;
 }
 
+bool KisSwappedDataStore::tryShareExistingChunk(KisTileData *td, qint32 dataSize, uint contentHash)
+{
+    for (auto it = m_chunksByContent.constFind(contentHash);
+         it != m_chunksByContent.constEnd() && it.key() == contentHash; ++it) {
+
+        auto chunkIt = m_sharedChunks.find(it.value());
+        KIS_SAFE_ASSERT_RECOVER(chunkIt != m_sharedChunks.end()) { continue; }
+
+        if (chunkIt->dataSize != dataSize) continue;
+
+        quint8 *ptr = m_swapSpace->getReadChunkPtr(chunkIt->chunk);
+        if (!ptr || memcmp(ptr, m_buffer.constData(), dataSize) != 0) continue;
+
+        chunkIt->numUsers++;
+
+        td->releaseMemory();
+        td->setSwapChunk(chunkIt->chunk);
+
+        m_totalDeduplicatedMemory += chunkIt->chunk.size();
+        m_numTiles.ref();
+
+        return true;
+    }
+
+    return false;
+}
+
+void KisSwappedDataStore::releaseChunk(KisChunk chunk)
+{
+    m_numTiles.deref();
+
+    auto chunkIt = m_sharedChunks.find(chunk.begin());
+    if (chunkIt != m_sharedChunks.end()) {
+        if (--chunkIt->numUsers > 0) {
+            m_totalDeduplicatedMemory -= chunk.size();
+            return;
+        }
+
+        m_chunksByContent.remove(chunkIt->contentHash, chunk.begin());
+        m_sharedChunks.erase(chunkIt);
+    }
+
+    m_totalSwapMemoryUsed -= chunk.size();
+    m_allocator->freeChunk(chunk);
+}
+
 void KisSwappedDataStore::swapInTileData(KisTileData *td)
 {
     Q_ASSERT(!td->data());
@@ -85,7 +155,6 @@ void KisSwappedDataStore::swapInTileData(KisTileData *td)
     // see comment in swapOutTileData()
 
     KisChunk chunk = td->swapChunk();
-    m_totalSwapMemoryUsed -= chunk.size();
 
     td->allocateMemory();
     td->setSwapChunk(KisChunk());
@@ -93,16 +162,14 @@ void KisSwappedDataStore::swapInTileData(KisTileData *td)
     quint8 *ptr = m_swapSpace->getReadChunkPtr(chunk);
     Q_ASSERT(ptr);
     m_compressor->decompressTileData(ptr, chunk.size(), td);
-    m_allocator->freeChunk(chunk);
+    releaseChunk(chunk);
 }
 
 void KisSwappedDataStore::forgetTileData(KisTileData *td)
 {
     QMutexLocker locker(&m_lock);
 
-    m_totalSwapMemoryUsed -= td->swapChunk().size();
-
-    m_allocator->freeChunk(td->swapChunk());
+    releaseChunk(td->swapChunk());
     td->setSwapChunk(KisChunk());
 }
 
@@ -111,6 +178,11 @@ qint64 KisSwappedDataStore::totalSwapMemoryUsed() const
     return m_totalSwapMemoryUsed;
 }
 
+qint64 KisSwappedDataStore::totalDeduplicatedMemory() const
+{
+    return m_totalDeduplicatedMemory;
+}
+
 void KisSwappedDataStore::debugStatistics()
 {
     m_allocator->sanityCheck();
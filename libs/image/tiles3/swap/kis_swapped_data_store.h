@@ -10,7 +10,12 @@
 #include "kritaimage_export.h"
 
 #include <QMutex>
+#include <QAtomicInt>
 #include <QByteArray>
+#include <QHash>
+#include <QMultiHash>
+
+#include "kis_chunk_allocator.h"
 
 
 class QMutex;
@@ -59,12 +64,40 @@ public:
      */
     qint64 totalSwapMemoryUsed() const;
 
+    /**
+     * Returns the amount of swap space saved by storing equal
+     * tiles only once
+     */
+    qint64 totalDeduplicatedMemory() const;
+
     /**
      * Some debugging output
      */
     void debugStatistics();
 
 private:
+    bool tryShareExistingChunk(KisTileData *td, qint32 dataSize, uint contentHash);
+    void releaseChunk(KisChunk chunk);
+
+private:
+    /**
+     * Tile data with equal content (e.g. flat fills or duplicated
+     * layers) are compressed into equal byte sequences. Such tiles
+     * are written into the swap file only once and share the
+     * chunk, which is freed when its last user is swapped in.
+     */
+    struct SharedChunk {
+        KisChunk chunk;
+        qint32 dataSize = 0;
+        uint contentHash = 0;
+        int numUsers = 0;
+    };
+
+    /// shared chunks indexed by their offset in the swap file
+    QHash<quint64, SharedChunk> m_sharedChunks;
+    QMultiHash<uint, quint64> m_chunksByContent;
+    bool m_deduplicateChunks;
+
     QByteArray m_buffer;
     KisAbstractTileCompressor *m_compressor;
 
@@ -74,6 +107,8 @@ private:
     QMutex m_lock;
 
     qint64 m_totalSwapMemoryUsed;
+    qint64 m_totalDeduplicatedMemory;
+    QAtomicInt m_numTiles;
 };
 
 #endif /* __KIS_SWAPPED_DATA_STORE_H */
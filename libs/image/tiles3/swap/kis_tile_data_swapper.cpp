@@ -112,7 +112,20 @@ void KisTileDataSwapper::doJob()
 
     DEBUG_VALUE(m_d->limits.softLimitThreshold());
     DEBUG_VALUE(m_d->limits.hardLimitThreshold());
+    DEBUG_VALUE(m_d->limits.undoLimitThreshold());
 
+    if (m_d->limits.undoLimitThreshold() > 0) {
+        const qint32 historicalMetric = historicalMemoryMetric();
+        DEBUG_VALUE(historicalMetric);
+
+        if (historicalMetric > m_d->limits.undoLimitThreshold()) {
+            qint32 undoFree = historicalMetric - m_d->limits.undoLimit();
+            DEBUG_VALUE(undoFree);
+            DEBUG_ACTION("\t undo pass");
+            memoryMetric -= pass<SoftSwapStrategy>(undoFree);
+            DEBUG_VALUE(memoryMetric);
+        }
+    }
 
     if(memoryMetric > m_d->limits.softLimitThreshold()) {
         qint32 softFree =  memoryMetric - m_d->limits.softLimit();
@@ -131,6 +144,28 @@ void KisTileDataSwapper::doJob()
     }
 }
 
+qint32 KisTileDataSwapper::historicalMemoryMetric()
+{
+    /**
+     * The pooler's statistics may be outdated (or not gathered at all
+     * when the pool is disabled), so we count the tiles ourselves.
+     * Swapped out tiles are not present in the list anymore.
+     */
+    qint32 metric = 0;
+
+    KisTileDataStoreIterator *iter = m_d->store->beginIteration();
+
+    while (iter->hasNext()) {
+        KisTileData *item = iter->next();
+        if (item->historical()) {
+            metric += item->pixelSize();
+        }
+    }
+
+    m_d->store->endIteration(iter);
+
+    return metric;
+}
 
 class SoftSwapStrategy
 {
@@ -35,6 +35,7 @@ private:
     void run() override;
 
     void doJob();
+    qint32 historicalMemoryMetric();
     template<class strategy> qint64 pass(qint64 needToFreeMetric);
 
 private:
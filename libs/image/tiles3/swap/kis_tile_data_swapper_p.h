@@ -41,6 +41,13 @@
   |                        |
   +------------------------+  <-- 0 MiB
 
+  Independently from the limits above, the amount of memento tiles
+  kept in memory can be limited by undoLimitThreshold. When the undo
+  history grows above it, the swapper compresses the oldest memento
+  tiles into the swap store until their volume reaches undoLimit.
+  The tiles are loaded back transparently when the history is rolled
+  back.
+
  */
 
 
@@ -57,6 +64,9 @@ public:
 
         m_softLimitThreshold = qBound(0, MiB_TO_METRIC(config.tilesSoftLimit()), m_hardLimitThreshold);
         m_softLimit = m_softLimitThreshold - m_softLimitThreshold / 8;
+
+        m_undoLimitThreshold = qMax(0, MiB_TO_METRIC(config.undoMemoryLimit()));
+        m_undoLimit = m_undoLimitThreshold - m_undoLimitThreshold / 8;
     }
 
     /**
@@ -83,12 +93,25 @@ public:
         return m_softLimit;
     }
 
+    /**
+     * Zero means that the undo history is not limited
+     */
+    inline qint32 undoLimitThreshold() {
+        return m_undoLimitThreshold;
+    }
+
+    inline qint32 undoLimit() {
+        return m_undoLimit;
+    }
+
 private:
     qint32 m_emergencyThreshold;
     qint32 m_hardLimitThreshold;
     qint32 m_hardLimit;
     qint32 m_softLimitThreshold;
     qint32 m_softLimit;
+    qint32 m_undoLimitThreshold;
+    qint32 m_undoLimit;
 };
 
 
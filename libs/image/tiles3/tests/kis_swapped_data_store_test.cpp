@@ -119,5 +119,57 @@ void KisSwappedDataStoreTest::testRandomAccess()
         delete tileDataList[i];
 }
 
+void KisSwappedDataStoreTest::testDeduplication()
+{
+    const qint32 pixelSize = 1;
+    const quint8 defaultPixel = 128;
+    const qint32 NUM_TILES = 100;
+    const qint32 NUM_COLORS = 4;
+
+    KisImageConfig config(false);
+    config.setMaxSwapSize(4);
+    config.setSwapSlabSize(1);
+    config.setSwapWindowSize(1);
+    config.setDeduplicateSwappedTiles(true);
+
+    KisSwappedDataStore store;
+
+    QList<KisTileData*> tileDataList;
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        KisTileData *td = new KisTileData(pixelSize, &defaultPixel, KisTileDataStore::instance());
+        memset(td->data(), COLUMN2COLOR(i % NUM_COLORS), TILESIZE);
+        tileDataList.append(td);
+    }
+
+    qint64 swapUsedForColors = 0;
+
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        QVERIFY(store.trySwapOutTileData(tileDataList[i]));
+
+        if (i == NUM_COLORS - 1) {
+            swapUsedForColors = store.totalSwapMemoryUsed();
+            QCOMPARE(store.totalDeduplicatedMemory(), qint64(0));
+        }
+    }
+
+    // only one chunk per color has been written
+    QCOMPARE(store.numTiles(), quint64(NUM_TILES));
+    QCOMPARE(store.totalSwapMemoryUsed(), swapUsedForColors);
+    QVERIFY(store.totalDeduplicatedMemory() > 0);
+
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        KisTileData *td = tileDataList[i];
+        store.swapInTileData(td);
+        QVERIFY(memoryIsFilled(COLUMN2COLOR(i % NUM_COLORS), td->data(), TILESIZE));
+    }
+
+    QCOMPARE(store.numTiles(), quint64(0));
+    QCOMPARE(store.totalSwapMemoryUsed(), qint64(0));
+    QCOMPARE(store.totalDeduplicatedMemory(), qint64(0));
+
+    for(qint32 i = 0; i < NUM_TILES; i++)
+        delete tileDataList[i];
+}
+
 SIMPLE_TEST_MAIN(KisSwappedDataStoreTest)
 
@@ -462,6 +462,92 @@ void KisTiledDataManagerTest::testPurgeHistory()
     dm.purgeHistory(memento4);
 }
 
+void KisTiledDataManagerTest::testHistoryMemorySize()
+{
+    quint8 defaultPixel = 0;
+    KisTiledDataManager dm(1, &defaultPixel);
+
+    quint8 oddPixel1 = 128;
+    quint8 oddPixel2 = 129;
+
+    QCOMPARE(dm.historyMemorySize(), qint64(0));
+
+    KisMementoSP memento1 = dm.getMemento();
+    dm.clear(0, 0, 128, 64, &oddPixel1);
+    dm.commit();
+
+    QCOMPARE(dm.historyMemorySize(), qint64(2 * TILESIZE));
+
+    KisMementoSP memento2 = dm.getMemento();
+    dm.clear(0, 0, 64, 64, &oddPixel2);
+    dm.commit();
+
+    QCOMPARE(dm.historyMemorySize(), qint64(3 * TILESIZE));
+
+    /**
+     * Undone revisions are still kept for redo
+     */
+    dm.rollback(memento2);
+    QCOMPARE(dm.historyMemorySize(), qint64(3 * TILESIZE));
+
+    dm.rollforward(memento2);
+    QCOMPARE(dm.historyMemorySize(), qint64(3 * TILESIZE));
+
+    /**
+     * Starting a new transaction drops the redo history
+     */
+    dm.rollback(memento2);
+    KisMementoSP memento3 = dm.getMemento();
+    dm.commit();
+
+    QCOMPARE(dm.historyMemorySize(), qint64(2 * TILESIZE));
+
+    dm.purgeHistory(memento3);
+    QCOMPARE(dm.historyMemorySize(), qint64(0));
+}
+
+struct CheckZeroPixel {
+    bool isPixelEmpty(const quint8 *pixelData) {
+        return *pixelData == 0;
+    }
+};
+
+void KisTiledDataManagerTest::testCalculateExactBounds()
+{
+    quint8 defaultPixel = 0;
+    KisTiledDataManager dm(1, &defaultPixel);
+
+    const QByteArray key("zero");
+
+    QCOMPARE(dm.calculateExactBounds(key, CheckZeroPixel()), QRect());
+
+    quint8 oddPixel = 128;
+    dm.setPixel(70, 5, &oddPixel);
+    dm.setPixel(3, 130, &oddPixel);
+
+    QCOMPARE(dm.calculateExactBounds(key, CheckZeroPixel()), QRect(3, 5, 68, 126));
+
+    /**
+     * The bounds of the changed tile must be recalculated,
+     * even though it still exists in the data manager
+     */
+    dm.setPixel(70, 5, &defaultPixel);
+    QCOMPARE(dm.calculateExactBounds(key, CheckZeroPixel()), QRect(3, 130, 1, 1));
+
+    KisMementoSP memento = dm.getMemento();
+    dm.setPixel(100, 100, &oddPixel);
+    dm.setPixel(3, 130, &defaultPixel);
+    dm.commit();
+
+    QCOMPARE(dm.calculateExactBounds(key, CheckZeroPixel()), QRect(100, 100, 1, 1));
+
+    dm.rollback(memento);
+    QCOMPARE(dm.calculateExactBounds(key, CheckZeroPixel()), QRect(3, 130, 1, 1));
+
+    dm.rollforward(memento);
+    QCOMPARE(dm.calculateExactBounds(key, CheckZeroPixel()), QRect(100, 100, 1, 1));
+}
+
 void KisTiledDataManagerTest::testUndoSetDefaultPixel()
 {
     quint8 defaultPixel = 0;
@@ -39,6 +39,8 @@ private Q_SLOTS:
     void testBitBltRough();
     void testTransactions();
     void testPurgeHistory();
+    void testHistoryMemorySize();
+    void testCalculateExactBounds();
     void testUndoSetDefaultPixel();
 
     void benchmarkReadOnlyTileLazy();
@@ -8,6 +8,8 @@
 #include <QMimeDatabase>
 #include <QMimeType>
 #include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
 #include <kis_debug.h>
 
 #include <klocalizedstring.h>
@@ -159,6 +161,14 @@ QString KisMimeDatabase::iconNameForMimeType(const QString &mimeType)
 
 void KisMimeDatabase::fillMimeData()
 {
+    /**
+     * The resources may be loaded concurrently, so the database can be
+     * requested from several threads at once. It is never changed after
+     * being filled, so only the filling itself should be serialized.
+     */
+    static QMutex fillMutex;
+    QMutexLocker locker(&fillMutex);
+
     // This should come from the import/export plugins, but the json files aren't translated,
     // which is bad for the description field
     if (s_mimeDatabase.isEmpty()) {
@@ -296,3 +296,11 @@ bool KisBundleStorage::exportResource(const QString &url, QIODevice *device)
 
     return true;
 }
+
+QString KisBundleStorage::fingerprint() const
+{
+    const QString bundleFingerprint = KisStoragePlugin::fingerprint();
+    if (bundleFingerprint.isEmpty()) return QString();
+
+    return bundleFingerprint + ":" + folderFingerprint({location() + "_modified"});
+}
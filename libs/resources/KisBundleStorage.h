@@ -38,6 +38,10 @@ public:
 
     bool exportResource(const QString &url, QIODevice *device) override;
 
+    /// The fingerprint covers the bundle file itself and the folder
+    /// with the modified versions of its resources
+    QString fingerprint() const override;
+
 private:
     friend class BundleIterator;
 
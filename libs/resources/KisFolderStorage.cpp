@@ -148,6 +148,23 @@ QString KisFolderStorage::resourceFilePath(const QString &url)
     return file.exists() ? file.absoluteFilePath() : QString();
 }
 
+bool KisFolderStorage::supportsConcurrentLoading() const
+{
+    return true;
+}
+
+QString KisFolderStorage::fingerprint() const
+{
+    // the storage folder also contains bundles, the database and other
+    // unrelated files, so only the resource type subfolders are checked
+    QStringList paths;
+    Q_FOREACH (const QString &resourceType, KisResourceLoaderRegistry::instance()->resourceTypes()) {
+        paths << location() + "/" + resourceType;
+    }
+
+    return folderFingerprint(paths);
+}
+
 QSharedPointer<KisResourceStorage::ResourceIterator> KisFolderStorage::resources(const QString &resourceType)
 {
     QVector<VersionedResourceEntry> entries;
@@ -40,6 +40,11 @@ public:
 
     QString resourceMd5(const QString &url) override;
     QString resourceFilePath(const QString &url) override;
+
+    QString fingerprint() const override;
+
+    /// Every resource is a separate file, so they can be loaded concurrently
+    bool supportsConcurrentLoading() const override;
 private:
     friend class FolderIterator;
 
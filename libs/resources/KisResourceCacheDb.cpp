@@ -14,6 +14,7 @@
 #include <QDataStream>
 #include <QByteArray>
 #include <QMessageBox>
+#include <QtConcurrentMap>
 
 #include <KritaVersionWrapper.h>
 
@@ -60,6 +61,12 @@ QString changeToEmptyIfNull(QString s)
     return s.isNull() ? QString("") : s;
 }
 
+// the fingerprints of the synchronized storages are kept in the metadata
+// table under a separate table name, so that they don't mix with the
+// metadata of the storage itself
+const QString storageFingerprintTable = "storage_fingerprints";
+const QString storageFingerprintKey = "fingerprint";
+
 bool updateSchemaVersion()
 {
     QFile f(":/fill_version_information.sql");
@@ -1052,11 +1059,63 @@ bool KisResourceCacheDb::addResource(KisResourceStorageSP storage, QDateTime tim
     return true;
 
 
+}
+
+namespace {
+
+struct PendingResourceVersion
+{
+    QString url;
+    QString type;
+    QDateTime lastModified;
+    int guessedVersion = -1;
+
+    KoResourceSP resource;
+    QString md5;
+};
+
+/**
+ * The number of resources loaded concurrently while the previous
+ * chunk is being written into the database. It limits the number
+ * of the resources kept in memory at the same time.
+ */
+const int concurrentLoadingChunkSize = 256;
+
 }
 
 bool KisResourceCacheDb::addResources(KisResourceStorageSP storage, QString resourceType)
 {
-    QSqlDatabase::database().transaction();
+    /// The first valid version of a resource creates the resource
+    /// itself, the following versions are added to it
+    auto addPendingResourceVersion = [storage] (const PendingResourceVersion &item, int &resourceId) {
+        KoResourceSP resource = item.resource;
+        if (!resource || !resource->valid()) return;
+
+        resource->setVersion(item.guessedVersion);
+        resource->setMD5Sum(item.md5);
+
+        if (resourceId < 0) {
+            if (addResource(storage, item.lastModified, resource, item.type)) {
+                resourceId = resource->resourceId();
+            } else {
+                qWarning() << "Could not add resource" << resource->filename() << "to the database";
+            }
+        } else {
+            if (!addResourceVersion(resourceId, item.lastModified, storage, resource)) {
+                qWarning() << "Could not add resource version" << resource->filename() << "to the database";
+            }
+        }
+    };
+
+    const bool loadConcurrently = storage->supportsConcurrentLoading();
+
+    /// Each entry is a list of the versions of a single resource
+    QVector<QVector<PendingResourceVersion>> pendingResources;
+
+    if (!loadConcurrently) {
+        QSqlDatabase::database().transaction();
+    }
+
     QSharedPointer<KisResourceStorage::ResourceIterator> iter = storage->resources(resourceType);
     while (iter->hasNext()) {
         iter->next();
@@ -1064,30 +1123,95 @@ bool KisResourceCacheDb::addResources(KisResourceStorageSP storage, QString reso
         QSharedPointer<KisResourceStorage::ResourceIterator> verIt =
             iter->versions();
 
-        int resourceId = -1;
+        QVector<PendingResourceVersion> versions;
 
         while (verIt->hasNext()) {
             verIt->next();
 
-            KoResourceSP resource = verIt->resource();
-            if (resource && resource->valid()) {
-                resource->setVersion(verIt->guessedVersion());
-                resource->setMD5Sum(storage->resourceMd5(verIt->url()));
+            PendingResourceVersion item;
+            item.url = verIt->url();
+            item.type = iter->type();
+            item.lastModified = iter->lastModified();
+            item.guessedVersion = verIt->guessedVersion();
 
-                if (resourceId < 0) {
-                    if (addResource(storage, iter->lastModified(), resource, iter->type())) {
-                        resourceId = resource->resourceId();
-                    } else {
-                        qWarning() << "Could not add resource" << resource->filename() << "to the database";
-                    }
-                } else {
-                    if (!addResourceVersion(resourceId, iter->lastModified(), storage, resource)) {
-                        qWarning() << "Could not add resource version" << resource->filename() << "to the database";
-                    }
+            if (!loadConcurrently) {
+                item.resource = verIt->resource();
+                item.md5 = storage->resourceMd5(item.url);
+            }
+
+            versions.append(item);
+        }
+
+        if (!loadConcurrently) {
+            int resourceId = -1;
+            Q_FOREACH (const PendingResourceVersion &item, versions) {
+                addPendingResourceVersion(item, resourceId);
+            }
+        } else {
+            pendingResources.append(versions);
+        }
+    }
+
+    if (!loadConcurrently) {
+        QSqlDatabase::database().commit();
+        return true;
+    }
+
+    /// The storage allows loading its resources concurrently, so they are
+    /// loaded on the thread pool chunk by chunk, while the previous chunk
+    /// is being written into the database. If the loaders of this resource
+    /// type are not thread-safe, only the md5 sums are calculated there.
+    /// The database connection belongs to this thread, so all the queries
+    /// are executed here.
+
+    const bool parseConcurrently =
+        KisResourceLoaderRegistry::instance()->supportsConcurrentLoading(resourceType);
+
+    auto loadFunc = [storage, parseConcurrently] (QVector<PendingResourceVersion> &versions) {
+        for (auto it = versions.begin(); it != versions.end(); ++it) {
+            it->md5 = storage->resourceMd5(it->url);
+            if (parseConcurrently) {
+                it->resource = storage->resource(it->url);
+            }
+        }
+    };
+
+    QVector<QVector<QVector<PendingResourceVersion>>> chunks;
+    for (int i = 0; i < pendingResources.size(); i += concurrentLoadingChunkSize) {
+        chunks.append(pendingResources.mid(i, concurrentLoadingChunkSize));
+    }
+    pendingResources.clear();
+
+    QFuture<void> nextChunkFuture;
+    if (!chunks.isEmpty()) {
+        nextChunkFuture = QtConcurrent::map(chunks.first(), loadFunc);
+    }
+
+    QSqlDatabase::database().transaction();
+
+    for (int chunkIndex = 0; chunkIndex < chunks.size(); chunkIndex++) {
+        nextChunkFuture.waitForFinished();
+
+        if (chunkIndex + 1 < chunks.size()) {
+            nextChunkFuture = QtConcurrent::map(chunks[chunkIndex + 1], loadFunc);
+        }
+
+        for (auto resIt = chunks[chunkIndex].begin(); resIt != chunks[chunkIndex].end(); ++resIt) {
+            int resourceId = -1;
+
+            for (auto it = resIt->begin(); it != resIt->end(); ++it) {
+                if (!parseConcurrently) {
+                    it->resource = storage->resource(it->url);
                 }
+
+                addPendingResourceVersion(*it, resourceId);
             }
+
+            // release the memory as soon as the resource is in the database
+            resIt->clear();
         }
     }
+
     QSqlDatabase::database().commit();
     return true;
 }
@@ -1596,6 +1720,24 @@ bool KisResourceCacheDb::deleteStorage(QString location)
         }
     }
 
+    {
+        QSqlQuery q;
+        if (!q.prepare("DELETE FROM metadata\n"
+                       "WHERE  table_name = :table\n"
+                       "AND    foreign_id = (SELECT storages.id\n"
+                       "                     FROM   storages\n"
+                       "                     WHERE  storages.location = :location);")) {
+            qWarning() << "Could not prepare delete storage fingerprint query" << q.lastError();
+            return false;
+        }
+        q.bindValue(":table", storageFingerprintTable);
+        q.bindValue(":location", changeToEmptyIfNull(location));
+        if (!q.exec()) {
+            qWarning() << "Could not execute delete storage fingerprint query" << q.lastError();
+            return false;
+        }
+    }
+
     {
         QSqlQuery q;
         if (!q.prepare("DELETE FROM storages\n"
@@ -1926,6 +2068,59 @@ bool KisResourceCacheDb::synchronizeStorage(KisResourceStorageSP storage)
     return success;
 }
 
+namespace {
+int storageIdForLocation(const QString &location)
+{
+    QSqlQuery q;
+    if (!q.prepare("SELECT id\n"
+                   "FROM   storages\n"
+                   "WHERE  location = :location\n")) {
+        qWarning() << "Could not prepare storage id query" << q.lastError();
+        return -1;
+    }
+
+    q.bindValue(":location", changeToEmptyIfNull(location));
+
+    if (!q.exec()) {
+        qWarning() << "Could not execute storage id query" << q.boundValues() << q.lastError();
+        return -1;
+    }
+
+    return q.first() ? q.value(0).toInt() : -1;
+}
+}
+
+bool KisResourceCacheDb::storageIsUpToDate(KisResourceStorageSP storage, const QString &fingerprint)
+{
+    if (!s_valid || fingerprint.isEmpty()) return false;
+
+    const int storageId =
+        storageIdForLocation(KisResourceLocator::instance()->makeStorageLocationRelative(storage->location()));
+    if (storageId < 0) return false;
+
+    const QMap<QString, QVariant> map = metaDataForId(storageId, storageFingerprintTable);
+    if (map.value(storageFingerprintKey).toString() != fingerprint) return false;
+
+    storage->setStorageId(storageId);
+    return true;
+}
+
+bool KisResourceCacheDb::updateStorageFingerprint(KisResourceStorageSP storage, const QString &fingerprint)
+{
+    if (!s_valid) return false;
+
+    const int storageId =
+        storageIdForLocation(KisResourceLocator::instance()->makeStorageLocationRelative(storage->location()));
+    if (storageId < 0) return false;
+
+    QMap<QString, QVariant> map;
+    if (!fingerprint.isEmpty()) {
+        map[storageFingerprintKey] = fingerprint;
+    }
+
+    return updateMetaDataForId(map, storageId, storageFingerprintTable);
+}
+
 void KisResourceCacheDb::deleteTemporaryResources()
 {
     QSqlDatabase::database().transaction();
@@ -124,6 +124,22 @@ private:
     static bool deleteStorage(QString location);
     static bool synchronizeStorage(KisResourceStorageSP storage);
 
+    /**
+     * Checks whether the storage has already been synchronized while it
+     * had exactly the same \p fingerprint. If so, the storage id is assigned
+     * to \p storage and the storage doesn't need to be synchronized again.
+     *
+     * \see KisStoragePlugin::fingerprint()
+     */
+    static bool storageIsUpToDate(KisResourceStorageSP storage, const QString &fingerprint);
+
+    /**
+     * Saves the \p fingerprint of the freshly synchronized storage. An empty
+     * fingerprint resets the saved one, so the storage will be synchronized
+     * on the next start.
+     */
+    static bool updateStorageFingerprint(KisResourceStorageSP storage, const QString &fingerprint);
+
     /**
      * @brief metaDataForId
      * @param id
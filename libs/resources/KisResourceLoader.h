@@ -98,13 +98,29 @@ public:
         return load(resource, dev, resourcesInterface) ? resource : 0;
     }
 
+    /**
+     * @return true if the resources of this kind can be loaded from
+     * several threads at once. It is allowed only when loading of
+     * the resource neither accesses the resource database (e.g. to
+     * import embedded resources) nor creates any GUI objects.
+     */
+    bool supportsConcurrentLoading() const
+    {
+        return m_supportsConcurrentLoading;
+    }
+
+    void setSupportsConcurrentLoading(bool value)
+    {
+        m_supportsConcurrentLoading = value;
+    }
+
 
 private:
     QString m_resourceSubType;
     QString m_resourceType;
     QStringList m_mimetypes;
     QString m_name;
-
+    bool m_supportsConcurrentLoading = false;
 };
 
 template<typename T>
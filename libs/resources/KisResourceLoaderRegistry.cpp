@@ -13,6 +13,8 @@
 #include <KisResourceCacheDb.h>
 #include <KisMimeDatabase.h>
 
+#include <algorithm>
+
 struct KisResourceLoaderRegistry::Private
 {
     QMap<int, ResourceCacheFixup*> fixups;
@@ -66,6 +68,17 @@ QVector<KisResourceLoaderBase *> KisResourceLoaderRegistry::resourceTypeLoaders(
     return r;
 }
 
+bool KisResourceLoaderRegistry::supportsConcurrentLoading(const QString &resourceType) const
+{
+    const QVector<KisResourceLoaderBase*> loaders = resourceTypeLoaders(resourceType);
+
+    return !loaders.isEmpty() &&
+        std::all_of(loaders.begin(), loaders.end(),
+                    [] (const KisResourceLoaderBase *loader) {
+                        return loader->supportsConcurrentLoading();
+                    });
+}
+
 void KisResourceLoaderRegistry::registerFixup(int priority, ResourceCacheFixup *fixup)
 {
     m_d->fixups.insert(priority, fixup);
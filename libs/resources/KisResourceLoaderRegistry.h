@@ -60,6 +60,12 @@ public:
      */
     QVector<KisResourceLoaderBase*> resourceTypeLoaders(const QString &resourceType) const;
 
+    /**
+     * @return true if all the loaders for the given resource type
+     * support concurrent loading of the resources
+     */
+    bool supportsConcurrentLoading(const QString &resourceType) const;
+
     /**
      * Sometimes the database needs updates without changing
      * the schema of the database. E.g. when we need to update
@@ -18,6 +18,7 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QBuffer>
+#include <QtConcurrentMap>
 
 #include <kconfig.h>
 #include <kconfiggroup.h>
@@ -1161,18 +1162,61 @@ bool KisResourceLocator::synchronizeDb()
 
 
     findStorages();
+
+    struct StorageFingerprint {
+        KisResourceStorageSP storage;
+        QString fingerprint;
+    };
+
+    QVector<StorageFingerprint> fingerprints;
     Q_FOREACH(const KisResourceStorageSP storage, d->storages) {
-        if (!KisResourceCacheDb::synchronizeStorage(storage)) {
-            d->errorMessages.append(i18n("Could not synchronize %1 with the database", storage->location()));
+        fingerprints.append({storage, QString()});
+    }
+
+    /// A storage is scanned only if its content, the set of the resource
+    /// types or the version of Krita have changed since the last start
+    const QString fingerprintSuffix =
+        KritaVersionWrapper::versionString() + ":" +
+        KisResourceLoaderRegistry::instance()->resourceTypes().join(',');
+
+    /// Calculating the fingerprint means walking through the storage
+    /// folders on disk, so it is done concurrently. The database
+    /// connection belongs to this thread, so all the queries are
+    /// still executed here.
+    QtConcurrent::blockingMap(fingerprints,
+        [fingerprintSuffix] (StorageFingerprint &item) {
+            const QString fingerprint = item.storage->fingerprint();
+            if (!fingerprint.isEmpty()) {
+                item.fingerprint = fingerprint + ":" + fingerprintSuffix;
+            }
+        });
+
+    QVector<StorageFingerprint> changedStorages;
+
+    Q_FOREACH(const StorageFingerprint &item, fingerprints) {
+        if (KisResourceCacheDb::storageIsUpToDate(item.storage, item.fingerprint)) {
+            continue;
+        }
+
+        changedStorages.append(item);
+
+        if (!KisResourceCacheDb::synchronizeStorage(item.storage)) {
+            d->errorMessages.append(i18n("Could not synchronize %1 with the database", item.storage->location()));
+            changedStorages.last().fingerprint.clear();
         }
     }
 
-    Q_FOREACH(const KisResourceStorageSP storage, d->storages) {
-        if (!KisResourceCacheDb::addStorageTags(storage)) {
-            d->errorMessages.append(i18n("Could not synchronize %1 with the database", storage->location()));
+    Q_FOREACH(const StorageFingerprint &item, changedStorages) {
+        if (!KisResourceCacheDb::addStorageTags(item.storage)) {
+            d->errorMessages.append(i18n("Could not synchronize %1 with the database", item.storage->location()));
+            continue;
         }
+
+        KisResourceCacheDb::updateStorageFingerprint(item.storage, item.fingerprint);
     }
 
+    debugResource << "Synchronized" << changedStorages.size() << "of" << fingerprints.size() << "storages";
+
     // now remove the storages that no longer exists
     KisStorageModel model;
 
@@ -16,6 +16,7 @@
 #include <KisResourceCacheDb.h>
 
 #include <KisResourceModelProvider.h>
+#include <KisResourceThumbnailCache.h>
 #include <KisStorageModel.h>
 #include <KisTagModel.h>
 #include <KisResourceTypes.h>
@@ -50,6 +51,8 @@ KisAllResourcesModel::KisAllResourcesModel(const QString &resourceType, QObject
     connect(KisResourceLocator::instance(), SIGNAL(endExternalResourceRemove(QString)), this, SLOT(endExternalResourceRemove(QString)));
     connect(KisResourceLocator::instance(), SIGNAL(resourceActiveStateChanged(QString, int)), this, SLOT(slotResourceActiveStateChanged(QString, int)));
 
+    connect(KisResourceThumbnailCache::instance(), SIGNAL(thumbnailLoaded(QString, int)), this, SLOT(slotThumbnailLoaded(QString, int)), Qt::QueuedConnection);
+
     d->resourceType = resourceType;
 
     bool r = d->resourcesQuery.prepare("SELECT resources.id\n"
@@ -706,6 +709,18 @@ void KisAllResourcesModel::slotResourceActiveStateChanged(const QString &resourc
     }
 }
 
+void KisAllResourcesModel::slotThumbnailLoaded(const QString &resourceType, int resourceId)
+{
+    if (resourceType != d->resourceType) return;
+    if (resourceId < 0) return;
+
+    QModelIndex index = indexForResourceId(resourceId);
+
+    if (index.isValid()) {
+        Q_EMIT dataChanged(index, index, {Qt::DecorationRole, Qt::UserRole + KisAbstractResourceModel::Thumbnail});
+    }
+}
+
 struct KisResourceModel::Private
 {
     ResourceFilter resourceFilter {ShowActiveResources};
@@ -306,6 +306,12 @@ private Q_SLOTS:
      */
     void slotResourceActiveStateChanged(const QString &resourceType, int resourceId);
 
+    /**
+     * A connection for KisResourceThumbnailCache, which is triggered when
+     * a smooth thumbnail of the resource has been loaded in the background
+     */
+    void slotThumbnailLoaded(const QString &resourceType, int resourceId);
+
 public:
 
     KoResourceSP resourceForId(int id) const;
@@ -172,6 +172,11 @@ QDateTime KisResourceStorage::timestamp() const
     return d->storagePlugin->timestamp();
 }
 
+QString KisResourceStorage::fingerprint() const
+{
+    return d->storagePlugin->fingerprint();
+}
+
 QDateTime KisResourceStorage::timeStampForResource(const QString &resourceType, const QString &filename) const
 {
     QFileInfo li(d->location);
@@ -241,6 +246,11 @@ bool KisResourceStorage::supportsVersioning() const
     return d->storagePlugin->supportsVersioning();
 }
 
+bool KisResourceStorage::supportsConcurrentLoading() const
+{
+    return d->storagePlugin->supportsConcurrentLoading();
+}
+
 bool KisResourceStorage::loadVersionedResource(KoResourceSP resource)
 {
     return d->storagePlugin->loadVersionedResource(resource);
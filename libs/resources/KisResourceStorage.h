@@ -177,6 +177,11 @@ public:
     /// for memory storages.
     QDateTime timestamp() const;
 
+    /// A cheap fingerprint of the on-disk state of the storage, or an
+    /// empty string if the storage cannot be fingerprinted.
+    /// \see KisStoragePlugin::fingerprint()
+    QString fingerprint() const;
+
     /// The time and date when the resource was last modified
     /// For filestorage
     QDateTime timeStampForResource(const QString &resourceType, const QString &filename) const;
@@ -236,6 +241,10 @@ public:
     /// It enables loadVersionedResource() call.
     bool supportsVersioning() const;
 
+    /// Returns true if resource() and resourceMd5() can be called
+    /// from several threads at once
+    bool supportsConcurrentLoading() const;
+
     /// Reloads the given resource from the persistent storage
     bool loadVersionedResource(KoResourceSP resource);
 
@@ -6,15 +6,28 @@
 
 #include "KisResourceThumbnailCache.h"
 
-#include <QMap>
+#include <QCache>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QHash>
 #include <QModelIndex>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QSet>
 #include <QSize>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QtConcurrentRun>
 
 #include <KisResourceLocator.h>
 #include <KisResourceModel.h>
 
 #include <kis_global.h>
 
+#include <algorithm>
+
 Q_GLOBAL_STATIC(KisResourceThumbnailCache, s_instance);
 
 struct ImageScalingParameters {
@@ -22,74 +35,186 @@ struct ImageScalingParameters {
     Qt::AspectRatioMode aspectRatioMode;
     Qt::TransformationMode transformationMode;
 
-    bool operator<(const ImageScalingParameters &other) const
+    bool operator==(const ImageScalingParameters &other) const
     {
-        if (size != other.size) {
-            if (size.width() != other.size.width()) {
-                return size.width() < other.size.width();
-            } else {
-                return size.height() < other.size.height();
-            }
-        } else if (aspectRatioMode != other.aspectRatioMode) {
-            return aspectRatioMode < other.aspectRatioMode;
-        } else if (transformationMode != other.transformationMode) {
-            return transformationMode < other.transformationMode;
-        } else {
-            // they're the same
-            return false;
-        }
+        return size == other.size &&
+            aspectRatioMode == other.aspectRatioMode &&
+            transformationMode == other.transformationMode;
     }
 };
 
 namespace
 {
 using ResourceKey = QPair<QString, QString>;
-using ThumbnailCacheT = QMap<ImageScalingParameters, QImage>;
+
+struct ScaledThumbnailKey {
+    ResourceKey resource;
+    ImageScalingParameters param;
+
+    bool operator==(const ScaledThumbnailKey &other) const
+    {
+        return resource == other.resource && param == other.param;
+    }
+};
+
+uint qHash(const ScaledThumbnailKey &key, uint seed = 0)
+{
+    return ::qHash(key.resource, seed) ^
+        ::qHash(key.param.size.width(), seed) ^
+        ::qHash(key.param.size.height() << 16, seed) ^
+        ::qHash(int(key.param.aspectRatioMode) << 4 | int(key.param.transformationMode), seed);
+}
+
+/**
+ * Memory budgets for the in-memory levels of the cache. QCache
+ * counts costs in int, so the costs are measured in KiB.
+ */
+const int defaultOriginalCacheLimitKiB = 64 * 1024;
+const int defaultScaledCacheLimitKiB = 32 * 1024;
+
+/**
+ * The disk cache is trimmed to this size on startup, the oldest
+ * thumbnails are removed first.
+ */
+const qint64 diskCacheLimit = 128 * 1024 * 1024;
+
+int imageCost(const QImage &image)
+{
+    return int(image.sizeInBytes() / 1024) + 1;
+}
+
+void trimDiskCache(const QString &location, qint64 limit)
+{
+    QFileInfoList files;
+    qint64 totalSize = 0;
+
+    QDirIterator it(location, QStringList() << "*.png", QDir::Files);
+    while (it.hasNext()) {
+        it.next();
+        files << it.fileInfo();
+        totalSize += it.fileInfo().size();
+    }
+
+    if (totalSize <= limit) return;
+
+    std::sort(files.begin(), files.end(),
+              [] (const QFileInfo &lhs, const QFileInfo &rhs) {
+                  return lhs.lastModified() < rhs.lastModified();
+              });
+
+    for (auto it = files.begin(); it != files.end() && totalSize > limit; ++it) {
+        if (QFile::remove(it->absoluteFilePath())) {
+            totalSize -= it->size();
+        }
+    }
+}
+
+QString diskCacheFilePath(const QString &location, const QString &md5, ImageScalingParameters param)
+{
+    return QString("%1/%2_%3x%4_%5.png")
+        .arg(location)
+        .arg(md5)
+        .arg(param.size.width())
+        .arg(param.size.height())
+        .arg(int(param.aspectRatioMode));
+}
+
 } // namespace
 
+/**
+ * The cache has two levels:
+ *
+ * 1) In memory, the original thumbnails and the scaled versions
+ *    are kept in two LRU caches with a limited memory budget.
+ *
+ * 2) On disk, smoothly scaled thumbnails are kept in the cache
+ *    location of the application. The files are named after the md5 sum
+ *    of the resource, so they never become stale and need no
+ *    invalidation. Only the smooth versions are saved, because fast
+ *    scaling is cheaper than loading a PNG file.
+ *
+ * The GUI thread never touches the disk. When a smooth thumbnail is not
+ * in memory, a fast rescaled version is returned right away, and the
+ * smooth one is loaded from the disk (or scaled and saved there) in the
+ * background. It is put into the memory cache when ready, and
+ * thumbnailLoaded() is emitted, so the views get it on the next repaint.
+ */
 struct KisResourceThumbnailCache::Private {
-    QMap<ResourceKey, ThumbnailCacheT> scaledThumbnailCache;
-    QMap<ResourceKey, QImage> originalImageCache;
+    Private(KisResourceThumbnailCache *_q)
+        : q(_q)
+        , originalImageCache(defaultOriginalCacheLimitKiB)
+        , scaledThumbnailCache(defaultScaledCacheLimitKiB)
+    {
+        diskCachePool.setMaxThreadCount(1);
+    }
+
+    KisResourceThumbnailCache *q;
 
-    QImage getExactMatch(const ResourceKey &key, ImageScalingParameters param) const;
-    QImage getOriginal(const ResourceKey &key) const;
+    QCache<ResourceKey, QImage> originalImageCache;
+    QCache<ScaledThumbnailKey, QImage> scaledThumbnailCache;
+    QString diskCacheLocation;
+
+    /// The smooth thumbnails being loaded in the background. The
+    /// key is removed when the resource is reloaded or removed, then
+    /// the loaded thumbnail is dropped as stale.
+    QSet<ScaledThumbnailKey> pendingScaledThumbnails;
+
+    /// The resource locator may load resources (and, therefore, insert
+    /// thumbnails) from non-GUI threads, and every lookup in an LRU cache
+    /// changes its state. All the members above are guarded by it.
+    QMutex mutex;
+
+    /// Destroyed first, so it waits for the background loading tasks
+    /// while the caches are still alive
+    QThreadPool diskCachePool;
+
+    QImage getExactMatch(const ResourceKey &key, ImageScalingParameters param);
+    QImage getOriginal(const ResourceKey &key);
     void insertOriginal(const ResourceKey &key, const QImage &image);
     bool containsOriginal(const ResourceKey &key) const;
+    void removeScaled(const ResourceKey &key);
+
+    void loadScaledAsync(const ResourceKey &key,
+                         ImageScalingParameters param,
+                         const QString &filePath,
+                         const QImage &original,
+                         const QString &resourceType,
+                         int resourceId);
 
     ResourceKey
     key(const QString &storageLocation, const QString &resourceType, const QString &filename) const;
 };
 
 QImage KisResourceThumbnailCache::Private::getExactMatch(const ResourceKey &key,
-                                                         ImageScalingParameters param) const
+                                                         ImageScalingParameters param)
 {
-    const auto thumbnailEntries = scaledThumbnailCache.find(key);
-    if (thumbnailEntries != scaledThumbnailCache.end()) {
-        const auto scaledThumbnail = thumbnailEntries->find(param);
-        if (scaledThumbnail != thumbnailEntries->end()) {
-            return *scaledThumbnail;
-        }
+    const QImage *scaledThumbnail = scaledThumbnailCache.object({key, param});
+    if (scaledThumbnail) {
+        return *scaledThumbnail;
     }
 
-    const auto originalImage = originalImageCache.find(key);
-    if (originalImage != originalImageCache.end() && originalImage->size() == param.size) {
+    const QImage *originalImage = originalImageCache.object(key);
+    if (originalImage && originalImage->size() == param.size) {
         return *originalImage;
     }
 
     return QImage();
 }
 
-QImage KisResourceThumbnailCache::Private::getOriginal(const ResourceKey &key) const
+QImage KisResourceThumbnailCache::Private::getOriginal(const ResourceKey &key)
 {
-    return originalImageCache[key];
+    const QImage *image = originalImageCache.object(key);
+    return image ? *image : QImage();
 }
 
 void KisResourceThumbnailCache::Private::insertOriginal(const ResourceKey &key, const QImage &image)
 {
-    // Someone else has added the image to this cache, when the only path to here is from a method which
-    // checks whether this cache contains it or not.
-    KIS_ASSERT(!originalImageCache.contains(key));
-    originalImageCache.insert(key, image);
+    // the resource has been reloaded, so its scaled versions may be stale
+    if (originalImageCache.contains(key)) {
+        removeScaled(key);
+    }
+
+    originalImageCache.insert(key, new QImage(image), imageCost(image));
 }
 
 bool KisResourceThumbnailCache::Private::containsOriginal(const ResourceKey &key) const
@@ -97,6 +222,61 @@ bool KisResourceThumbnailCache::Private::containsOriginal(const ResourceKey &key
     return originalImageCache.contains(key);
 }
 
+void KisResourceThumbnailCache::Private::removeScaled(const ResourceKey &key)
+{
+    Q_FOREACH (const ScaledThumbnailKey &scaledKey, scaledThumbnailCache.keys()) {
+        if (scaledKey.resource == key) {
+            scaledThumbnailCache.remove(scaledKey);
+        }
+    }
+
+    for (auto it = pendingScaledThumbnails.begin(); it != pendingScaledThumbnails.end();) {
+        if (it->resource == key) {
+            it = pendingScaledThumbnails.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void KisResourceThumbnailCache::Private::loadScaledAsync(const ResourceKey &key,
+                                                         ImageScalingParameters param,
+                                                         const QString &filePath,
+                                                         const QImage &original,
+                                                         const QString &resourceType,
+                                                         int resourceId)
+{
+    const ScaledThumbnailKey scaledKey = {key, param};
+
+    {
+        QMutexLocker l(&mutex);
+        if (pendingScaledThumbnails.contains(scaledKey)) return;
+        pendingScaledThumbnails.insert(scaledKey);
+    }
+
+    QtConcurrent::run(&diskCachePool, [this, scaledKey, filePath, original, resourceType, resourceId] () {
+        QImage image = QFileInfo::exists(filePath) ? QImage(filePath, "PNG") : QImage();
+
+        if (image.isNull()) {
+            const ImageScalingParameters &param = scaledKey.param;
+            image = original.scaled(param.size, param.aspectRatioMode, param.transformationMode);
+
+            QSaveFile file(filePath);
+            if (file.open(QIODevice::WriteOnly) && image.save(&file, "PNG")) {
+                file.commit();
+            }
+        }
+
+        {
+            QMutexLocker l(&mutex);
+            if (!pendingScaledThumbnails.remove(scaledKey)) return;
+            scaledThumbnailCache.insert(scaledKey, new QImage(image), imageCost(image));
+        }
+
+        Q_EMIT q->thumbnailLoaded(resourceType, resourceId);
+    });
+}
+
 ResourceKey KisResourceThumbnailCache::Private::key(const QString &storageLocation,
                                                     const QString &resourceType,
                                                     const QString &filename) const
@@ -110,20 +290,43 @@ KisResourceThumbnailCache *KisResourceThumbnailCache::instance()
 }
 
 KisResourceThumbnailCache::KisResourceThumbnailCache()
-    : m_d(new Private)
+    : m_d(new Private(this))
 {
+    const QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cacheLocation.isEmpty()) {
+        const QString diskCacheLocation = cacheLocation + "/resourcethumbnails";
+        if (QDir().mkpath(diskCacheLocation)) {
+            m_d->diskCacheLocation = diskCacheLocation;
+            QtConcurrent::run(&trimDiskCache, diskCacheLocation, diskCacheLimit);
+        }
+    }
 }
 
 KisResourceThumbnailCache::~KisResourceThumbnailCache()
 {
+    // the background tasks emit signals from this object
+    m_d->diskCachePool.waitForDone();
+}
+
+void KisResourceThumbnailCache::setMemoryLimits(int originalsLimitKiB, int scaledLimitKiB)
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->originalImageCache.setMaxCost(originalsLimitKiB);
+    m_d->scaledThumbnailCache.setMaxCost(scaledLimitKiB);
+}
+
+void KisResourceThumbnailCache::setDiskCacheLocation(const QString &location)
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->diskCacheLocation = location;
 }
 
 QImage KisResourceThumbnailCache::originalImage(const QString &storageLocation,
                                                 const QString &resourceType,
                                                 const QString &filename) const
 {
-    const ResourceKey key = m_d->key(storageLocation, resourceType, filename);
-    return m_d->containsOriginal(key) ? m_d->getOriginal(key) : QImage();
+    QMutexLocker l(&m_d->mutex);
+    return m_d->getOriginal(m_d->key(storageLocation, resourceType, filename));
 }
 
 void KisResourceThumbnailCache::insert(const QString &storageLocation,
@@ -139,6 +342,11 @@ void KisResourceThumbnailCache::insert(const QString &storageLocation,
 
 void KisResourceThumbnailCache::insert(const QPair<QString, QString> &key, const QImage &image)
 {
+    if (image.isNull()) {
+        return;
+    }
+
+    QMutexLocker l(&m_d->mutex);
     m_d->insertOriginal(key, image);
 }
 
@@ -151,17 +359,9 @@ void KisResourceThumbnailCache::remove(const QString &storageLocation,
 
 void KisResourceThumbnailCache::remove(const QPair<QString, QString> &key)
 {
-    if (m_d->originalImageCache.contains(key)) {
-        m_d->originalImageCache.remove(key);
-
-        if (m_d->scaledThumbnailCache.contains(key)) {
-            m_d->scaledThumbnailCache.remove(key);
-        }
-    } else {
-        // Something must have gone wrong for thumbnail to exist in scaledThumbnailCache but not be in
-        // original.
-        KIS_ASSERT(!m_d->scaledThumbnailCache.contains(key));
-    }
+    QMutexLocker l(&m_d->mutex);
+    m_d->originalImageCache.remove(key);
+    m_d->removeScaled(key);
 }
 
 QImage KisResourceThumbnailCache::getImage(const QModelIndex &index,
@@ -178,30 +378,61 @@ QImage KisResourceThumbnailCache::getImage(const QModelIndex &index,
     const ImageScalingParameters param = {size, aspectMode, transformMode};
 
     ResourceKey key = m_d->key(storageLocation, resourceType, filename);
+    QString diskCacheLocation;
 
-    QImage result = m_d->getExactMatch(key, param);
-    if (!result.isNull()) {
-        return result;
-    } else if (m_d->containsOriginal(key)) {
+    {
+        QMutexLocker l(&m_d->mutex);
+
+        QImage result = m_d->getExactMatch(key, param);
+        if (!result.isNull()) {
+            return result;
+        }
+
+        diskCacheLocation = m_d->diskCacheLocation;
+    }
+
+    const bool useDiskCache =
+        param.size.isValid() &&
+        param.transformationMode == Qt::SmoothTransformation &&
+        !diskCacheLocation.isEmpty();
+
+    const QString md5 = useDiskCache ?
+        index.data(Qt::UserRole + KisAbstractResourceModel::MD5).value<QString>() :
+        QString();
+
+    QImage result;
+
+    {
+        QMutexLocker l(&m_d->mutex);
         result = m_d->getOriginal(key);
-    } else {
+    }
+
+    if (result.isNull()) {
+        // NOTE: the mutex must not be held here, because the model will
+        // call insert() via KisResourceQueryMapper
         result = index.data(Qt::UserRole + KisAbstractResourceModel::Thumbnail).value<QImage>();
         // KisResourceQueryMapper should have inserted the image, so we don't have to.
         // Why there? Because most of the API usage for Thumbnail is going to be from index.data(), so we just
         // remove the dependency that our user has to know this class for just accessing the cached original
         // thumbnail.
-        KIS_SAFE_ASSERT_RECOVER_NOOP(result.isNull() || m_d->containsOriginal(key));
     }
     // if the size that the has been demanded, we will then cache the size and then pass it.
     if (!result.isNull() && param.size.isValid()) {
+        if (!md5.isEmpty()) {
+            // the fast version is not cached, the smooth one will replace it
+            m_d->loadScaledAsync(key, param, diskCacheFilePath(diskCacheLocation, md5, param), result,
+                                 resourceType,
+                                 index.data(Qt::UserRole + KisAbstractResourceModel::Id).toInt());
+            return result.scaled(param.size, param.aspectRatioMode, Qt::FastTransformation);
+        }
+
         const QImage scaledImage = result.scaled(param.size, param.aspectRatioMode, param.transformationMode);
-        if (m_d->scaledThumbnailCache.contains(key)) {
-            m_d->scaledThumbnailCache[key].insert(param, scaledImage);
-        } else {
-            ThumbnailCacheT scaledCacheMap;
-            scaledCacheMap.insert(param, scaledImage);
-            m_d->scaledThumbnailCache.insert(key, scaledCacheMap);
+
+        {
+            QMutexLocker l(&m_d->mutex);
+            m_d->scaledThumbnailCache.insert({key, param}, new QImage(scaledImage), imageCost(scaledImage));
         }
+
         return scaledImage;
     } else {
         return result;
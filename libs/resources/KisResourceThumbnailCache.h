@@ -8,14 +8,25 @@
 #define __KISRESOURCETHUMBNAILCACHE_H_
 
 #include <QImage>
+#include <QObject>
 #include <QScopedPointer>
 
 #include "kritaresources_export.h"
 
 class QModelIndex;
 
-class KRITARESOURCES_EXPORT KisResourceThumbnailCache
+/**
+ * A cache of resource thumbnails shared by all the resource choosers.
+ *
+ * The original thumbnails (as stored in the resource database) and
+ * the versions scaled to the requested sizes are kept in memory in
+ * two LRU caches with a limited memory budget. Smoothly scaled
+ * thumbnails are also saved into the application's cache folder, so
+ * they don't have to be rescaled after a restart.
+ */
+class KRITARESOURCES_EXPORT KisResourceThumbnailCache : public QObject
 {
+    Q_OBJECT
 public:
     KisResourceThumbnailCache();
     ~KisResourceThumbnailCache();
@@ -27,10 +38,33 @@ public:
                     Qt::AspectRatioMode aspectMode = Qt::IgnoreAspectRatio,
                     Qt::TransformationMode transformMode = Qt::FastTransformation);
 
+Q_SIGNALS:
+    /**
+     * Emitted when a smooth thumbnail of the resource has been loaded in
+     * the background. Until then getImage() returns a fast scaled version
+     * of it, so the views showing the resource should be repainted.
+     *
+     * The signal is emitted from a background thread.
+     */
+    void thumbnailLoaded(const QString &resourceType, int resourceId);
+
 private:
     friend class KisResourceQueryMapper;
     friend class KisResourceLocator;
     friend class KisStorageModel;
+    friend class TestResourceThumbnailCache;
+
+    /**
+     * Sets the memory budgets of the original and the scaled thumbnails
+     * in KiB. The least recently used thumbnails are removed first.
+     */
+    void setMemoryLimits(int originalsLimitKiB, int scaledLimitKiB);
+
+    /**
+     * Sets the folder where smoothly scaled thumbnails are saved. An empty
+     * location disables the disk cache.
+     */
+    void setDiskCacheLocation(const QString &location);
 
     /*
      * Check if we have the original image in the cache.
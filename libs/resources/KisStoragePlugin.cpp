@@ -7,6 +7,10 @@
 #include "KisStoragePlugin.h"
 #include <QFileInfo>
 #include <QDir>
+#include <QDirIterator>
+#include <QCryptographicHash>
+
+#include <algorithm>
 
 #include <KoResource.h>
 #include <KisMimeDatabase.h>
@@ -84,6 +88,11 @@ bool KisStoragePlugin::supportsVersioning() const
     return true;
 }
 
+bool KisStoragePlugin::supportsConcurrentLoading() const
+{
+    return false;
+}
+
 QDateTime KisStoragePlugin::timestamp()
 {
     if (d->timestamp.isNull()) {
@@ -92,6 +101,55 @@ QDateTime KisStoragePlugin::timestamp()
     return d->timestamp;
 }
 
+QString KisStoragePlugin::fingerprint() const
+{
+    const QFileInfo info(d->location);
+    if (!info.isFile()) return QString();
+
+    return QString("%1:%2")
+        .arg(info.size())
+        .arg(info.lastModified().toMSecsSinceEpoch());
+}
+
+QString KisStoragePlugin::folderFingerprint(const QStringList &paths)
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+
+    Q_FOREACH (const QString &path, paths) {
+        hash.addData(path.toUtf8());
+
+        if (!QFileInfo(path).isDir()) {
+            hash.addData("!", 1);
+            continue;
+        }
+
+        QStringList entries;
+
+        const QDir dir(path);
+        QDirIterator it(path,
+                        QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot,
+                        QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            const QFileInfo info = it.fileInfo();
+            entries << QString("%1:%2:%3")
+                       .arg(dir.relativeFilePath(info.filePath()))
+                       .arg(info.size())
+                       .arg(info.lastModified().toMSecsSinceEpoch());
+        }
+
+        // the order of QDirIterator is not guaranteed
+        std::sort(entries.begin(), entries.end());
+
+        Q_FOREACH (const QString &entry, entries) {
+            hash.addData(entry.toUtf8());
+            hash.addData("\n", 1);
+        }
+    }
+
+    return QString::fromLatin1(hash.result().toHex());
+}
+
 QString KisStoragePlugin::location() const
 {
     return d->location;
@@ -37,6 +37,12 @@ public:
     virtual QString resourceFilePath(const QString &url);
     virtual bool loadVersionedResource(KoResourceSP resource) = 0;
     virtual bool supportsVersioning() const;
+
+    /// Returns true if resource() and resourceMd5() can be called from
+    /// several threads at once, e.g. when every resource is a separate
+    /// file on disk. It allows the resource database to load the
+    /// resources of a new storage on a thread pool.
+    virtual bool supportsConcurrentLoading() const;
     virtual QSharedPointer<KisResourceStorage::ResourceIterator> resources(const QString &resourceType) = 0;
     virtual QSharedPointer<KisResourceStorage::TagIterator> tags(const QString &resourceType) = 0;
 
@@ -52,6 +58,24 @@ public:
 
     QDateTime timestamp();
 
+    /**
+     * Returns a cheap fingerprint of the current on-disk state of the
+     * storage. The fingerprint is saved into the database after every
+     * synchronization, and if it hasn't changed on the next start, the
+     * storage is not scanned at all.
+     *
+     * The fingerprint must change whenever any resource or tag file of
+     * the storage is added, removed or modified. An empty string means
+     * the storage cannot be fingerprinted and must always be scanned.
+     *
+     * The default implementation uses the size and the modification
+     * time of the storage file, if the storage is a single file.
+     *
+     * NOTE: the method is called from a worker thread, so it must not
+     *       access the database or any GUI objects.
+     */
+    virtual QString fingerprint() const;
+
     virtual bool isValid() const;
 
 protected:
@@ -67,6 +91,14 @@ protected:
      */
     void sanitizeResourceFileNameCase(KoResourceSP resource, const QDir &parentDir);
 
+    /**
+     * Collects relative paths, sizes and modification times of all the
+     * files found recursively in \p paths and hashes them into a single
+     * string. Nonexistent paths are hashed as well, so that creation
+     * of a folder changes the fingerprint.
+     */
+    static QString folderFingerprint(const QStringList &paths);
+
 private:
     class Private;
     QScopedPointer<Private> d;
@@ -139,6 +139,33 @@ void TestFolderStorage::testResourceCaseSensitivity()
 #endif
 }
 
+void TestFolderStorage::testFingerprint()
+{
+    KisFolderStorage folderStorage(m_dstLocation);
+
+    const QString fingerprint = folderStorage.fingerprint();
+    QVERIFY(!fingerprint.isEmpty());
+    QCOMPARE(folderStorage.fingerprint(), fingerprint);
+
+    // files outside of the resource folders don't affect the fingerprint
+    QFile unrelatedFile(m_dstLocation + "/" + "unrelated.txt");
+    QVERIFY(unrelatedFile.open(QFile::WriteOnly));
+    unrelatedFile.write("unrelated");
+    unrelatedFile.close();
+    QCOMPARE(folderStorage.fingerprint(), fingerprint);
+
+    KoResourceSP resource(new DummyResource("fingerprinttest.kpp", ResourceType::PaintOpPresets));
+    resource->setValid(true);
+    resource->setVersion(0);
+    QVERIFY(folderStorage.addResource(ResourceType::PaintOpPresets, resource));
+
+    const QString newFingerprint = folderStorage.fingerprint();
+    QVERIFY(newFingerprint != fingerprint);
+
+    QVERIFY(QFile::remove(m_dstLocation + "/" + "paintoppresets/fingerprinttest.kpp"));
+    QCOMPARE(folderStorage.fingerprint(), fingerprint);
+}
+
 void TestFolderStorage::cleanupTestCase()
 {
     ResourceTestHelper::rmTestDb();
@@ -21,6 +21,7 @@ private Q_SLOTS:
     void testAddResource();
     void testResourceFilePath();
     void testResourceCaseSensitivity();
+    void testFingerprint();
     void cleanupTestCase();
 private:
     QString m_srcLocation;
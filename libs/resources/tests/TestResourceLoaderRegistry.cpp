@@ -33,5 +33,25 @@ void TestResourceLoaderRegistry::testRegistry()
     QVERIFY(dynamic_cast<DummyResource*>(res.data()));
 }
 
+void TestResourceLoaderRegistry::testConcurrentLoadingSupport()
+{
+    KisResourceLoaderRegistry *reg = KisResourceLoaderRegistry::instance();
+
+    KisResourceLoader<DummyResource> *loader1 = new KisResourceLoader<DummyResource>("dummy1", "concurrent", i18n("Dummy"), QStringList() << "x-dummy1");
+    KisResourceLoader<DummyResource> *loader2 = new KisResourceLoader<DummyResource>("dummy2", "concurrent", i18n("Dummy"), QStringList() << "x-dummy2");
+    reg->add(loader1);
+    reg->add(loader2);
+
+    QVERIFY(!reg->supportsConcurrentLoading("concurrent"));
+
+    loader1->setSupportsConcurrentLoading(true);
+    QVERIFY(!reg->supportsConcurrentLoading("concurrent"));
+
+    loader2->setSupportsConcurrentLoading(true);
+    QVERIFY(reg->supportsConcurrentLoading("concurrent"));
+
+    QVERIFY(!reg->supportsConcurrentLoading("nonexistent"));
+}
+
 SIMPLE_TEST_MAIN(TestResourceLoaderRegistry)
 
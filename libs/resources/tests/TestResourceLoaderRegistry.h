@@ -14,6 +14,7 @@ class TestResourceLoaderRegistry : public QObject
     Q_OBJECT
 private Q_SLOTS:
     void testRegistry();
+    void testConcurrentLoadingSupport();
 private:
 };
 
@@ -0,0 +1,182 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#include "TestResourceThumbnailCache.h"
+
+#include <simpletest.h>
+
+#include <QDir>
+#include <QSignalSpy>
+#include <QStandardItemModel>
+#include <QTemporaryDir>
+
+#include <KisResourceModel.h>
+#include <KisResourceThumbnailCache.h>
+
+namespace {
+QImage createThumbnail(int size, QColor color)
+{
+    QImage image(size, size, QImage::Format_ARGB32);
+    image.fill(color);
+    return image;
+}
+
+QImage createGradientThumbnail(int size)
+{
+    QImage image(size, size, QImage::Format_ARGB32);
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            image.setPixel(x, y, qRgba(x * 255 / size, y * 255 / size, 128, 255));
+        }
+    }
+    return image;
+}
+
+void addResourceItem(QStandardItemModel *model, const QString &storageLocation, const QString &md5)
+{
+    QStandardItem *item = new QStandardItem();
+    item->setData(storageLocation, Qt::UserRole + KisAbstractResourceModel::Location);
+    item->setData("brushes", Qt::UserRole + KisAbstractResourceModel::ResourceType);
+    item->setData("brush.png", Qt::UserRole + KisAbstractResourceModel::Filename);
+    item->setData(md5, Qt::UserRole + KisAbstractResourceModel::MD5);
+    item->setData(42, Qt::UserRole + KisAbstractResourceModel::Id);
+    model->appendRow(item);
+}
+}
+
+void TestResourceThumbnailCache::testInsertAndRemove()
+{
+    KisResourceThumbnailCache cache;
+    cache.setDiskCacheLocation(QString());
+
+    const QImage red = createThumbnail(64, Qt::red);
+    const QImage green = createThumbnail(64, Qt::green);
+
+    cache.insert("storage", "brushes", "brush.png", red);
+    QCOMPARE(cache.originalImage("storage", "brushes", "brush.png"), red);
+    QVERIFY(cache.originalImage("storage", "brushes", "other.png").isNull());
+
+    // reinserting replaces the thumbnail
+    cache.insert("storage", "brushes", "brush.png", green);
+    QCOMPARE(cache.originalImage("storage", "brushes", "brush.png"), green);
+
+    cache.remove("storage", "brushes", "brush.png");
+    QVERIFY(cache.originalImage("storage", "brushes", "brush.png").isNull());
+}
+
+void TestResourceThumbnailCache::testMemoryLimit()
+{
+    KisResourceThumbnailCache cache;
+    cache.setDiskCacheLocation(QString());
+
+    // every 128x128 ARGB thumbnail costs 64 KiB, so only three fit
+    cache.setMemoryLimits(3 * 65, 3 * 65);
+
+    for (int i = 0; i < 4; i++) {
+        cache.insert("storage", "patterns", QString("pattern%1.png").arg(i), createThumbnail(128, Qt::blue));
+    }
+
+    // the least recently used one has been evicted
+    QVERIFY(cache.originalImage("storage", "patterns", "pattern0.png").isNull());
+
+    // accessing a thumbnail makes it the most recently used one
+    QVERIFY(!cache.originalImage("storage", "patterns", "pattern1.png").isNull());
+    cache.insert("storage", "patterns", "pattern4.png", createThumbnail(128, Qt::blue));
+
+    QVERIFY(!cache.originalImage("storage", "patterns", "pattern1.png").isNull());
+    QVERIFY(cache.originalImage("storage", "patterns", "pattern2.png").isNull());
+    QVERIFY(!cache.originalImage("storage", "patterns", "pattern3.png").isNull());
+    QVERIFY(!cache.originalImage("storage", "patterns", "pattern4.png").isNull());
+}
+
+void TestResourceThumbnailCache::testAsyncSmoothThumbnail()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString storageLocation = dir.filePath("storage");
+    const QImage original = createGradientThumbnail(128);
+    const QSize size(32, 32);
+
+    QStandardItemModel model;
+    addResourceItem(&model, storageLocation, "0123456789abcdef");
+
+    KisResourceThumbnailCache cache;
+    cache.setDiskCacheLocation(dir.filePath("cache"));
+    QVERIFY(QDir().mkpath(dir.filePath("cache")));
+    cache.insert(storageLocation, "brushes", "brush.png", original);
+
+    QSignalSpy loadedSpy(&cache, SIGNAL(thumbnailLoaded(QString, int)));
+
+    // the fast version is returned right away
+    QImage thumbnail = cache.getImage(model.index(0, 0), size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    QCOMPARE(thumbnail, original.scaled(size, Qt::IgnoreAspectRatio, Qt::FastTransformation));
+
+    // the views are notified when the smooth one is ready
+    QTRY_COMPARE_WITH_TIMEOUT(loadedSpy.count(), 1, 5000);
+    QCOMPARE(loadedSpy[0][0].toString(), QString("brushes"));
+    QCOMPARE(loadedSpy[0][1].toInt(), 42);
+
+    thumbnail = cache.getImage(model.index(0, 0), size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    QCOMPARE(thumbnail, original.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+
+    // the second request is served from memory without any loading
+    QTest::qWait(100);
+    QCOMPARE(loadedSpy.count(), 1);
+}
+
+void TestResourceThumbnailCache::testDiskCache()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString storageLocation = dir.filePath("storage");
+    const QString cacheLocation = dir.filePath("cache");
+    QVERIFY(QDir().mkpath(cacheLocation));
+
+    const QImage original = createGradientThumbnail(128);
+    const QSize size(48, 32);
+
+    QStandardItemModel model;
+    addResourceItem(&model, storageLocation, "fedcba9876543210");
+
+    {
+        KisResourceThumbnailCache cache;
+        cache.setDiskCacheLocation(cacheLocation);
+        cache.insert(storageLocation, "brushes", "brush.png", original);
+
+        QSignalSpy loadedSpy(&cache, SIGNAL(thumbnailLoaded(QString, int)));
+        cache.getImage(model.index(0, 0), size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        QTRY_COMPARE_WITH_TIMEOUT(loadedSpy.count(), 1, 5000);
+    }
+
+    // the smooth thumbnail has been saved to disk
+    QCOMPARE(QDir(cacheLocation).entryList(QStringList() << "*.png", QDir::Files).size(), 1);
+
+    {
+        /**
+         * The files are named after the md5 of the resource, so a new
+         * cache (e.g. after a restart) loads the saved thumbnail instead
+         * of scaling the original one. A different original proves it.
+         */
+        KisResourceThumbnailCache cache;
+        cache.setDiskCacheLocation(cacheLocation);
+        cache.insert(storageLocation, "brushes", "brush.png", createThumbnail(128, Qt::red));
+
+        QSignalSpy loadedSpy(&cache, SIGNAL(thumbnailLoaded(QString, int)));
+        cache.getImage(model.index(0, 0), size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        QTRY_COMPARE_WITH_TIMEOUT(loadedSpy.count(), 1, 5000);
+
+        const QImage thumbnail =
+            cache.getImage(model.index(0, 0), size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        const QImage expected = original.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+        QCOMPARE(thumbnail.convertToFormat(QImage::Format_ARGB32),
+                 expected.convertToFormat(QImage::Format_ARGB32));
+    }
+}
+
+SIMPLE_TEST_MAIN(TestResourceThumbnailCache)
@@ -0,0 +1,22 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef TESTRESOURCETHUMBNAILCACHE_H
+#define TESTRESOURCETHUMBNAILCACHE_H
+
+#include <QObject>
+
+class TestResourceThumbnailCache : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testInsertAndRemove();
+    void testMemoryLimit();
+    void testAsyncSmoothThumbnail();
+    void testDiskCache();
+};
+
+#endif
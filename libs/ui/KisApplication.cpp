@@ -67,6 +67,7 @@
 #include <kis_meta_data_io_backend.h>
 #include <kis_meta_data_backend_registry.h>
 #include "KisApplicationArguments.h"
+#include "KisBatchExporter.h"
 #include <kis_debug.h>
 #include "kis_action_registry.h"
 #include <KoResourceServer.h>
@@ -362,6 +363,15 @@ bool KisApplication::registerResources()
                                                      i18nc("Resource type name", "Layer styles"),
                                                      QStringList() << "application/x-photoshop-style"));
 
+    /// These resources are plain images or color data: loading them
+    /// neither touches the resource database nor creates any shapes,
+    /// so the resource cache is allowed to load them on a thread pool
+    Q_FOREACH (const QString &resourceType, QStringList({ResourceType::Brushes, ResourceType::Gradients, ResourceType::Patterns})) {
+        Q_FOREACH (KisResourceLoaderBase *loader, reg->resourceTypeLoaders(resourceType)) {
+            loader->setSupportsConcurrentLoading(true);
+        }
+    }
+
     reg->registerFixup(10, new KisBrushTypeMetaDataFixup());
 
 #ifndef Q_OS_ANDROID
@@ -436,11 +446,13 @@ bool KisApplication::start(const KisApplicationArguments &args)
     const bool exportAs = args.exportAs();
     const bool exportSequence = args.exportSequence();
     const QString exportFileName = args.exportFileName();
+    const QString exportBatchFileName = args.exportBatchFileName();
+    const bool exportBatch = !exportBatchFileName.isEmpty();
 
-    d->batchRun = (exportAs || exportSequence || !exportFileName.isEmpty());
-    const bool needsMainWindow = (!exportAs && !exportSequence);
+    d->batchRun = (exportAs || exportSequence || exportBatch || !exportFileName.isEmpty());
+    const bool needsMainWindow = (!exportAs && !exportSequence && !exportBatch);
     // only show the mainWindow when no command-line mode option is passed
-    bool showmainWindow = (!exportAs && !exportSequence); // would be !batchRun;
+    bool showmainWindow = (!exportAs && !exportSequence && !exportBatch); // would be !batchRun;
 
     const bool showSplashScreen = !d->batchRun && qEnvironmentVariableIsEmpty("NOSPLASH");
     if (showSplashScreen && d->splashScreen) {
@@ -548,6 +560,28 @@ bool KisApplication::start(const KisApplicationArguments &args)
     connect(this, &KisApplication::aboutToQuit, &KisSpinBoxUnitManagerFactory::clearUnitManagerBuilder); //ensure the builder is destroyed when the application leave.
     //the new syntax slot syntax allow to connect to a non q_object static method.
 
+    if (exportBatch) {
+        KisBatchExporter::JobList jobList;
+        QString errorMessage;
+
+        const bool result = KisBatchExporter::loadJobList(exportBatchFileName, &jobList, &errorMessage);
+        if (!errorMessage.isEmpty()) {
+            errKrita << errorMessage;
+        }
+
+        if (!result) {
+            QTimer::singleShot(0, this, SLOT(quit()));
+            return false;
+        }
+
+        KisBatchExporter *exporter = new KisBatchExporter(jobList.jobs, jobList.concurrency, this);
+        connect(exporter, &KisBatchExporter::sigFinished, this, [exporter] () {
+            KisApplication::exit(exporter->failedJobsCount() > 0 ? 1 : 0);
+        });
+        exporter->start();
+        return true;
+    }
+
     // Create a new image, if needed
     if (doNewImage) {
         KisDocument *doc = args.createDocumentFromArguments();
@@ -33,6 +33,7 @@ struct Q_DECL_HIDDEN KisApplicationArguments::Private
     bool exportAs {false};
     bool exportSequence {false};
     QString exportFileName;
+    QString exportBatchFileName;
     QString workspace;
     QString windowLayout;
     QString session;
@@ -95,6 +96,7 @@ KisApplicationArguments::KisApplicationArguments(const QApplication &app)
     parser.addOption(QCommandLineOption(QStringList() << QLatin1String("export"), i18n("Export to the given filename and exit")));
     parser.addOption(QCommandLineOption(QStringList() << QLatin1String("export-sequence"), i18n("Export animation to the given filename and exit")));
     parser.addOption(QCommandLineOption(QStringList() << QLatin1String("export-filename"), i18n("Filename for export"), QLatin1String("filename")));
+    parser.addOption(QCommandLineOption(QStringList() << QLatin1String("export-batch"), i18n("Export all the documents listed in the given JSON job list and exit"), QLatin1String("joblist")));
     parser.addOption(QCommandLineOption(QStringList() << QLatin1String("file-layer"), i18n("File layer to be added to existing or new file"), QLatin1String("file-layer")));
     parser.addOption(QCommandLineOption(QStringList() << QLatin1String("resource-location"), i18n("A location that overrides the configured location for Krita's resources"), QLatin1String("file-layer")));
     parser.addPositionalArgument(QLatin1String("[file(s)]"), i18n("File(s) or URL(s) to open"));
@@ -176,6 +178,10 @@ KisApplicationArguments::KisApplicationArguments(const QApplication &app)
 
     d->fileLayer = parser.value("file-layer");
     d->exportFileName = parser.value("export-filename");
+    d->exportBatchFileName = parser.value("export-batch");
+    if (!d->exportBatchFileName.isEmpty()) {
+        d->exportBatchFileName = QDir::current().absoluteFilePath(d->exportBatchFileName);
+    }
     d->workspace = parser.value("workspace");
     d->windowLayout = parser.value("windowlayout");
     d->session = parser.value("load-session");
@@ -326,6 +332,11 @@ QString KisApplicationArguments::exportFileName() const
     return d->exportFileName;
 }
 
+QString KisApplicationArguments::exportBatchFileName() const
+{
+    return d->exportBatchFileName;
+}
+
 QString KisApplicationArguments::workspace() const
 {
     return d->workspace;
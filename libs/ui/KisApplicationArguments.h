@@ -33,6 +33,7 @@ public:
     bool exportAs() const;
     bool exportSequence() const;
     QString exportFileName() const;
+    QString exportBatchFileName() const;
     QString workspace() const;
     QString windowLayout() const;
     QString session() const;
@@ -0,0 +1,46 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisAsyncAnimationFramesStreamingRenderer.h"
+
+#include "kis_image.h"
+#include "kis_paint_device.h"
+
+
+KisAsyncAnimationFramesStreamingRenderer::KisAsyncAnimationFramesStreamingRenderer(QObject *parent)
+    : KisAsyncAnimationRendererBase(parent)
+{
+    connect(this, SIGNAL(sigCompleteRegenerationInternal(int)), SLOT(notifyFrameCompleted(int)));
+    connect(this, SIGNAL(sigCancelRegenerationInternal(int, KisAsyncAnimationRendererBase::CancelReason)), SLOT(notifyFrameCancelled(int, KisAsyncAnimationRendererBase::CancelReason)));
+}
+
+KisAsyncAnimationFramesStreamingRenderer::~KisAsyncAnimationFramesStreamingRenderer()
+{
+}
+
+void KisAsyncAnimationFramesStreamingRenderer::frameCompletedCallback(int frame, const KisRegion &requestedRegion)
+{
+    KisImageSP image = requestedImage();
+    if (!image) return;
+
+    KIS_SAFE_ASSERT_RECOVER (requestedRegion == image->bounds()) {
+        emit sigCancelRegenerationInternal(frame, KisAsyncAnimationRendererBase::RenderingFailed);
+        return;
+    }
+
+    QImage frameImage = image->projection()->convertToQImage(0, image->bounds());
+    if (frameImage.format() != QImage::Format_ARGB32) {
+        frameImage = frameImage.convertToFormat(QImage::Format_ARGB32);
+    }
+
+    emit sigFrameRendered(frame, frameImage);
+    emit sigCompleteRegenerationInternal(frame);
+}
+
+void KisAsyncAnimationFramesStreamingRenderer::frameCancelledCallback(int frame, CancelReason cancelReason)
+{
+    notifyFrameCancelled(frame, cancelReason);
+}
@@ -0,0 +1,41 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISASYNCANIMATIONFRAMESSTREAMINGRENDERER_H
+#define KISASYNCANIMATIONFRAMESSTREAMINGRENDERER_H
+
+#include <KisAsyncAnimationRendererBase.h>
+
+#include <QImage>
+
+/**
+ * A renderer that doesn't save the frames, but converts them into
+ * 8-bit sRGB QImage::Format_ARGB32 images and passes them to the GUI
+ * thread via sigFrameRendered(), so they can be fed to the video
+ * encoder directly.
+ *
+ * sigFrameRendered() is always emitted before the frame is reported
+ * as completed.
+ */
+class KisAsyncAnimationFramesStreamingRenderer : public KisAsyncAnimationRendererBase
+{
+    Q_OBJECT
+public:
+    explicit KisAsyncAnimationFramesStreamingRenderer(QObject *parent = 0);
+    ~KisAsyncAnimationFramesStreamingRenderer();
+
+protected:
+    void frameCompletedCallback(int frame, const KisRegion &requestedRegion) override;
+    void frameCancelledCallback(int frame, CancelReason cancelReason) override;
+
+Q_SIGNALS:
+    void sigFrameRendered(int frame, const QImage &image);
+
+    void sigCompleteRegenerationInternal(int frame);
+    void sigCancelRegenerationInternal(int frame, KisAsyncAnimationRendererBase::CancelReason cancelReason);
+};
+
+#endif // KISASYNCANIMATIONFRAMESSTREAMINGRENDERER_H
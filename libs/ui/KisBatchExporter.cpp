@@ -0,0 +1,249 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisBatchExporter.h"
+
+#include <QApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+#include <QTimer>
+
+#include <klocalizedstring.h>
+#include <KisMimeDatabase.h>
+#include <KisUsageLogger.h>
+#include <kis_debug.h>
+#include <kis_image.h>
+
+#include "KisDocument.h"
+#include "KisImportExportUtils.h"
+#include "KisPart.h"
+
+struct KisBatchExporter::Private
+{
+    QVector<Job> jobs;
+    int nextJob = 0;
+    int concurrency = 1;
+    int threadsPerDocument = 1;
+    int failedJobs = 0;
+
+    /// documents whose export has been started, but not yet completed
+    QHash<KisDocument*, Job> documentsInFlight;
+
+    /// set while slotStartNextJobs() is loading the documents
+    bool isStartingJobs = false;
+    bool isFinished = false;
+};
+
+bool KisBatchExporter::loadJobList(const QString &path, JobList *jobList, QString *errorMessage)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *errorMessage = i18n("Could not open the job list %1: %2", path, file.errorString());
+        return false;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (document.isNull()) {
+        *errorMessage = i18n("Could not parse the job list %1: %2", path, parseError.errorString());
+        return false;
+    }
+
+    if (!document.isObject() || !document.object().value("jobs").isArray()) {
+        *errorMessage = i18n("The job list %1 has no \"jobs\" array", path);
+        return false;
+    }
+
+    const QJsonObject root = document.object();
+    const QDir baseDir = QFileInfo(path).absoluteDir();
+
+    jobList->concurrency = root.value("concurrency").toInt(0);
+    jobList->jobs.clear();
+
+    QStringList errors;
+    const QJsonArray jobs = root.value("jobs").toArray();
+
+    for (int i = 0; i < jobs.size(); i++) {
+        const QJsonObject object = jobs[i].toObject();
+
+        Job job;
+        job.inputPath = object.value("input").toString();
+        job.outputPath = object.value("output").toString();
+
+        if (job.inputPath.isEmpty() || job.outputPath.isEmpty()) {
+            errors << i18n("Job %1 has no input or output file", i);
+            continue;
+        }
+
+        job.inputPath = baseDir.absoluteFilePath(job.inputPath);
+        job.outputPath = baseDir.absoluteFilePath(job.outputPath);
+
+        job.mimeType = object.value("mimetype").toString().toLatin1();
+        if (job.mimeType.isEmpty()) {
+            job.mimeType = KisMimeDatabase::mimeTypeForFile(job.outputPath, false).toLatin1();
+        }
+
+        if (job.mimeType.isEmpty()) {
+            errors << i18n("Job %1: cannot detect the file format of %2", i, job.outputPath);
+            continue;
+        }
+
+        const QJsonObject options = object.value("options").toObject();
+        if (!options.isEmpty()) {
+            job.exportConfiguration = new KisPropertiesConfiguration();
+            for (auto it = options.begin(); it != options.end(); ++it) {
+                job.exportConfiguration->setProperty(it.key(), it.value().toVariant());
+            }
+        }
+
+        jobList->jobs.append(job);
+    }
+
+    *errorMessage = errors.join("\n");
+    return true;
+}
+
+KisBatchExporter::KisBatchExporter(const QVector<Job> &jobs, int concurrency, QObject *parent)
+    : QObject(parent),
+      m_d(new Private)
+{
+    m_d->jobs = jobs;
+
+    const int idealThreadCount = qMax(1, QThread::idealThreadCount());
+
+    /**
+     * By default, we keep half as many documents in flight as there
+     * are cores: while one document is being loaded in the GUI thread,
+     * the others are being encoded in the background.
+     */
+    m_d->concurrency = concurrency > 0 ? concurrency : qMax(1, idealThreadCount / 2);
+
+    /// the update threads of all the images share the same budget
+    m_d->threadsPerDocument = qMax(1, idealThreadCount / m_d->concurrency);
+}
+
+KisBatchExporter::~KisBatchExporter()
+{
+}
+
+void KisBatchExporter::start()
+{
+    KisUsageLogger::log(QString("Starting batch export of %1 documents, %2 at a time")
+                            .arg(m_d->jobs.size())
+                            .arg(m_d->concurrency));
+
+    QTimer::singleShot(0, this, SLOT(slotStartNextJobs()));
+}
+
+int KisBatchExporter::failedJobsCount() const
+{
+    return m_d->failedJobs;
+}
+
+void KisBatchExporter::slotStartNextJobs()
+{
+    /**
+     * startJob() processes the events while loading the document, so
+     * a queued call from finishJob() may arrive here when the job has
+     * already been taken from the list, but is not yet in flight. The
+     * outer call rechecks the state after every job anyway, so the
+     * nested one just does nothing.
+     */
+    if (m_d->isStartingJobs || m_d->isFinished) return;
+
+    m_d->isStartingJobs = true;
+
+    while (m_d->documentsInFlight.size() < m_d->concurrency &&
+           m_d->nextJob < m_d->jobs.size()) {
+
+        startJob(m_d->jobs[m_d->nextJob++]);
+    }
+
+    m_d->isStartingJobs = false;
+
+    if (m_d->documentsInFlight.isEmpty() && m_d->nextJob >= m_d->jobs.size()) {
+        KisUsageLogger::log(QString("Batch export finished, %1 of %2 jobs failed")
+                                .arg(m_d->failedJobs)
+                                .arg(m_d->jobs.size()));
+        m_d->isFinished = true;
+        emit sigFinished();
+    }
+}
+
+void KisBatchExporter::startJob(const Job &job)
+{
+    KisDocument *doc = KisPart::instance()->createDocument();
+    doc->setFileBatchMode(true);
+
+    if (!doc->openPath(job.inputPath)) {
+        errKrita << "Could not load" << job.inputPath << ":" << doc->errorMessage();
+        m_d->failedJobs++;
+        doc->deleteLater();
+        return;
+    }
+
+    doc->image()->setWorkingThreadsLimit(m_d->threadsPerDocument);
+
+    qApp->processEvents(); // For vector layers to be updated
+    doc->image()->waitForDone();
+
+    m_d->documentsInFlight.insert(doc, job);
+
+    connect(doc, &KisDocument::sigCompleteBackgroundSaving,
+            this, &KisBatchExporter::slotDocumentSaved);
+
+    const bool started =
+        doc->exportDocument(job.outputPath, job.mimeType, false, false, job.exportConfiguration);
+
+    /**
+     * If the export failed before going into the background, the document
+     * may still be in the list; otherwise it has already been handled
+     * by slotDocumentSaved()
+     */
+    if (!started && m_d->documentsInFlight.contains(doc)) {
+        finishJob(doc, false, doc->errorMessage());
+    }
+}
+
+void KisBatchExporter::slotDocumentSaved(const KritaUtils::ExportFileJob &job,
+                                         KisImportExportErrorCode status,
+                                         const QString &errorMessage,
+                                         const QString &warningMessage)
+{
+    Q_UNUSED(job);
+
+    KisDocument *doc = qobject_cast<KisDocument*>(sender());
+    KIS_SAFE_ASSERT_RECOVER_RETURN(doc);
+
+    if (!m_d->documentsInFlight.contains(doc)) return;
+
+    if (!warningMessage.isEmpty()) {
+        warnKrita << "Warnings while exporting" << m_d->documentsInFlight[doc].inputPath << ":" << warningMessage;
+    }
+
+    finishJob(doc, status.isOk(), errorMessage.isEmpty() ? status.errorMessage() : errorMessage);
+}
+
+void KisBatchExporter::finishJob(KisDocument *doc, bool success, const QString &errorMessage)
+{
+    const Job job = m_d->documentsInFlight.take(doc);
+
+    if (!success) {
+        errKrita << "Could not export" << job.inputPath << "to" << job.outputPath << ":" << errorMessage;
+        m_d->failedJobs++;
+    }
+
+    doc->disconnect(this);
+    doc->deleteLater();
+
+    QTimer::singleShot(0, this, SLOT(slotStartNextJobs()));
+}
@@ -0,0 +1,111 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISBATCHEXPORTER_H
+#define KISBATCHEXPORTER_H
+
+#include <QObject>
+#include <QScopedPointer>
+#include <QVector>
+
+#include <kis_properties_configuration.h>
+#include "KisImportExportErrorCode.h"
+#include "kritaui_export.h"
+
+class KisDocument;
+
+namespace KritaUtils {
+struct ExportFileJob;
+}
+
+/**
+ * KisBatchExporter converts a list of documents in a single process
+ * (`krita --export-batch jobs.json`), so that plugins and resources
+ * are loaded only once for all of them.
+ *
+ * The documents are loaded one by one in the GUI thread, but their
+ * export runs in the background, so several documents are being
+ * encoded at the same time, while the next one is being loaded. The
+ * number of documents in flight is limited, and the update threads of
+ * the images share the global thread budget between them.
+ *
+ * The job list is a JSON file:
+ *
+ * \code
+ * {
+ *     "concurrency": 4,
+ *     "jobs": [
+ *         { "input": "a.kra", "output": "a.png" },
+ *         { "input": "b.kra", "output": "b.jpg",
+ *           "mimetype": "image/jpeg", "options": { "quality": 90 } }
+ *     ]
+ * }
+ * \endcode
+ *
+ * Relative paths are resolved against the folder of the job list. The
+ * mimetype is optional and is deduced from the output file name by
+ * default. The options are passed to the export filter as its
+ * configuration.
+ */
+class KRITAUI_EXPORT KisBatchExporter : public QObject
+{
+    Q_OBJECT
+public:
+    struct Job {
+        QString inputPath;
+        QString outputPath;
+        QByteArray mimeType;
+        KisPropertiesConfigurationSP exportConfiguration;
+    };
+
+    struct JobList {
+        QVector<Job> jobs;
+        int concurrency = 0;
+    };
+
+    /**
+     * Reads the job list from \p path. Returns false and fills
+     * \p errorMessage if the file cannot be parsed. Invalid jobs
+     * are reported in \p errorMessage as well, but the remaining
+     * jobs are still returned.
+     */
+    static bool loadJobList(const QString &path, JobList *jobList, QString *errorMessage);
+
+    /**
+     * \p concurrency is the maximum number of documents being processed
+     * at the same time, zero selects it automatically
+     */
+    KisBatchExporter(const QVector<Job> &jobs, int concurrency, QObject *parent = 0);
+    ~KisBatchExporter() override;
+
+    /**
+     * Starts processing the jobs. sigFinished() is emitted when
+     * all of them are completed.
+     */
+    void start();
+
+    int failedJobsCount() const;
+
+Q_SIGNALS:
+    void sigFinished();
+
+private Q_SLOTS:
+    void slotStartNextJobs();
+    void slotDocumentSaved(const KritaUtils::ExportFileJob &job,
+                           KisImportExportErrorCode status,
+                           const QString &errorMessage,
+                           const QString &warningMessage);
+
+private:
+    void startJob(const Job &job);
+    void finishJob(KisDocument *doc, bool success, const QString &errorMessage);
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISBATCHEXPORTER_H
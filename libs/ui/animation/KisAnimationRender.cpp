@@ -17,6 +17,7 @@
 #include "KisAnimationRenderingOptions.h"
 #include "KisMimeDatabase.h"
 #include "dialogs/KisAsyncAnimationFramesSaveDialog.h"
+#include "dialogs/KisAsyncAnimationFramesStreamDialog.h"
 #include "kis_time_span.h"
 #include "KisMainWindow.h"
 
@@ -24,6 +25,75 @@
 
 #include "KisVideoSaver.h"
 
+namespace {
+
+void showRenderingError(KisAsyncAnimationRenderDialogBase::Result result)
+{
+    if (result == KisAsyncAnimationRenderDialogBase::RenderTimedOut) {
+        QMessageBox::critical(qApp->activeWindow(), i18nc("@title:window", "Rendering error"), "Animation frame rendering has timed out. Output files are incomplete.\nTry to increase \"Frame Rendering Timeout\" or reduce \"Frame Rendering Clones Limit\" in Krita settings");
+    } else if (result == KisAsyncAnimationRenderDialogBase::RenderFailed) {
+        QMessageBox::critical(qApp->activeWindow(), i18nc("@title:window", "Rendering error"), i18n("Failed to render animation frames! Output files are incomplete."));
+    }
+}
+
+/**
+ * Renders the video without an intermediate image sequence: the frames
+ * are fed into ffmpeg's standard input while the next ones are being
+ * rendered.
+ */
+void renderStreamed(KisDocument *doc, KisViewManager *viewManager, const KisAnimationRenderingOptions &encoderOptions, bool batchMode)
+{
+    const QString resultFile = encoderOptions.resolveAbsoluteVideoFilePath();
+    KIS_SAFE_ASSERT_RECOVER_NOOP(QFileInfo(resultFile).isAbsolute());
+
+    {
+        const QFileInfo info(resultFile);
+        QDir dir(info.absolutePath());
+
+        if (!dir.exists()) {
+            dir.mkpath(info.absolutePath());
+        }
+        KIS_SAFE_ASSERT_RECOVER_NOOP(dir.exists());
+    }
+
+    KisAnimationVideoSaver encoder(doc, batchMode);
+    KisImportExportErrorCode res = encoder.startStreaming(encoderOptions);
+
+    if (res.isOk()) {
+        KisAsyncAnimationFramesStreamDialog exporter(doc->image(),
+                                                     KisTimeSpan::fromTimeToTime(encoderOptions.firstFrame,
+                                                                                 encoderOptions.lastFrame),
+                                                     &encoder);
+        exporter.setBatchMode(batchMode);
+
+        KisAsyncAnimationRenderDialogBase::Result result =
+            exporter.regenerateRange(viewManager->mainWindow()->viewManager());
+
+        if (result == KisAsyncAnimationRenderDialogBase::RenderComplete) {
+            res = encoder.finishStreaming();
+        } else {
+            // if ffmpeg has failed, its message is more useful than the generic one
+            const QString encoderError = encoder.streamingError();
+
+            encoder.cancelStreaming();
+            QFile::remove(resultFile);
+
+            if (!encoderError.isEmpty()) {
+                QMessageBox::critical(qApp->activeWindow(), i18nc("@title:window", "Krita"), i18n("Could not render animation:\n%1", encoderError));
+            } else {
+                showRenderingError(result);
+            }
+            return;
+        }
+    }
+
+    if (!res.isOk()) {
+        QMessageBox::critical(qApp->activeWindow(), i18nc("@title:window", "Krita"), i18n("Could not render animation:\n%1", res.errorMessage()));
+    }
+}
+
+}
+
 void KisAnimationRender::render(KisDocument *doc, KisViewManager *viewManager, KisAnimationRenderingOptions encoderOptions) {
     const QString frameMimeType = encoderOptions.frameMimeType;
     const QString framesDirectory = encoderOptions.resolveAbsoluteFramesDirectory();
@@ -50,6 +120,12 @@ void KisAnimationRender::render(KisDocument *doc, KisViewManager *viewManager, K
     }
 
     const bool batchMode = false; // TODO: fetch correctly!
+
+    if (KisAnimationVideoSaver::canStreamFrames(encoderOptions)) {
+        renderStreamed(doc, viewManager, encoderOptions, batchMode);
+        return;
+    }
+
     KisAsyncAnimationFramesSaveDialog exporter(doc->image(),
                                                KisTimeSpan::fromTimeToTime(encoderOptions.firstFrame,
                                                                       encoderOptions.lastFrame),
@@ -131,10 +207,8 @@ void KisAnimationRender::render(KisDocument *doc, KisViewManager *viewManager, K
             d.remove(f);
         }
 
-    } else if (result == KisAsyncAnimationFramesSaveDialog::RenderTimedOut) {
-        QMessageBox::critical(qApp->activeWindow(), i18nc("@title:window", "Rendering error"), "Animation frame rendering has timed out. Output files are incomplete.\nTry to increase \"Frame Rendering Timeout\" or reduce \"Frame Rendering Clones Limit\" in Krita settings");
-    } else if (result == KisAsyncAnimationFramesSaveDialog::RenderFailed) {
-        QMessageBox::critical(qApp->activeWindow(), i18nc("@title:window", "Rendering error"), i18n("Failed to render animation frames! Output files are incomplete."));
+    } else {
+        showRenderingError(result);
     }
 }
 
@@ -32,6 +32,12 @@ public:
     bool includeAudio = false;
     bool wantsOnlyUniqueFrameSequence = false;
 
+    /**
+     * When the image sequence is not kept, pass the rendered frames
+     * to ffmpeg directly instead of saving them to disk first
+     */
+    bool streamFramesToEncoder = true;
+
     QString ffmpegPath;
     int frameRate = 25;
     int width = 0;
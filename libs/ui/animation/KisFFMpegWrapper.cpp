@@ -137,6 +137,7 @@ void KisFFMpegWrapper::startNonBlocking(const KisFFMpegWrapperSettings &settings
     connect(m_process.data(), SIGNAL(readyReadStandardError()), SLOT(slotReadyReadSTDERR()));
     connect(m_process.data(), SIGNAL(started()), SLOT(slotStarted()));
     connect(m_process.data(), SIGNAL(finished(int, QProcess::ExitStatus)), SLOT(slotFinished(int)));
+    connect(m_process.data(), SIGNAL(bytesWritten(qint64)), SIGNAL(sigStdinBytesWritten()));
 
     QStringList args;
 
@@ -198,6 +199,47 @@ void KisFFMpegWrapper::waitForFinished(int msecs)
 
 }
 
+bool KisFFMpegWrapper::writeToStdin(const QByteArray &data)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_process, false);
+
+    /**
+     * The data written while the process is still starting is
+     * buffered by QProcess and passed to it after the start
+     */
+    if (m_process->state() == QProcess::NotRunning) return false;
+
+    return m_process->write(data) == data.size();
+}
+
+qint64 KisFFMpegWrapper::stdinBytesPending() const
+{
+    return m_process ? m_process->bytesToWrite() : 0;
+}
+
+bool KisFFMpegWrapper::waitForStdinBytesWritten(qint64 maxPendingBytes)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_process, false);
+
+    if (m_process->state() == QProcess::Starting) {
+        m_process->waitForStarted(FFMPEG_TIMEOUT);
+    }
+
+    while (m_process->bytesToWrite() > maxPendingBytes) {
+        if (m_process->state() != QProcess::Running) return false;
+        m_process->waitForBytesWritten(100);
+    }
+
+    return true;
+}
+
+void KisFFMpegWrapper::closeStdin()
+{
+    if (!m_process) return;
+
+    m_process->closeWriteChannel();
+}
+
 void KisFFMpegWrapper::updateProgressDialog(int progressValue) {
     
     dbgFile << "Update Progress" << progressValue << "/" << m_processSettings.totalFrames;
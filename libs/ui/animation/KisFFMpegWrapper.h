@@ -55,6 +55,37 @@ public:
     void waitForFinished(int msecs = FFMPEG_TIMEOUT);
     void reset();
 
+    /**
+     * Queues \p data for writing into the standard input of the process.
+     * The call never blocks: the data is written by the process object
+     * asynchronously, when the process is ready to consume it, and
+     * sigStdinBytesWritten() is emitted every time a part of it is
+     * written. Returns false if the process is not running anymore.
+     */
+    bool writeToStdin(const QByteArray &data);
+
+    /**
+     * @return the number of bytes queued by writeToStdin() that haven't
+     * been written into the process yet
+     */
+    qint64 stdinBytesPending() const;
+
+    /**
+     * Blocks until no more than \p maxPendingBytes queued by writeToStdin()
+     * are left unwritten. It is the throttle for the producers that are
+     * allowed to block (i.e. the ones not running in the GUI thread), the
+     * GUI code should check stdinBytesPending() and wait for
+     * sigStdinBytesWritten() instead. Returns false if the process is not
+     * running anymore.
+     */
+    bool waitForStdinBytesWritten(qint64 maxPendingBytes);
+
+    /**
+     * Closes the standard input of the process after all the pending
+     * data has been written, so that the process could finish
+     */
+    void closeStdin();
+
     static QJsonObject findProcessPath(const QString &processName, const QString &customLocation, bool processInfo);
     static QJsonObject findProcessInfo(const QString &processName, const QString &processPath, bool includeProcessInfo);
     static QStringList getSupportedCodecs(const QJsonObject& ffmpegJsonProcessInput);
@@ -78,6 +109,7 @@ Q_SIGNALS:
     void sigReadLine(int pipe, QString line);
     void sigReadSTDOUT(QByteArray stdoutBuffer);
     void sigReadSTDERR(QByteArray stderrBuffer);
+    void sigStdinBytesWritten();
 
 private Q_SLOTS:
     void slotReadyReadSTDOUT();
@@ -9,6 +9,7 @@
 #include <QDebug>
 #include <QFileInfo>
 #include <QFileSystemWatcher>
+#include <QImage>
 #include <QProcess>
 #include <QProgressDialog>
 #include <QEventLoop>
@@ -30,6 +31,58 @@
 
 #include "KisPart.h"
 
+namespace {
+
+/**
+ * Maximum amount of frame data queued into the standard input of
+ * ffmpeg before the rendering of the new frames is postponed
+ */
+const qint64 maxPendingStreamBytes = 256 * 1024 * 1024;
+
+KisTimeSpan outputClipRange(const KisAnimationRenderingOptions &options)
+{
+    const int sequenceNumberingOffset = options.sequenceStart;
+    return KisTimeSpan::fromTimeToTime(sequenceNumberingOffset + options.firstFrame,
+                                       sequenceNumberingOffset + options.lastFrame);
+}
+
+QString exportDimensionsFilter(const KisAnimationRenderingOptions &options)
+{
+    // export dimensions could be off a little bit, so the last force option tweaks the pixels for the export to work
+    return QString("scale=w=")
+            .append(QString::number(options.width))
+            .append(":h=")
+            .append(QString::number(options.height))
+            .append(":flags=")
+            .append(options.scaleFilter);
+            //.append(":force_original_aspect_ratio=decrease"); HOTFIX for even:odd dimension images.
+}
+
+QStringList splitCustomOptions(const KisAnimationRenderingOptions &options)
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 14, 0))
+    return options.customFFMpegOptions.split(' ', Qt::SkipEmptyParts);
+#else
+    return options.customFFMpegOptions.split(' ', QString::SkipEmptyParts);
+#endif
+}
+
+QStringList takeComplexFilterArgs(QStringList &additionalOptionsList)
+{
+    QStringList complexFilterArgs;
+
+    const int lavfiOptionsIndex = additionalOptionsList.indexOf("-lavfi");
+
+    if (lavfiOptionsIndex != -1) {
+        complexFilterArgs << additionalOptionsList.takeAt(lavfiOptionsIndex + 1);
+        additionalOptionsList.removeAt(lavfiOptionsIndex);
+    }
+
+    return complexFilterArgs;
+}
+
+}
+
 KisAnimationVideoSaver::KisAnimationVideoSaver(KisDocument *doc, bool batchMode)
     : m_image(doc->image())
     , m_doc(doc)
@@ -55,21 +108,8 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
 
     KisImportExportErrorCode resultOuter = ImportExportCodes::OK;
 
-    KisImageAnimationInterface *animation = m_image->animationInterface();
-
-    const int sequenceNumberingOffset = options.sequenceStart;
-    const KisTimeSpan clipRange = KisTimeSpan::fromTimeToTime(sequenceNumberingOffset + options.firstFrame,
-                                                        sequenceNumberingOffset + options.lastFrame);
-
-     // export dimensions could be off a little bit, so the last force option tweaks the pixels for the export to work
-    const QString exportDimensions =
-        QString("scale=w=")
-            .append(QString::number(options.width))
-            .append(":h=")
-            .append(QString::number(options.height))
-            .append(":flags=")
-            .append(options.scaleFilter);
-            //.append(":force_original_aspect_ratio=decrease"); HOTFIX for even:odd dimension images.
+    const KisTimeSpan clipRange = outputClipRange(options);
+    const QString exportDimensions = exportDimensionsFilter(options);
 
     const QString resultFile = options.resolveAbsoluteVideoFilePath();
     const QFileInfo resultFileInfo(resultFile);  
@@ -78,18 +118,13 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
     const QString suffix = resultFileInfo.suffix().toLower();
     const QString palettePath = videoDir.filePath("KritaTempPalettegen_\%06d.png");
 
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 14, 0))
-    QStringList additionalOptionsList = options.customFFMpegOptions.split(' ', Qt::SkipEmptyParts);
-#else
-    QStringList additionalOptionsList = options.customFFMpegOptions.split(' ', QString::SkipEmptyParts);
-#endif
+    QStringList additionalOptionsList = splitCustomOptions(options);
 
     QScopedPointer<KisFFMpegWrapper> ffmpegWrapper(new KisFFMpegWrapper(this));
     
     {
         
         QStringList paletteArgs;
-        QStringList simpleFilterArgs;
         QStringList complexFilterArgs;
         QStringList args;
         
@@ -98,13 +133,8 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
              //<< "-start_number" << QString::number(clipRange.start() // Starting number for first frame for batch of frames. **TODO** Not working???
              << "-i" << savedFilesMask; // Input frame(s) file mask..
 
-        const int lavfiOptionsIndex = additionalOptionsList.indexOf("-lavfi");
-
-        if ( lavfiOptionsIndex != -1 ) {
-            complexFilterArgs << additionalOptionsList.takeAt(lavfiOptionsIndex + 1);
-
-            additionalOptionsList.removeAt( lavfiOptionsIndex );
-        }                  
+        complexFilterArgs = takeComplexFilterArgs(additionalOptionsList);
+        const bool hasCustomComplexFilter = !complexFilterArgs.isEmpty();
       
         if ( suffix == "gif" ) {
             paletteArgs << "-r" << QString::number(options.frameRate)
@@ -147,7 +177,7 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
                 return result;
             }
             
-            if (lavfiOptionsIndex == -1) {
+            if (!hasCustomComplexFilter) {
                 complexFilterArgs << "[0:v][1:v] paletteuse";
             }
             
@@ -157,35 +187,7 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
             ffmpegWrapper->reset();
         }
         
-        QVector<QFileInfo> audioFiles = m_doc->getAudioTracks();
-        if (options.includeAudio && audioFiles.count() > 0 && audioFiles.first().exists()) {
-            QFileInfo audioFileInfo = audioFiles.first();
-            const int msecPerFrame = (1000 / animation->framerate());
-            const int msecStart = msecPerFrame * clipRange.start();
-            const int msecDuration = msecPerFrame * clipRange.duration();
-
-            const QTime startTime = QTime::fromMSecsSinceStartOfDay(msecStart);
-            const QTime durationTime = QTime::fromMSecsSinceStartOfDay(msecDuration);
-            const QString ffmpegTimeFormat = QStringLiteral("H:m:s.zzz");
-
-            args << "-ss" << QLocale::c().toString(startTime, ffmpegTimeFormat);
-            args << "-t" << QLocale::c().toString(durationTime, ffmpegTimeFormat);
-            args << "-i" << audioFileInfo.absoluteFilePath();
-        }
-      
-        // if we are exporting out at a different image size, we apply scaling filter
-        // export options HAVE to go after input options, so make sure this is after the audio import
-        if (m_image->width() != options.width || m_image->height() != options.height) {
-            simpleFilterArgs << exportDimensions;
-        }
-
-        if ( !complexFilterArgs.isEmpty() ) { 
-            args << "-lavfi" << (!simpleFilterArgs.isEmpty() ? simpleFilterArgs.join(",").append("[0:v];"):"") + complexFilterArgs.join(";");
-        } else if ( !simpleFilterArgs.isEmpty() ) {
-            args << "-vf" << simpleFilterArgs.join(",");
-        }
-        
-        args << additionalOptionsList;
+        appendOutputArguments(args, additionalOptionsList, complexFilterArgs, clipRange, options);
 
         dbgFile << "savedFilesMask" << savedFilesMask 
                 << "start" << QString::number(clipRange.start()) 
@@ -208,6 +210,240 @@ KisImportExportErrorCode KisAnimationVideoSaver::encode(const QString &savedFile
     return resultOuter;
 }
 
+void KisAnimationVideoSaver::appendOutputArguments(QStringList &args,
+                                                   const QStringList &additionalOptionsList,
+                                                   const QStringList &complexFilterArgs,
+                                                   const KisTimeSpan &clipRange,
+                                                   const KisAnimationRenderingOptions &options)
+{
+    QStringList simpleFilterArgs;
+
+    QVector<QFileInfo> audioFiles = m_doc->getAudioTracks();
+    if (options.includeAudio && audioFiles.count() > 0 && audioFiles.first().exists()) {
+        KisImageAnimationInterface *animation = m_image->animationInterface();
+
+        QFileInfo audioFileInfo = audioFiles.first();
+        const int msecPerFrame = (1000 / animation->framerate());
+        const int msecStart = msecPerFrame * clipRange.start();
+        const int msecDuration = msecPerFrame * clipRange.duration();
+
+        const QTime startTime = QTime::fromMSecsSinceStartOfDay(msecStart);
+        const QTime durationTime = QTime::fromMSecsSinceStartOfDay(msecDuration);
+        const QString ffmpegTimeFormat = QStringLiteral("H:m:s.zzz");
+
+        args << "-ss" << QLocale::c().toString(startTime, ffmpegTimeFormat);
+        args << "-t" << QLocale::c().toString(durationTime, ffmpegTimeFormat);
+        args << "-i" << audioFileInfo.absoluteFilePath();
+    }
+
+    // if we are exporting out at a different image size, we apply scaling filter
+    // export options HAVE to go after input options, so make sure this is after the audio import
+    if (m_image->width() != options.width || m_image->height() != options.height) {
+        simpleFilterArgs << exportDimensionsFilter(options);
+    }
+
+    if ( !complexFilterArgs.isEmpty() ) {
+        args << "-lavfi" << (!simpleFilterArgs.isEmpty() ? simpleFilterArgs.join(",").append("[0:v];"):"") + complexFilterArgs.join(";");
+    } else if ( !simpleFilterArgs.isEmpty() ) {
+        args << "-vf" << simpleFilterArgs.join(",");
+    }
+
+    args << additionalOptionsList;
+}
+
+bool KisAnimationVideoSaver::canStreamFrames(const KisAnimationRenderingOptions &options)
+{
+    const QString suffix = QFileInfo(options.resolveAbsoluteVideoFilePath()).suffix().toLower();
+
+    /**
+     * GIF export needs two passes over the frames (palettegen and
+     * paletteuse) and HDR export needs the frames in a high bit depth,
+     * so both of them still go through the image sequence on disk.
+     */
+    return options.streamFramesToEncoder &&
+        options.renderMode() == KisAnimationRenderingOptions::RENDER_VIDEO_ONLY &&
+        suffix != "gif" &&
+        !(options.frameExportConfig && options.frameExportConfig->getBool("saveAsHDR", false));
+}
+
+KisImportExportErrorCode KisAnimationVideoSaver::startStreaming(const KisAnimationRenderingOptions &options)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(!m_streamingWrapper, ImportExportCodes::InternalError);
+
+    if (!QFileInfo(options.ffmpegPath).exists()) {
+        m_doc->setErrorMessage(i18n("ffmpeg could not be found at %1", options.ffmpegPath));
+        return ImportExportCodes::Failure;
+    }
+
+    const KisTimeSpan clipRange = outputClipRange(options);
+
+    QStringList additionalOptionsList = splitCustomOptions(options);
+    const QStringList complexFilterArgs = takeComplexFilterArgs(additionalOptionsList);
+
+    /**
+     * Frames are passed as raw QImage::Format_ARGB32 scanlines, whose
+     * byte order depends on the endianness of the host
+     */
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    const QString pixelFormat = "bgra";
+#else
+    const QString pixelFormat = "argb";
+#endif
+
+    QStringList args;
+    args << "-f" << "rawvideo"
+         << "-pix_fmt" << pixelFormat
+         << "-s" << QString("%1x%2").arg(m_image->width()).arg(m_image->height())
+         << "-r" << QString::number(options.frameRate)
+         << "-i" << "-";
+
+    appendOutputArguments(args, additionalOptionsList, complexFilterArgs, clipRange, options);
+
+    KisFFMpegWrapperSettings ffmpegSettings;
+    ffmpegSettings.processPath = options.ffmpegPath;
+    ffmpegSettings.args = args;
+    ffmpegSettings.outputFile = options.resolveAbsoluteVideoFilePath();
+    ffmpegSettings.totalFrames = clipRange.duration();
+    ffmpegSettings.logPath = QDir::tempPath() + QDir::separator() + "krita" + QDir::separator() + "ffmpeg.log";
+
+    // the progress is reported by the frames rendering dialog
+    ffmpegSettings.batchMode = true;
+
+    m_streamingWrapper.reset(new KisFFMpegWrapper(this));
+    m_queuedStreamFrames.clear();
+    m_streamingFinished = false;
+    m_streamingError.clear();
+
+    connect(m_streamingWrapper.data(), &KisFFMpegWrapper::sigFinishedWithError, this, [this] (const QString &errMsg) {
+        m_streamingFinished = true;
+        m_streamingError = errMsg.isEmpty() ? i18n("FFMpeg failed to encode the video") : errMsg;
+        emit sigStreamingFailed();
+    });
+
+    connect(m_streamingWrapper.data(), &KisFFMpegWrapper::sigFinished, this, [this] () {
+        m_streamingFinished = true;
+    });
+
+    connect(m_streamingWrapper.data(), &KisFFMpegWrapper::sigStdinBytesWritten,
+            this, &KisAnimationVideoSaver::slotStreamBytesWritten);
+
+    m_streamingWrapper->startNonBlocking(ffmpegSettings);
+
+    return ImportExportCodes::OK;
+}
+
+bool KisAnimationVideoSaver::writeStreamFrame(const QImage &frame, int repeatCount)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_streamingWrapper, false);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(frame.format() == QImage::Format_ARGB32, false);
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(frame.size() == m_image->bounds().size(), false);
+
+    if (repeatCount <= 0) return true;
+
+    m_queuedStreamFrames.enqueue({frame, repeatCount});
+    return writeQueuedStreamFrames();
+}
+
+bool KisAnimationVideoSaver::writeQueuedStreamFrames()
+{
+    /**
+     * The held frames are repeated many times, so the copies are passed
+     * to ffmpeg one by one, only while its input buffer is not overfilled
+     */
+    while (!m_queuedStreamFrames.isEmpty() &&
+           m_streamingWrapper->stdinBytesPending() <= maxPendingStreamBytes) {
+
+        QueuedStreamFrame &queuedFrame = m_queuedStreamFrames.head();
+
+        /// 32-bit scanlines are never padded, so the image data is a valid rawvideo frame
+        const QByteArray data =
+            QByteArray::fromRawData(reinterpret_cast<const char*>(queuedFrame.frame.constBits()),
+                                    queuedFrame.frame.sizeInBytes());
+
+        if (!m_streamingWrapper->writeToStdin(data)) {
+            // the actual error of ffmpeg (if any) will override this message
+            if (m_streamingError.isEmpty()) {
+                m_streamingError = i18n("FFMpeg failed to encode the video");
+            }
+            m_queuedStreamFrames.clear();
+            return false;
+        }
+
+        if (--queuedFrame.repeatCount <= 0) {
+            m_queuedStreamFrames.dequeue();
+        }
+    }
+
+    return true;
+}
+
+void KisAnimationVideoSaver::slotStreamBytesWritten()
+{
+    if (!writeQueuedStreamFrames()) {
+        emit sigStreamingFailed();
+        return;
+    }
+
+    emit sigStreamFramesWritten();
+}
+
+bool KisAnimationVideoSaver::canAcceptStreamFrames() const
+{
+    return !m_streamingWrapper ||
+        (m_queuedStreamFrames.isEmpty() &&
+         m_streamingWrapper->stdinBytesPending() <= maxPendingStreamBytes);
+}
+
+QString KisAnimationVideoSaver::streamingError() const
+{
+    return m_streamingError;
+}
+
+KisImportExportErrorCode KisAnimationVideoSaver::finishStreaming()
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(m_streamingWrapper, ImportExportCodes::InternalError);
+
+    // pass the rest of the repeated frames before closing the stream
+    while (!m_queuedStreamFrames.isEmpty()) {
+        if (!m_streamingWrapper->waitForStdinBytesWritten(maxPendingStreamBytes) ||
+            !writeQueuedStreamFrames()) {
+
+            if (m_streamingError.isEmpty()) {
+                m_streamingError = i18n("FFMpeg failed to encode the video");
+            }
+            break;
+        }
+    }
+
+    m_streamingWrapper->closeStdin();
+    m_streamingWrapper->waitForFinished(FFMPEG_TIMEOUT);
+
+    KisImportExportErrorCode result = ImportExportCodes::OK;
+
+    if (!m_streamingFinished) {
+        m_doc->setErrorMessage(i18n("FFMpeg has timed out"));
+        result = ImportExportCodes::Failure;
+    } else if (!m_streamingError.isEmpty()) {
+        m_doc->setErrorMessage(m_streamingError);
+        result = ImportExportCodes::Failure;
+    }
+
+    m_streamingWrapper->reset();
+    m_streamingWrapper.reset();
+
+    return result;
+}
+
+void KisAnimationVideoSaver::cancelStreaming()
+{
+    m_queuedStreamFrames.clear();
+
+    if (!m_streamingWrapper) return;
+
+    m_streamingWrapper->reset();
+    m_streamingWrapper.reset();
+}
+
 KisImportExportErrorCode KisAnimationVideoSaver::convert(KisDocument *document, const QString &savedFilesMask, const KisAnimationRenderingOptions &options, bool batchMode)
 {
     KisAnimationVideoSaver videoSaver(document, batchMode);
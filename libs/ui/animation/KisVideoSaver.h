@@ -7,7 +7,10 @@
 #ifndef VIDEO_SAVER_H_
 #define VIDEO_SAVER_H_
 
+#include <QImage>
 #include <QObject>
+#include <QQueue>
+#include <QScopedPointer>
 
 #include "kis_types.h"
 
@@ -15,6 +18,8 @@
 
 class KisDocument;
 class KisAnimationRenderingOptions;
+class KisFFMpegWrapper;
+class KisTimeSpan;
 
 #include "kritaui_export.h"
 
@@ -49,10 +54,97 @@ public:
 
     static KisImportExportErrorCode convert(KisDocument *document, const QString &savedFilesMask, const KisAnimationRenderingOptions &options, bool batchMode);
 
+    /**
+     * @brief canStreamFrames
+     * @return true if the frames can be passed to ffmpeg directly via
+     * its standard input instead of an intermediate image sequence.
+     * That is possible only when the user doesn't want to keep the
+     * sequence and the output format can be encoded in a single pass.
+     */
+    static bool canStreamFrames(const KisAnimationRenderingOptions &options);
+
+    /**
+     * @brief startStreaming starts ffmpeg reading raw frames of the size
+     * of the image from its standard input. The frames should be passed
+     * in the order of their appearance with writeStreamFrame(), and the
+     * encoding is completed with finishStreaming().
+     */
+    KisImportExportErrorCode startStreaming(const KisAnimationRenderingOptions &options);
+
+    /**
+     * @brief writeStreamFrame queues \p frame to be passed to ffmpeg
+     * \p repeatCount times. The frame must be in QImage::Format_ARGB32
+     * format and have the size of the image. The call never blocks: the
+     * copies of the frame are passed to ffmpeg only while its input
+     * buffer is not overfilled, the rest of them wait in the queue.
+     * @return false if ffmpeg has stopped accepting the frames
+     */
+    bool writeStreamFrame(const QImage &frame, int repeatCount);
+
+    /**
+     * @brief canAcceptStreamFrames
+     * @return false if too much frame data is queued for ffmpeg already,
+     * so the producer of the frames should slow down. sigStreamFramesWritten()
+     * is emitted when the queue is consumed.
+     */
+    bool canAcceptStreamFrames() const;
+
+    /**
+     * @brief streamingError
+     * @return the error reported by ffmpeg if it has failed while
+     * streaming, otherwise an empty string
+     */
+    QString streamingError() const;
+
+    /**
+     * @brief finishStreaming closes the stream and waits for ffmpeg
+     * to finish the encoding
+     */
+    KisImportExportErrorCode finishStreaming();
+
+    /**
+     * @brief cancelStreaming kills the ffmpeg process without waiting for
+     * the encoding to complete
+     */
+    void cancelStreaming();
+
+Q_SIGNALS:
+    /**
+     * Emitted when a part of the queued frame data has been passed to ffmpeg
+     */
+    void sigStreamFramesWritten();
+
+    /**
+     * Emitted when ffmpeg fails while the frames are being streamed
+     */
+    void sigStreamingFailed();
+
+private:
+    void appendOutputArguments(QStringList &args,
+                               const QStringList &additionalOptionsList,
+                               const QStringList &complexFilterArgs,
+                               const KisTimeSpan &clipRange,
+                               const KisAnimationRenderingOptions &options);
+
+    bool writeQueuedStreamFrames();
+
+private Q_SLOTS:
+    void slotStreamBytesWritten();
+
 private:
     KisImageSP m_image;
     KisDocument* m_doc;
     bool m_batchMode;
+
+    struct QueuedStreamFrame {
+        QImage frame;
+        int repeatCount = 0;
+    };
+
+    QScopedPointer<KisFFMpegWrapper> m_streamingWrapper;
+    QQueue<QueuedStreamFrame> m_queuedStreamFrames;
+    bool m_streamingFinished = false;
+    QString m_streamingError;
 };
 
 #endif
@@ -0,0 +1,182 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisAsyncAnimationFramesStreamDialog.h"
+
+#include <QImage>
+#include <QMap>
+
+#include <klocalizedstring.h>
+
+#include <kis_image.h>
+#include <kis_time_span.h>
+
+#include <KisAsyncAnimationFramesStreamingRenderer.h>
+#include "animation/KisVideoSaver.h"
+
+namespace {
+/**
+ * The amount of memory the out-of-order frames are allowed to
+ * occupy while waiting for the preceding frames
+ */
+const qint64 maxPendingFramesBytes = 512 * 1024 * 1024;
+}
+
+struct KisAsyncAnimationFramesStreamDialog::Private
+{
+    Private(KisImageSP _image, const KisTimeSpan &_range, KisAnimationVideoSaver *_encoder)
+        : originalImage(_image),
+          range(_range),
+          encoder(_encoder)
+    {
+    }
+
+    KisImageSP originalImage;
+    KisTimeSpan range;
+    KisAnimationVideoSaver *encoder;
+
+    QList<int> uniqueFrames;
+    int nextUniqueFrameIndex = 0;
+    QMap<int, QImage> pendingFrames;
+    int maxPendingFrames = 2;
+    bool encoderFailed = false;
+
+    int repeatCount(int uniqueFrameIndex) const {
+        const int nextFrame =
+            uniqueFrameIndex + 1 < uniqueFrames.size() ?
+            uniqueFrames[uniqueFrameIndex + 1] :
+            range.end() + 1;
+
+        return nextFrame - uniqueFrames[uniqueFrameIndex];
+    }
+};
+
+KisAsyncAnimationFramesStreamDialog::KisAsyncAnimationFramesStreamDialog(KisImageSP image,
+                                                                         const KisTimeSpan &range,
+                                                                         KisAnimationVideoSaver *encoder)
+    : KisAsyncAnimationRenderDialogBase(i18n("Rendering video..."), image, 0),
+      m_d(new Private(image, range, encoder))
+{
+}
+
+KisAsyncAnimationFramesStreamDialog::~KisAsyncAnimationFramesStreamDialog()
+{
+}
+
+KisAsyncAnimationRenderDialogBase::Result KisAsyncAnimationFramesStreamDialog::regenerateRange(KisViewManager *viewManager)
+{
+    m_d->uniqueFrames = calcDirtyFrames();
+    m_d->nextUniqueFrameIndex = 0;
+    m_d->pendingFrames.clear();
+    m_d->encoderFailed = false;
+
+    const qint64 frameBytes = qMax(qint64(1), qint64(m_d->originalImage->width()) * m_d->originalImage->height() * 4);
+    m_d->maxPendingFrames = qMax(qint64(2), maxPendingFramesBytes / frameBytes);
+
+    /**
+     * The encoder writes the frames asynchronously, so we should restart
+     * the rendering when its queue is consumed and stop it as soon as the
+     * encoder fails
+     */
+    connect(m_d->encoder, SIGNAL(sigStreamFramesWritten()), this, SLOT(slotStreamFramesWritten()));
+    connect(m_d->encoder, SIGNAL(sigStreamingFailed()), this, SLOT(slotStreamingFailed()));
+
+    Result result = KisAsyncAnimationRenderDialogBase::regenerateRange(viewManager);
+
+    m_d->encoder->disconnect(this);
+
+    if (result == RenderComplete) {
+        KIS_SAFE_ASSERT_RECOVER (m_d->nextUniqueFrameIndex == m_d->uniqueFrames.size()) {
+            result = RenderFailed;
+        }
+    }
+
+    m_d->pendingFrames.clear();
+
+    return result;
+}
+
+QList<int> KisAsyncAnimationFramesStreamDialog::calcDirtyFrames() const
+{
+    QList<int> result;
+    for (int frame = m_d->range.start(); frame <= m_d->range.end(); frame++) {
+        KisTimeSpan heldFrameTimeRange = KisTimeSpan::calculateIdenticalFramesRecursive(m_d->originalImage->root(), frame);
+
+        // every frame of the range should be present in the stream
+        heldFrameTimeRange &= m_d->range;
+
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(heldFrameTimeRange.isValid(), result);
+
+        result.append(heldFrameTimeRange.start());
+        frame = heldFrameTimeRange.end();
+    }
+    return result;
+}
+
+KisAsyncAnimationRendererBase *KisAsyncAnimationFramesStreamDialog::createRenderer(KisImageSP image)
+{
+    Q_UNUSED(image);
+
+    KisAsyncAnimationFramesStreamingRenderer *renderer = new KisAsyncAnimationFramesStreamingRenderer();
+    connect(renderer, SIGNAL(sigFrameRendered(int, QImage)), SLOT(slotFrameRendered(int, QImage)));
+
+    return renderer;
+}
+
+void KisAsyncAnimationFramesStreamDialog::initializeRendererForFrame(KisAsyncAnimationRendererBase *renderer, KisImageSP image, int frame)
+{
+    Q_UNUSED(renderer);
+    Q_UNUSED(image);
+    Q_UNUSED(frame);
+}
+
+bool KisAsyncAnimationFramesStreamDialog::canStartFrameRegeneration() const
+{
+    /**
+     * The out-of-order frames cannot block the regeneration: when no
+     * frames are in progress, all the preceding frames have been written
+     * and pendingFrames is empty. The encoder's queue wakes us up in
+     * slotStreamFramesWritten().
+     */
+    return m_d->pendingFrames.size() < m_d->maxPendingFrames &&
+        m_d->encoder->canAcceptStreamFrames();
+}
+
+void KisAsyncAnimationFramesStreamDialog::slotFrameRendered(int frame, const QImage &image)
+{
+    if (m_d->encoderFailed) return;
+
+    m_d->pendingFrames.insert(frame, image);
+
+    while (m_d->nextUniqueFrameIndex < m_d->uniqueFrames.size() &&
+           m_d->pendingFrames.contains(m_d->uniqueFrames[m_d->nextUniqueFrameIndex])) {
+
+        const QImage frameImage = m_d->pendingFrames.take(m_d->uniqueFrames[m_d->nextUniqueFrameIndex]);
+
+        if (!m_d->encoder->writeStreamFrame(frameImage, m_d->repeatCount(m_d->nextUniqueFrameIndex))) {
+            slotStreamingFailed();
+            return;
+        }
+
+        m_d->nextUniqueFrameIndex++;
+    }
+}
+
+void KisAsyncAnimationFramesStreamDialog::slotStreamFramesWritten()
+{
+    if (m_d->encoderFailed) return;
+
+    continueRegeneration();
+}
+
+void KisAsyncAnimationFramesStreamDialog::slotStreamingFailed()
+{
+    if (m_d->encoderFailed) return;
+
+    m_d->encoderFailed = true;
+    m_d->pendingFrames.clear();
+    cancelRegeneration(KisAsyncAnimationRendererBase::RenderingFailed);
+}
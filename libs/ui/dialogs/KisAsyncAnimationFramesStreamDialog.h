@@ -0,0 +1,57 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISASYNCANIMATIONFRAMESSTREAMDIALOG_H
+#define KISASYNCANIMATIONFRAMESSTREAMDIALOG_H
+
+#include "KisAsyncAnimationRenderDialogBase.h"
+#include "kis_types.h"
+
+class KisAnimationVideoSaver;
+class QImage;
+
+/**
+ * Renders the frames of \p range and passes them directly to the video
+ * encoder, which should already be started with
+ * KisAnimationVideoSaver::startStreaming().
+ *
+ * The frames are rendered on several image clones at once, so they may
+ * come out of order. They are kept in memory until all the preceding
+ * frames are written; when too many frames are waiting, the rendering
+ * of the new frames is postponed. The same happens when the encoder
+ * lags behind and too much data is queued for it. The held frames are
+ * rendered only once and repeated in the stream.
+ */
+class KRITAUI_EXPORT KisAsyncAnimationFramesStreamDialog : public KisAsyncAnimationRenderDialogBase
+{
+    Q_OBJECT
+public:
+    KisAsyncAnimationFramesStreamDialog(KisImageSP image,
+                                        const KisTimeSpan &range,
+                                        KisAnimationVideoSaver *encoder);
+
+    ~KisAsyncAnimationFramesStreamDialog();
+
+    Result regenerateRange(KisViewManager *viewManager) override;
+
+protected:
+    QList<int> calcDirtyFrames() const override;
+    KisAsyncAnimationRendererBase* createRenderer(KisImageSP image) override;
+    void initializeRendererForFrame(KisAsyncAnimationRendererBase *renderer,
+                                    KisImageSP image, int frame) override;
+    bool canStartFrameRegeneration() const override;
+
+private Q_SLOTS:
+    void slotFrameRendered(int frame, const QImage &image);
+    void slotStreamFramesWritten();
+    void slotStreamingFailed();
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISASYNCANIMATIONFRAMESSTREAMDIALOG_H
@@ -188,26 +188,7 @@ KisAsyncAnimationRenderDialogBase::regenerateRange(KisViewManager *viewManager)
 
     const int oldWorkingThreadsLimit = m_d->image->workingThreadsLimit();
 
-    for (int i = 0; i < numWorkers; i++) {
-        // reuse the image for one of the workers
-        const bool lastWorker = (i == numWorkers - 1);
-        KisImageSP image = m_d->image;
-
-        if (!lastWorker) {
-            //Only the last-most worker should try to use the source image pointer. Others need a copy.
-
-            if (m_d->asyncRenderers.size() == 0) {
-                // Copy source image when no renderers (aka no copies) exist, requires lock as image memory can be actively modified.
-                m_d->image->barrierLock(true);
-                image = m_d->image->clone(true);
-                m_d->image->unlock();
-            } else {
-                // Copy a previous copy, shouldn't require lock since image is "fresh" and untouchable by other krita systems.
-                image = m_d->asyncRenderers[m_d->asyncRenderers.size() - 1].image->clone(true);
-            }
-        }
-
-
+    auto addWorker = [this, numThreadsPerWorker] (KisImageSP image) {
         image->setWorkingThreadsLimit(numThreadsPerWorker);
         KisAsyncAnimationRendererBase *renderer = createRenderer(image);
 
@@ -215,10 +196,40 @@ KisAsyncAnimationRenderDialogBase::regenerateRange(KisViewManager *viewManager)
         connect(renderer, SIGNAL(sigFrameCancelled(int, KisAsyncAnimationRendererBase::CancelReason)), SLOT(slotFrameCancelled(int, KisAsyncAnimationRendererBase::CancelReason)));
 
         m_d->asyncRenderers.push_back(RendererPair(renderer, image));
+
+        // start rendering right away, while the other clones are being created
+        tryInitiateFrameRegeneration();
+    };
+
+    /**
+     * Cloning a big image takes time, so we don't wait until all the
+     * clones are created, but start rendering on every worker as soon as
+     * it is ready. All the clones are copied from the first one, which
+     * is kept idle until the last clone is created. That is the only one
+     * that needs the source image to be locked, so the source image
+     * itself can start rendering right after it.
+     */
+    KisImageSP cloneSource;
+
+    if (numWorkers > 1) {
+        // Copy source image, requires lock as image memory can be actively modified.
+        m_d->image->barrierLock(true);
+        cloneSource = m_d->image->clone(true);
+        m_d->image->unlock();
     }
 
+    // reuse the source image for one of the workers
+    addWorker(m_d->image);
+
+    for (int i = 2; i < numWorkers; i++) {
+        // Copy the first copy, shouldn't require lock since image is "fresh" and untouchable by other krita systems.
+        addWorker(cloneSource->clone(true));
+    }
+
+    if (cloneSource) {
+        addWorker(cloneSource);
+    }
 
-    tryInitiateFrameRegeneration();
     updateProgressLabel();
 
     if (m_d->numDirtyFramesLeft() > 0) {
@@ -278,6 +289,21 @@ void KisAsyncAnimationRenderDialogBase::slotFrameCancelled(int frame, KisAsyncAn
     cancelProcessingImpl(cancelReason);
 }
 
+bool KisAsyncAnimationRenderDialogBase::canStartFrameRegeneration() const
+{
+    return true;
+}
+
+void KisAsyncAnimationRenderDialogBase::continueRegeneration()
+{
+    tryInitiateFrameRegeneration();
+}
+
+void KisAsyncAnimationRenderDialogBase::cancelRegeneration(KisAsyncAnimationRendererBase::CancelReason cancelReason)
+{
+    cancelProcessingImpl(cancelReason);
+}
+
 void KisAsyncAnimationRenderDialogBase::slotCancelRegeneration()
 {
     cancelProcessingImpl(KisAsyncAnimationRendererBase::UserCancelled);
@@ -307,6 +333,8 @@ void KisAsyncAnimationRenderDialogBase::tryInitiateFrameRegeneration()
     bool hadWorkOnPreviousCycle = false;
 
     while (!m_d->stillDirtyFrames.isEmpty()) {
+        if (!canStartFrameRegeneration()) break;
+
         for (auto &pair : m_d->asyncRenderers) {
             if (!pair.renderer->isActive()) {
                 const int currentDirtyFrame = m_d->stillDirtyFrames.takeFirst();
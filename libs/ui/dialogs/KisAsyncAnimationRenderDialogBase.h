@@ -135,6 +135,35 @@ protected:
     virtual void initializeRendererForFrame(KisAsyncAnimationRendererBase *renderer,
                                             KisImageSP image, int frame) = 0;
 
+    /**
+     * @brief lets the derived class throttle the regeneration
+     *
+     * Called before a new frame is passed to a free renderer. If the method
+     * returns false, the frame is postponed until one of the frames being
+     * processed is completed or the derived class calls
+     * continueRegeneration(). If the method may return false when no
+     * frames are in progress, the derived class must call
+     * continueRegeneration() when the condition is lifted, otherwise the
+     * regeneration will stall. The default implementation always returns
+     * true.
+     */
+    virtual bool canStartFrameRegeneration() const;
+
+    /**
+     * @brief starts the regeneration of the postponed frames
+     *
+     * @see canStartFrameRegeneration()
+     */
+    void continueRegeneration();
+
+    /**
+     * @brief stops the regeneration of all the frames with \p cancelReason
+     *
+     * Can be used by the derived classes to abort the process when
+     * the consumer of the frames has failed.
+     */
+    void cancelRegeneration(KisAsyncAnimationRendererBase::CancelReason cancelReason);
+
 private:
     struct Private;
     const QScopedPointer<Private> m_d;
@@ -29,12 +29,72 @@
 #include <QThread>
 #include <QApplication>
 
+#include <numeric>
+
 #include <kis_spontaneous_job.h>
 #include "kis_global.h"
 #include "krita_utils.h"
 #include "kis_image_view_converter.h"
 #include "kis_default_bounds.h"
 #include "kis_do_something_command.h"
+#include "KisParallelDeviceProcessingUtils.h"
+
+namespace {
+
+/**
+ * Groups the indexes of the paint jobs, so that the jobs that paint
+ * (the clones of) the same top-level shape fall into the same group
+ */
+QVector<QVector<int>> groupJobsWithSharedShapes(const QList<KoShapeManager::PaintJob> &jobs)
+{
+    QVector<int> groupOf(jobs.size());
+    std::iota(groupOf.begin(), groupOf.end(), 0);
+
+    auto findGroup = [&groupOf] (int index) {
+        while (groupOf[index] != index) {
+            groupOf[index] = groupOf[groupOf[index]];
+            index = groupOf[index];
+        }
+        return index;
+    };
+
+    QHash<KoShape*, int> jobOfRootShape;
+
+    for (int i = 0; i < jobs.size(); i++) {
+        Q_FOREACH (KoShape *shape, jobs[i].shapes) {
+            KoShape *root = shape;
+            while (root->parent()) {
+                root = root->parent();
+            }
+
+            auto it = jobOfRootShape.find(root);
+            if (it == jobOfRootShape.end()) {
+                jobOfRootShape.insert(root, i);
+            } else {
+                groupOf[findGroup(i)] = findGroup(*it);
+            }
+        }
+    }
+
+    QVector<QVector<int>> groups;
+    QHash<int, int> groupIndexes;
+
+    for (int i = 0; i < jobs.size(); i++) {
+        const int group = findGroup(i);
+
+        auto it = groupIndexes.find(group);
+        if (it == groupIndexes.end()) {
+            it = groupIndexes.insert(group, groups.size());
+            groups.append(QVector<int>());
+        }
+
+        groups[*it].append(i);
+    }
+
+    return groups;
+}
+
+}
 
 
 KisShapeLayerCanvasBase::KisShapeLayerCanvasBase(KisShapeLayer *parent)
@@ -417,76 +477,79 @@ void KisShapeLayerCanvas::repaint()
 
     const qint32 MASK_IMAGE_WIDTH = 256;
     const qint32 MASK_IMAGE_HEIGHT = 256;
-
-    QImage image(MASK_IMAGE_WIDTH, MASK_IMAGE_HEIGHT, QImage::Format_ARGB32);
-    QPainter tempPainter(&image);
-
-    tempPainter.setRenderHint(QPainter::Antialiasing);
-    tempPainter.setRenderHint(QPainter::TextAntialiasing);
-
-    quint8 * dstData = new quint8[MASK_IMAGE_WIDTH * MASK_IMAGE_HEIGHT * m_projection->pixelSize()];
+    const QSize maxPatchSize(MASK_IMAGE_WIDTH, MASK_IMAGE_HEIGHT);
 
     QRect repaintRect = paintJobsOrder.uncroppedViewUpdateRect;
     m_projection->clear(repaintRect);
 
-    Q_FOREACH (const KoShapeManager::PaintJob &job, paintJobsOrder.jobs) {
-        if (job.isEmpty()) {
-            m_projection->clear(job.viewUpdateRect);
-            continue;
-        }
-
-        KIS_SAFE_ASSERT_RECOVER(job.viewUpdateRect.width() <= MASK_IMAGE_WIDTH &&
-                                job.viewUpdateRect.height() <= MASK_IMAGE_HEIGHT) {
-            continue;
-        }
+    /**
+     * Every patch is rendered into its own image, like KoBakedShapeRenderer
+     * does, and written into its own area of the projection.
+     */
+    auto renderJob =
+        [this, maxPatchSize] (const KoShapeManager::PaintJob &job) {
+            if (job.isEmpty()) {
+                m_projection->clear(job.viewUpdateRect);
+                return;
+            }
 
-        image.fill(0);
+            KIS_SAFE_ASSERT_RECOVER_RETURN(job.viewUpdateRect.width() <= maxPatchSize.width() &&
+                                           job.viewUpdateRect.height() <= maxPatchSize.height());
 
-        tempPainter.setTransform(QTransform());
-        tempPainter.setClipRect(QRect(0,0,job.viewUpdateRect.width(), job.viewUpdateRect.height()));
-        tempPainter.setTransform(viewConverter()->documentToView() *
-                                 QTransform::fromTranslate(-job.viewUpdateRect.x(), -job.viewUpdateRect.y()));
+            QImage image(job.viewUpdateRect.size(), QImage::Format_ARGB32);
+            image.fill(0);
 
-        m_shapeManager->paintJob(tempPainter, job);
+            {
+                QPainter tempPainter(&image);
 
-        if (image.size() != job.viewUpdateRect.size()) {
-            const quint8 *imagePtr = image.constBits();
-            const int imageRowStride = 4 * image.width();
+                tempPainter.setRenderHint(QPainter::Antialiasing);
+                tempPainter.setRenderHint(QPainter::TextAntialiasing);
 
-            for (int y = 0; y < job.viewUpdateRect.height(); y++) {
+                tempPainter.setClipRect(QRect(QPoint(), job.viewUpdateRect.size()));
+                tempPainter.setTransform(viewConverter()->documentToView() *
+                                         QTransform::fromTranslate(-job.viewUpdateRect.x(), -job.viewUpdateRect.y()));
 
-                KoColorSpaceRegistry::instance()->rgb8()
-                        ->convertPixelsTo(imagePtr, dstData, m_projection->colorSpace(),
-                                          job.viewUpdateRect.width(),
-                                          KoColorConversionTransformation::internalRenderingIntent(),
-                                          KoColorConversionTransformation::internalConversionFlags());
+                m_shapeManager->paintJob(tempPainter, job);
+            }
 
-                m_projection->writeBytes(dstData,
-                                         job.viewUpdateRect.x(),
-                                         job.viewUpdateRect.y() + y,
-                                         job.viewUpdateRect.width(),
-                                         1);
+            const int numPixels = job.viewUpdateRect.width() * job.viewUpdateRect.height();
+            QVector<quint8> dstData(numPixels * m_projection->pixelSize());
 
-                imagePtr += imageRowStride;
-            }
-        } else {
             KoColorSpaceRegistry::instance()->rgb8()
-                    ->convertPixelsTo(image.constBits(), dstData, m_projection->colorSpace(),
-                                      MASK_IMAGE_WIDTH * MASK_IMAGE_HEIGHT,
+                    ->convertPixelsTo(image.constBits(), dstData.data(), m_projection->colorSpace(),
+                                      numPixels,
                                       KoColorConversionTransformation::internalRenderingIntent(),
                                       KoColorConversionTransformation::internalConversionFlags());
 
-            m_projection->writeBytes(dstData,
-                                     job.viewUpdateRect.x(),
-                                     job.viewUpdateRect.y(),
-                                     MASK_IMAGE_WIDTH,
-                                     MASK_IMAGE_HEIGHT);
+            m_projection->writeBytes(dstData.constData(), job.viewUpdateRect);
+        };
 
-        }
+    /**
+     * The clones of the shapes are shared between the jobs, and painting
+     * is not read-only for them: some of their caches are updated lazily
+     * (e.g. the outline rect of a group, when it is used for clipping).
+     * So the jobs that paint the same top-level shape are rendered
+     * sequentially, and only the independent groups are rendered in
+     * parallel.
+     *
+     * NOTE: repaint() is usually called from a spontaneous job, that is,
+     *       from a worker thread of the updates scheduler. The shared
+     *       helper renders the groups serially in this case instead of
+     *       blocking the worker on the global thread pool.
+     */
+    const QVector<QVector<int>> jobGroups = groupJobsWithSharedShapes(paintJobsOrder.jobs);
+
+    KritaUtils::processIndexesInParallel(jobGroups.size(),
+        [&paintJobsOrder, &renderJob, &jobGroups] (int groupIndex) {
+            Q_FOREACH (int index, jobGroups[groupIndex]) {
+                renderJob(paintJobsOrder.jobs[index]);
+            }
+        });
+
+    Q_FOREACH (const KoShapeManager::PaintJob &job, paintJobsOrder.jobs) {
         repaintRect |= job.viewUpdateRect;
     }
 
-    delete[] dstData;
     m_projection->purgeDefaultPixels();
     m_parentLayer->setDirty(repaintRect);
 
@@ -19,6 +19,7 @@
 #include "kis_paint_layer.h"
 #include "kis_group_layer.h"
 #include "kis_raster_keyframe_channel.h"
+#include "kis_paint_device_frames_interface.h"
 #include "kis_assign_profile_processing_visitor.h"
 #include "commands/kis_image_layer_add_command.h"
 #include <QRegExp>
@@ -182,6 +183,12 @@ KisImportExportErrorCode KisAnimationImporter::import(QStringList files, int fir
         filesProcessed++;
     }
 
+    if (layerRasterChannelPair.first) {
+        // the frames were imported from separate files, so even their
+        // static parts don't share tiles yet
+        layerRasterChannelPair.first->paintDevice()->framesInterface()->shareTilesBetweenFrames();
+    }
+
     if (layerRasterChannelPair.first && assignDocumentProfile) {
 
         if (layerRasterChannelPair.first->colorSpace()->colorModelId() == m_d->image->colorSpace()->colorModelId()) {
@@ -619,6 +619,11 @@ QVariant KisNodeModel::data(const QModelIndex &index, int role) const
 
             if (maxSize == m_d->thumbnalCache.maxSize()) {
                 return m_d->thumbnalCache.thumbnail(node);
+            } else if (maxSize < m_d->thumbnalCache.maxSize()) {
+                const QImage thumbnail = m_d->thumbnalCache.thumbnail(node);
+                return thumbnail.width() > maxSize || thumbnail.height() > maxSize ?
+                    thumbnail.scaled(maxSize, maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation) :
+                    thumbnail;
             } else {
                 return node->createThumbnail(maxSize, maxSize, Qt::KeepAspectRatio);
             }
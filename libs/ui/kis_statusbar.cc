@@ -272,16 +272,27 @@ void KisStatusBar::updateMemoryStatus()
             ->fetchMemoryStatistics(m_imageView ? m_imageView->image() : 0);
     const KFormat format;
 
-    const QString imageStatsMsg =
+    QString imageStatsMsg =
             i18nc("tooltip on statusbar memory reporting button (image stats)",
                   "Image size:\t %1\n"
                   "  - layers:\t\t %2\n"
                   "  - projections:\t %3\n"
-                  "  - instant preview:\t %4\n",
+                  "  - instant preview:\t %4\n"
+                  "  - undo history:\t %5\n",
                   format.formatByteSize(stats.imageSize),
                   format.formatByteSize(stats.layersSize),
                   format.formatByteSize(stats.projectionsSize),
-                  format.formatByteSize(stats.lodSize));
+                  format.formatByteSize(stats.lodSize),
+                  format.formatByteSize(stats.historySize));
+
+    const int maxHistoryLayers = 3;
+    for (int i = 0; i < qMin(maxHistoryLayers, stats.layersHistorySize.size()); i++) {
+        imageStatsMsg +=
+            i18nc("tooltip on statusbar memory reporting button (undo history size of a layer)",
+                  "      %1:\t %2\n",
+                  stats.layersHistorySize[i].first,
+                  format.formatByteSize(stats.layersHistorySize[i].second));
+    }
 
     const QString memoryStatsMsg =
             i18nc("tooltip on statusbar memory reporting button (total stats)",
@@ -290,7 +301,8 @@ void KisStatusBar::updateMemoryStatus()
                   "  pool:\t\t %5 / %6\n"
                   "  undo data:\t %7\n"
                   "\n"
-                  "Swap used:\t %8",
+                  "Swap used:\t %8\n"
+                  "  shared tiles:\t %9",
                   format.formatByteSize(stats.totalMemorySize),
                   format.formatByteSize(stats.totalMemoryLimit),
 
@@ -301,7 +313,8 @@ void KisStatusBar::updateMemoryStatus()
                   format.formatByteSize(stats.tilesPoolLimit),
 
                   format.formatByteSize(stats.historicalMemorySize),
-                  format.formatByteSize(stats.swapSize));
+                  format.formatByteSize(stats.swapSize),
+                  format.formatByteSize(stats.swapDeduplicatedSize));
 
     QString longStats = imageStatsMsg + "\n" + memoryStatsMsg;
 
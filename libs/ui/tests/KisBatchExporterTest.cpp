@@ -0,0 +1,152 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisBatchExporterTest.h"
+
+#include <simpletest.h>
+#include <testui.h>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+#include "KisBatchExporter.h"
+
+namespace {
+QString writeJobList(const QTemporaryDir &dir, const QByteArray &content)
+{
+    const QString path = dir.filePath("jobs.json");
+
+    QFile file(path);
+    file.open(QIODevice::WriteOnly);
+    file.write(content);
+
+    return path;
+}
+}
+
+void KisBatchExporterTest::testLoadJobList()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString path = writeJobList(dir,
+        "{ \"concurrency\": 3,"
+        "  \"jobs\": ["
+        "    { \"input\": \"a.kra\", \"output\": \"a.png\" },"
+        "    { \"input\": \"/tmp/b.kra\", \"output\": \"b.jpg\","
+        "      \"mimetype\": \"image/jpeg\", \"options\": { \"quality\": 90 } },"
+        "    { \"input\": \"c.kra\" }"
+        "  ]"
+        "}");
+
+    KisBatchExporter::JobList jobList;
+    QString errorMessage;
+
+    QVERIFY(KisBatchExporter::loadJobList(path, &jobList, &errorMessage));
+
+    // the job without an output is skipped and reported
+    QVERIFY(!errorMessage.isEmpty());
+    QCOMPARE(jobList.concurrency, 3);
+    QCOMPARE(jobList.jobs.size(), 2);
+
+    QCOMPARE(jobList.jobs[0].inputPath, QDir(dir.path()).absoluteFilePath("a.kra"));
+    QCOMPARE(jobList.jobs[0].outputPath, QDir(dir.path()).absoluteFilePath("a.png"));
+    QCOMPARE(jobList.jobs[0].mimeType, QByteArray("image/png"));
+    QVERIFY(!jobList.jobs[0].exportConfiguration);
+
+    QCOMPARE(jobList.jobs[1].inputPath, QString("/tmp/b.kra"));
+    QCOMPARE(jobList.jobs[1].mimeType, QByteArray("image/jpeg"));
+    QVERIFY(jobList.jobs[1].exportConfiguration);
+    QCOMPARE(jobList.jobs[1].exportConfiguration->getInt("quality"), 90);
+}
+
+void KisBatchExporterTest::testLoadBrokenJobList()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    KisBatchExporter::JobList jobList;
+    QString errorMessage;
+
+    QVERIFY(!KisBatchExporter::loadJobList(dir.filePath("nonexistent.json"), &jobList, &errorMessage));
+    QVERIFY(!errorMessage.isEmpty());
+
+    QVERIFY(!KisBatchExporter::loadJobList(writeJobList(dir, "{ \"jobs\": [ "), &jobList, &errorMessage));
+    QVERIFY(!errorMessage.isEmpty());
+
+    QVERIFY(!KisBatchExporter::loadJobList(writeJobList(dir, "[]"), &jobList, &errorMessage));
+    QVERIFY(!errorMessage.isEmpty());
+}
+
+void KisBatchExporterTest::testSchedulingWithMissingFiles()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QVector<KisBatchExporter::Job> jobs;
+    for (int i = 0; i < 5; i++) {
+        KisBatchExporter::Job job;
+        job.inputPath = dir.filePath(QString("missing_%1.kra").arg(i));
+        job.outputPath = dir.filePath(QString("missing_%1.png").arg(i));
+        job.mimeType = "image/png";
+        jobs << job;
+    }
+
+    KisBatchExporter exporter(jobs, 2);
+    QSignalSpy finishedSpy(&exporter, SIGNAL(sigFinished()));
+
+    exporter.start();
+    QVERIFY(finishedSpy.wait(10000));
+
+    // let all the queued calls to be delivered
+    QTest::qWait(100);
+
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(exporter.failedJobsCount(), 5);
+}
+
+void KisBatchExporterTest::testScheduling()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    /**
+     * The documents are loaded while the previous ones are still being
+     * exported, so the completion of the exports is delivered while the
+     * exporter is inside startJob(). Such a nested call should neither
+     * finish the batch early, nor finish it twice.
+     */
+    QVector<KisBatchExporter::Job> jobs;
+    for (int i = 0; i < 6; i++) {
+        KisBatchExporter::Job job;
+        job.inputPath = i == 3 ?
+            dir.filePath("missing.kra") :
+            QString(FILES_DATA_DIR) + '/' + (i % 2 ? "load_test.kra" : "load_test2.kra");
+        job.outputPath = dir.filePath(QString("output_%1.png").arg(i));
+        job.mimeType = "image/png";
+        jobs << job;
+    }
+
+    KisBatchExporter exporter(jobs, 2);
+    QSignalSpy finishedSpy(&exporter, SIGNAL(sigFinished()));
+
+    exporter.start();
+    QVERIFY(finishedSpy.wait(60000));
+
+    // let all the queued calls to be delivered
+    QTest::qWait(100);
+
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(exporter.failedJobsCount(), 1);
+
+    for (int i = 0; i < jobs.size(); i++) {
+        QCOMPARE(QFileInfo(jobs[i].outputPath).exists(), i != 3);
+    }
+}
+
+KISTEST_MAIN(KisBatchExporterTest)
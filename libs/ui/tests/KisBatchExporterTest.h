@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita Developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISBATCHEXPORTERTEST_H
+#define KISBATCHEXPORTERTEST_H
+
+#include <QObject>
+
+class KisBatchExporterTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testLoadJobList();
+    void testLoadBrokenJobList();
+    void testSchedulingWithMissingFiles();
+    void testScheduling();
+};
+
+#endif // KISBATCHEXPORTERTEST_H
@@ -14,6 +14,7 @@
 #include <kis_transaction.h>
 #include <kis_paint_device_frames_interface.h>
 #include <KisRunnableStrokeJobUtils.h>
+#include <KisParallelDeviceProcessingUtils.h>
 #include <KisRunnableStrokeJobsInterface.h>
 #include <KoCompositeOpRegistry.h>
 #include "kis_image_config.h"
@@ -246,7 +247,26 @@ void KisFilterStrokeStrategy::doStrokeCallback(KisStrokeJobData *data)
 
             QVector<KisRunnableStrokeJobData*> processJobs;
 
-            if (shared->filter()->supportsThreading()) {
+            const bool isPointwiseFilter =
+                shared->filter()->neededRect(shared->processRect, shared->filterConfig(), shared->levelOfDetail()) == shared->processRect;
+
+            if (shared->filter()->supportsThreading() && isPointwiseFilter) {
+                /**
+                 * The pixels of pointwise filters (e.g. color transformations) don't
+                 * depend on their neighbours, so the rect can be split into as many
+                 * tile-aligned bands as needed to load all the threads of the
+                 * scheduler, even when the rect is smaller than a single patch
+                 */
+                const int numBands = 2 * qMax(1, shared->image()->workingThreadsLimit());
+
+                KritaUtils::addJobsForTileAlignedBands(processJobs, shared->processRect, numBands,
+                    [shared, progress] (const QRect &band) {
+                        shared->filter()->processImpl(shared->filterDevice, band,
+                                                      shared->filterConfig().data(),
+                                                      progress->updater());
+                    });
+
+            } else if (shared->filter()->supportsThreading()) {
                 // Split stroke into patches...
                 QSize size = KritaUtils::optimalPatchSize();
                 QVector<QRect> patches = KritaUtils::splitRectIntoPatches(shared->processRect, size);
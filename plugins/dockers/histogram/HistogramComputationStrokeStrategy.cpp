@@ -6,12 +6,66 @@
  */
 #include "HistogramComputationStrokeStrategy.h"
 
+#include <algorithm>
+
 #include "KoColorSpace.h"
+#include "KoChannelInfo.h"
 
+#include "kis_algebra_2d.h"
 #include "krita_utils.h"
 #include "kis_image.h"
 #include "kis_sequential_iterator.h"
 
+HistogramPatchCache::HistogramPatchCache()
+    : m_patchSize(KritaUtils::optimalPatchSize())
+{
+}
+
+HistogramPatchCache::PatchCell HistogramPatchCache::patchCell(const QPoint &pt) const
+{
+    return qMakePair(KisAlgebra2D::divideFloor(pt.x(), m_patchSize.width()),
+                     KisAlgebra2D::divideFloor(pt.y(), m_patchSize.height()));
+}
+
+void HistogramPatchCache::addDirtyRect(const QRect &rect)
+{
+    if (rect.isEmpty()) return;
+
+    /**
+     * The dirty areas are not merged into a single bounding rect,
+     * otherwise two small strokes in the opposite corners of the
+     * image would make us recalculate almost all the patches.
+     * Instead, we mark the cells of the patch grid directly.
+     */
+    const PatchCell topLeft = patchCell(rect.topLeft());
+    const PatchCell bottomRight = patchCell(rect.bottomRight());
+
+    QMutexLocker locker(&m_dirtyRectLock);
+
+    const qint64 numCells =
+        qint64(bottomRight.first - topLeft.first + 1) *
+        (bottomRight.second - topLeft.second + 1);
+
+    // huge rects (e.g. the ones coming from the infinite filters)
+    // are cheaper to handle as a full update
+    if (numCells > 4096) {
+        m_fullUpdateNeeded = true;
+        return;
+    }
+
+    for (int row = topLeft.second; row <= bottomRight.second; row++) {
+        for (int col = topLeft.first; col <= bottomRight.first; col++) {
+            m_dirtyCells.insert(qMakePair(col, row));
+        }
+    }
+}
+
+void HistogramPatchCache::invalidate()
+{
+    QMutexLocker locker(&m_dirtyRectLock);
+    m_fullUpdateNeeded = true;
+}
+
 struct HistogramComputationStrokeStrategy::Private
 {
 
@@ -29,15 +83,19 @@ struct HistogramComputationStrokeStrategy::Private
     };
 
     KisImageSP image;
+    HistogramPatchCacheSP cache;
+
+    std::vector<int> patchIndexes; // indexes of the recalculated patches in the cache
     std::vector<HistVector> results;
 };
 
 
-HistogramComputationStrokeStrategy::HistogramComputationStrokeStrategy(KisImageSP image)
+HistogramComputationStrokeStrategy::HistogramComputationStrokeStrategy(KisImageSP image, HistogramPatchCacheSP cache)
     : KisIdleTaskStrokeStrategy(QLatin1String("ComputeHistogram"), kundo2_i18n("Update histogram"))
     , m_d(new Private)
 {
     m_d->image = image;
+    m_d->cache = cache;
 }
 
 HistogramComputationStrokeStrategy::~HistogramComputationStrokeStrategy()
@@ -48,14 +106,53 @@ void HistogramComputationStrokeStrategy::initStrokeCallback()
 {
     KisIdleTaskStrokeStrategy::initStrokeCallback();
 
-    QVector<KisStrokeJobData*> jobsData;
-    int i = 0;
-    QVector<QRect> tileRects = KritaUtils::splitRectIntoPatches(m_d->image->bounds(), KritaUtils::optimalPatchSize());
-    m_d->results.resize(tileRects.size());
+    HistogramPatchCache &cache = *m_d->cache;
+
+    QSet<HistogramPatchCache::PatchCell> dirtyCells;
+    bool fullUpdateNeeded = false;
+
+    {
+        QMutexLocker locker(&cache.m_dirtyRectLock);
+        dirtyCells.swap(cache.m_dirtyCells);
+        fullUpdateNeeded = cache.m_fullUpdateNeeded;
+        cache.m_fullUpdateNeeded = false;
+    }
+
+    const QRect imageBounds = m_d->image->bounds();
+    const KoColorSpace *cs = m_d->image->projection()->colorSpace();
+
+    if (fullUpdateNeeded ||
+        cache.m_imageBounds != imageBounds ||
+        !cache.m_colorSpace || !(*cache.m_colorSpace == *cs)) {
 
-    Q_FOREACH (const QRect &tileRectangle, tileRects) {
-        jobsData << new HistogramComputationStrokeStrategy::Private::ProcessData(tileRectangle, i);
-        i++;
+        cache.m_imageBounds = imageBounds;
+        cache.m_colorSpace = cs;
+        cache.m_patches = KritaUtils::splitRectIntoPatches(imageBounds, cache.m_patchSize);
+        cache.m_patchBins.assign(cache.m_patches.size(), HistVector());
+        initiateVector(cache.m_totalBins, cs);
+        for (auto &bin : cache.m_totalBins) {
+            std::fill(bin.begin(), bin.end(), 0);
+        }
+
+        fullUpdateNeeded = true;
+    }
+
+    m_d->patchIndexes.clear();
+
+    for (int i = 0; i < cache.m_patches.size(); i++) {
+        if (fullUpdateNeeded ||
+            dirtyCells.contains(cache.patchCell(cache.m_patches[i].topLeft()))) {
+
+            m_d->patchIndexes.push_back(i);
+        }
+    }
+
+    m_d->results.clear();
+    m_d->results.resize(m_d->patchIndexes.size());
+
+    QVector<KisStrokeJobData*> jobsData;
+    for (int i = 0; i < int(m_d->patchIndexes.size()); i++) {
+        jobsData << new HistogramComputationStrokeStrategy::Private::ProcessData(cache.m_patches[m_d->patchIndexes[i]], i);
     }
     addMutatedJobs(jobsData);
 }
@@ -84,7 +181,20 @@ void HistogramComputationStrokeStrategy::doStrokeCallback(KisStrokeJobData *data
     if (calculate.isEmpty())
         return;
 
-    initiateVector(m_d->results[d_pd->jobId], cs);
+    HistVector &bins = m_d->results[d_pd->jobId];
+    initiateVector(bins, cs);
+
+    /**
+     * For 8-bit color spaces scaleToU8() just returns the channel's
+     * byte, so we can fetch it directly and save a virtual call per
+     * channel per pixel
+     */
+    std::vector<int> channelOffsets;
+    if (cs->pixelSize() == channelCount) {
+        Q_FOREACH (const KoChannelInfo *channel, cs->channels()) {
+            channelOffsets.push_back(channel->pos());
+        }
+    }
 
     quint32 toSkip = nSkip;
 
@@ -95,49 +205,87 @@ void HistogramComputationStrokeStrategy::doStrokeCallback(KisStrokeJobData *data
 
         numConseqPixels = it.nConseqPixels();
         const quint8* pixel = it.rawDataConst();
-        for (int k = 0; k < numConseqPixels; ++k) {
-            if (--toSkip == 0) {
-                for (int chan = 0; chan < (int)channelCount; ++chan) {
-                    m_d->results[d_pd->jobId][chan][cs->scaleToU8(pixel, chan)]++;
+
+        if (!channelOffsets.empty()) {
+            for (int k = 0; k < numConseqPixels; ++k) {
+                if (--toSkip == 0) {
+                    for (int chan = 0; chan < (int)channelCount; ++chan) {
+                        bins[chan][pixel[channelOffsets[chan]]]++;
+                    }
+                    toSkip = nSkip;
                 }
-                toSkip = nSkip;
+                pixel += pixelSize;
+            }
+        } else {
+            for (int k = 0; k < numConseqPixels; ++k) {
+                if (--toSkip == 0) {
+                    for (int chan = 0; chan < (int)channelCount; ++chan) {
+                        bins[chan][cs->scaleToU8(pixel, chan)]++;
+                    }
+                    toSkip = nSkip;
+                }
+                pixel += pixelSize;
             }
-            pixel += pixelSize;
         }
     }
 }
 
 void HistogramComputationStrokeStrategy::finishStrokeCallback()
 {
-    HistogramData hisData;
-    hisData.colorSpace = m_d->image->projection()->colorSpace();
+    HistogramPatchCache &cache = *m_d->cache;
 
-    if (m_d->results.size() == 1) {
-        hisData.bins = m_d->results[0];
-        emit computationResultReady(hisData);
-    } else {
+    for (int i = 0; i < int(m_d->patchIndexes.size()); i++) {
+        HistVector &oldBins = cache.m_patchBins[m_d->patchIndexes[i]];
+        HistVector &newBins = m_d->results[i];
 
-        quint32 channelCount = m_d->image->projection()->channelCount();
-
-        initiateVector(hisData.bins, hisData.colorSpace);
+        // empty patches are skipped by the jobs
+        if (newBins.empty()) {
+            initiateVector(newBins, cache.m_colorSpace);
+        }
 
-        for (int chan = 0; chan < (int)channelCount; chan++) {
-            int bsize = hisData.bins[chan].size();
+        for (int chan = 0; chan < int(cache.m_totalBins.size()); chan++) {
+            std::vector<quint32> &totalBins = cache.m_totalBins[chan];
 
-            for (int bi = 0; bi < bsize; bi++) {
-                hisData.bins[chan][bi] = 0;
-                for (int i = 0; i < (int)m_d->results.size(); i++) {
-                    hisData.bins[chan][bi] += m_d->results[i][chan][bi];
+            if (!oldBins.empty()) {
+                for (int bi = 0; bi < int(totalBins.size()); bi++) {
+                    totalBins[bi] -= oldBins[chan][bi];
                 }
             }
+
+            for (int bi = 0; bi < int(totalBins.size()); bi++) {
+                totalBins[bi] += newBins[chan][bi];
+            }
         }
 
-        emit computationResultReady(hisData);
+        oldBins = std::move(newBins);
     }
 
+    m_d->patchIndexes.clear();
+    m_d->results.clear();
+
+    HistogramData hisData;
+    hisData.colorSpace = cache.m_colorSpace;
+    hisData.bins = cache.m_totalBins;
+    emit computationResultReady(hisData);
+
     KisIdleTaskStrokeStrategy::finishStrokeCallback();
 }
 
+void HistogramComputationStrokeStrategy::cancelStrokeCallback()
+{
+    HistogramPatchCache &cache = *m_d->cache;
+
+    // the patches taken by this stroke should be recalculated next time
+    for (int index : m_d->patchIndexes) {
+        cache.addDirtyRect(cache.m_patches[index]);
+    }
+
+    m_d->patchIndexes.clear();
+    m_d->results.clear();
+
+    KisIdleTaskStrokeStrategy::cancelStrokeCallback();
+}
+
 void HistogramComputationStrokeStrategy::initiateVector(HistVector &vec, const KoColorSpace *colorSpace)
 {
     vec.resize(colorSpace->channelCount());
@@ -8,6 +8,13 @@
 #define HISTOGRAMCOMPUTATIONSTROKESTRATEGY_H
 
 #include <KisIdleTaskStrokeStrategy.h>
+#include <QMutex>
+#include <QPair>
+#include <QRect>
+#include <QSet>
+#include <QSharedPointer>
+#include <QSize>
+#include <QVector>
 #include <vector>
 
 class KoColorSpace;
@@ -23,17 +30,58 @@ struct HistogramData
 Q_DECLARE_METATYPE(HistogramData)
 
 
+/**
+ * Keeps the histogram of every patch of the image, so that only the
+ * patches touched by the projection updates are recomputed by the next
+ * HistogramComputationStrokeStrategy, and the total histogram is
+ * adjusted by the difference.
+ *
+ * addDirtyRect() may be called from any thread, all the other state is
+ * owned by the stroke strategy.
+ */
+class HistogramPatchCache
+{
+public:
+    HistogramPatchCache();
+
+    void addDirtyRect(const QRect &rect);
+    void invalidate();
+
+private:
+    friend class HistogramComputationStrokeStrategy;
+
+    using PatchCell = QPair<int, int>;
+
+    PatchCell patchCell(const QPoint &pt) const;
+
+    const QSize m_patchSize;
+
+    QMutex m_dirtyRectLock;
+    QSet<PatchCell> m_dirtyCells;
+    bool m_fullUpdateNeeded {true};
+
+    QRect m_imageBounds;
+    const KoColorSpace *m_colorSpace {0};
+    QVector<QRect> m_patches;
+    std::vector<HistVector> m_patchBins;
+    HistVector m_totalBins;
+};
+
+using HistogramPatchCacheSP = QSharedPointer<HistogramPatchCache>;
+
+
 class HistogramComputationStrokeStrategy : public KisIdleTaskStrokeStrategy
 {
     Q_OBJECT
 public:
-    HistogramComputationStrokeStrategy(KisImageSP image);
+    HistogramComputationStrokeStrategy(KisImageSP image, HistogramPatchCacheSP cache);
     ~HistogramComputationStrokeStrategy() override;
 
 private:
     void initStrokeCallback() override;
     void doStrokeCallback(KisStrokeJobData *data) override;
     void finishStrokeCallback() override;
+    void cancelStrokeCallback() override;
 
     void initiateVector(HistVector &vec, const KoColorSpace* colorSpace);
 
@@ -18,6 +18,7 @@
 #include "KoChannelInfo.h"
 #include "KisViewManager.h"
 #include "kis_canvas2.h"
+#include "kis_image.h"
 
 
 
@@ -43,11 +44,24 @@ KisIdleTasksManager::TaskGuard HistogramDockerWidget::registerIdleTask(KisCanvas
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(canvas, KisIdleTasksManager::TaskGuard());
 
+    /**
+     * The cache collects the projection updates, so that the strategy
+     * recalculates only the changed patches of the image
+     */
+    disconnect(m_imageUpdatesConnection);
+    m_patchCache.reset(new HistogramPatchCache());
+
+    HistogramPatchCacheSP cache = m_patchCache;
+    m_imageUpdatesConnection =
+        connect(canvas->image().data(), &KisImage::sigImageUpdated,
+                this, [cache] (const QRect &rect) { cache->addDirtyRect(rect); },
+                Qt::DirectConnection);
+
     return
         canvas->viewManager()->idleTasksManager()->
-        addIdleTaskWithGuard([this](KisImageSP image) {
+        addIdleTaskWithGuard([this, cache](KisImageSP image) {
             HistogramComputationStrokeStrategy* strategy =
-                new HistogramComputationStrokeStrategy(image);
+                new HistogramComputationStrokeStrategy(image, cache);
 
             connect(strategy, SIGNAL(computationResultReady(HistogramData)), this, SLOT(receiveNewHistogram(HistogramData)));
 
@@ -59,6 +73,10 @@ void HistogramDockerWidget::clearCachedState()
 {
     m_colorSpace = 0;
     m_histogramData.clear();
+
+    if (m_patchCache) {
+        m_patchCache->invalidate();
+    }
 }
 
 void HistogramDockerWidget::paintEvent(QPaintEvent *event)
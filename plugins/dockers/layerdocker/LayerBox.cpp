@@ -335,7 +335,12 @@ LayerBox::LayerBox()
     thumbnailSizeSlider->setMinimumHeight(20);
     thumbnailSizeSlider->setMinimumWidth(40);
     thumbnailSizeSlider->setTickInterval(5);
-    m_nodeModel->setPreferredThumnalSize(cfg.layerThumbnailSize());
+    /**
+     * NodeDelegate requests the thumbnails in device pixels, so the
+     * cache should generate them in the same size. Otherwise every
+     * repaint of the docker would regenerate them in the GUI thread.
+     */
+    m_nodeModel->setPreferredThumnalSize(cfg.layerThumbnailSize() * devicePixelRatioF());
 
     QWidgetAction *sliderAction= new QWidgetAction(this);
     sliderAction->setDefaultWidget(thumbnailSizeSlider);
@@ -1311,7 +1316,7 @@ void LayerBox::slotUpdateThumbnailIconSize()
     KisConfig cfg(false);
     cfg.setLayerThumbnailSize(thumbnailSizeSlider->value());
 
-    m_nodeModel->setPreferredThumnalSize(thumbnailSizeSlider->value());
+    m_nodeModel->setPreferredThumnalSize(thumbnailSizeSlider->value() * devicePixelRatioF());
     m_wdgLayerBox->listLayers->slotConfigurationChanged();
 }
 
@@ -21,6 +21,7 @@ const QString keyCompression = "recorder/compression";
 const QString keyResolution = "recorder/resolution";
 const QString keyRecordIsolateLayerMode = "recorder/recordisolatelayermode";
 const QString keyRecordAutomatically = "recorder/recordautomatically";
+const QString keyRealTimeEncoding = "recorder/realtimeencoding";
 const QString defaultSnapshotDirectory = QDir::homePath() % QDir::separator() % "KritaRecorder";
 }
 
@@ -120,3 +121,13 @@ void RecorderConfig::setRecordAutomatically(bool value)
 {
     config->writeEntry(keyRecordAutomatically, value);
 }
+
+bool RecorderConfig::realTimeEncoding() const
+{
+    return config->readEntry(keyRealTimeEncoding, false);
+}
+
+void RecorderConfig::setRealTimeEncoding(bool value)
+{
+    config->writeEntry(keyRealTimeEncoding, value);
+}
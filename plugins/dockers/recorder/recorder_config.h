@@ -45,6 +45,9 @@ public:
     bool recordAutomatically() const;
     void setRecordAutomatically(bool value);
 
+    bool realTimeEncoding() const;
+    void setRealTimeEncoding(bool value);
+
 private:
     Q_DISABLE_COPY(RecorderConfig)
     mutable KisConfig *config;
@@ -14,6 +14,7 @@ namespace RecorderConst
 {
 
 constexpr int waitThreadTimeoutMs = 5000;
+constexpr int waitEncoderTimeoutMs = 3000;
 
 QRegularExpression snapshotFilePatternFor(const QString &extension);
 
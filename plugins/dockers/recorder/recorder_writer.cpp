@@ -6,18 +6,23 @@
 
 #include "recorder_writer.h"
 #include "recorder_const.h"
+#include "recorder_export_config.h"
 
 #include <kis_canvas2.h>
 #include <kis_image.h>
 #include <KisDocument.h>
 #include <KoToolProxy.h>
 #include <KisMainWindow.h>
+#include "animation/KisFFMpegWrapper.h"
 
 #include <QDir>
 #include <QDirIterator>
 #include <QElapsedTimer>
 #include <QImage>
+#include <QJsonObject>
+#include <QMutex>
 #include <QRegularExpression>
+#include <QSysInfo>
 #include <QApplication>
 
 namespace
@@ -34,8 +39,17 @@ public:
     QByteArray imageBuffer;
     int imageBufferWidth = 0;
     int imageBufferHeight = 0;
-    QImage frame;
+    QImage frame; // keeps the previous frame, only the dirty part is updated
     int frameResolution = -1;
+
+    QMutex dirtyRectLock;
+    QRect dirtyRect;
+    bool fullCaptureNeeded = true;
+
+    QScopedPointer<KisFFMpegWrapper> encoder;
+    QString encoderOutputDirectory;
+    QSize encoderFrameSize;
+    int encoderNextIndex = 0;
     int partIndex = 0;
     RecorderWriterSettings settings;
     QDir outputDir;
@@ -78,19 +92,64 @@ public:
     }
 
 
-    void captureImage()
+    void invalidateFrame()
+    {
+        QMutexLocker locker(&dirtyRectLock);
+        fullCaptureNeeded = true;
+        dirtyRect = QRect();
+    }
+
+    QRect takeDirtyRect(const QRect &bounds)
+    {
+        QMutexLocker locker(&dirtyRectLock);
+        const QRect rect = fullCaptureNeeded ? bounds : dirtyRect & bounds;
+        fullCaptureNeeded = false;
+        dirtyRect = QRect();
+        return rect;
+    }
+
+    // Captures the part of the image changed since the previous frame and
+    // returns the updated rect of the frame
+    QRect captureImage()
     {
         if (!canvas)
-            return;
+            return QRect();
 
         KisImageSP image = canvas->image();
 
+        // truncate uneven image width/height making it even for subdivided size too
+        const quint32 bitmask = ~(0xFFFFFFFFu >> (31 - settings.resolution));
+        const int width = image->width() & bitmask;
+        const int height = image->height() & bitmask;
+        const int divider = 1 << settings.resolution;
+        const QSize frameSize(width / divider, height / divider);
+
+        if (frame.size() != frameSize || frameResolution != settings.resolution) {
+            frame = QImage(frameSize, QImage::Format_ARGB32);
+            frameResolution = settings.resolution;
+            invalidateFrame();
+        }
+
+        const QRect bounds(0, 0, width, height);
+        QRect rect = takeDirtyRect(bounds);
+
+        // align the rect to the pixel blocks averaged into a single frame pixel
+        const int mask = divider - 1;
+        rect.setLeft(rect.left() & ~mask);
+        rect.setTop(rect.top() & ~mask);
+        rect.setRight(rect.right() | mask);
+        rect.setBottom(rect.bottom() | mask);
+        rect &= bounds;
+
+        if (rect.isEmpty())
+            return QRect();
+
         // Create detached paint device that can be converted to target colorspace
         KisPaintDeviceSP device = new KisPaintDevice(image->colorSpace());
 
         // we don't want image->barrierLock() because it will wait until the full stroke is finished
         image->immediateLockForReadOnly();
-        device->makeCloneFromRough(image->projection(), image->bounds());
+        device->makeCloneFromRough(image->projection(), rect);
         image->unlock();
 
         const bool needSrgbConversion = [&]() {
@@ -113,29 +172,23 @@ public:
             device->convertTo(targetCs);
         }
 
-        // truncate uneven image width/height making it even for subdivided size too
-        const quint32 bitmask = ~(0xFFFFFFFFu >> (31 - settings.resolution));
-        const quint32 width = image->width() & bitmask;
-        const quint32 height = image->height() & bitmask;
-        const int bufferSize = device->pixelSize() * width * height;
-
-        bool resize = imageBuffer.size() != bufferSize;
-        if (resize)
+        const int bufferSize = device->pixelSize() * rect.width() * rect.height();
+        if (imageBuffer.size() < bufferSize)
             imageBuffer.resize(bufferSize);
 
-        if (resize || frameResolution != settings.resolution) {
-            const int divider = 1 << settings.resolution;
-            const int outWidth = width / divider;
-            const int outHeight = height / divider;
-            uchar *outData = reinterpret_cast<uchar *>(imageBuffer.data());
+        device->readBytes(reinterpret_cast<quint8 *>(imageBuffer.data()), rect.x(), rect.y(), rect.width(), rect.height());
 
-            frame = QImage(outData, outWidth, outHeight, QImage::Format_ARGB32);
-        }
+        imageBufferWidth = rect.width();
+        imageBufferHeight = rect.height();
 
-        device->readBytes(reinterpret_cast<quint8 *>(imageBuffer.data()), 0, 0, width, height);
+        // downscale image buffer
+        for (int res = 0; res < settings.resolution; ++res)
+            halfSizeImageBuffer();
 
-        imageBufferWidth = width;
-        imageBufferHeight = height;
+        const QRect frameRect(rect.x() / divider, rect.y() / divider, imageBufferWidth, imageBufferHeight);
+        copyImageBufferToFrame(frameRect.topLeft());
+
+        return frameRect;
     }
 
     // Calculate ARGB average value using carry save adder:
@@ -145,6 +198,12 @@ public:
         return (((c1 ^ c2) & 0xfefefefeUL) >> 1) + (c1 & c2);
     }
 
+    // The same for two pairs of pixels at once
+    inline quint64 avg(quint64 c1, quint64 c2)
+    {
+        return (((c1 ^ c2) & 0xfefefefefefefefeULL) >> 1) + (c1 & c2);
+    }
+
     void halfSizeImageBuffer()
     {
         quint32 *buffer = reinterpret_cast<quint32 *>(imageBuffer.data());
@@ -155,10 +214,14 @@ public:
             const quint32 *in2 = in1 + imageBufferWidth;
 
             for (int x = 0; x < imageBufferWidth; x += 2) {
-                *out = avg(
-                    avg(in1[x], in1[x + 1]),
-                    avg(in2[x], in2[x + 1])
-                );
+                quint64 top;
+                quint64 bottom;
+                memcpy(&top, in1 + x, sizeof(top));
+                memcpy(&bottom, in2 + x, sizeof(bottom));
+
+                // average the rows first, both columns in one operation
+                const quint64 columns = avg(top, bottom);
+                *out = avg(quint32(columns), quint32(columns >> 32));
 
                 ++out;
             }
@@ -181,24 +244,31 @@ public:
         );
     }
 
-    void removeFrameTransparency()
+    void copyImageBufferToFrame(const QPoint &framePos)
     {
         const quint32 background = 0xFFFFFFFF;
-        quint32 *buffer = reinterpret_cast<quint32 *>(imageBuffer.data());
-        const quint32 *end = buffer + imageBufferWidth * imageBufferHeight;
-        while (buffer != end) {
-            const int alpha = qAlpha(*buffer);
-            switch (alpha) {
-            case 0xFF: // fully opaque
-                break;
-            case 0x00: // fully transparent - just replace to background
-                *buffer = background;
-                break;
-            default: // partly transparent - do color blending
-                *buffer = blendSourceOver(alpha, *buffer, background);
-                break;
+        const quint32 *buffer = reinterpret_cast<const quint32 *>(imageBuffer.constData());
+
+        for (int y = 0; y < imageBufferHeight; ++y) {
+            quint32 *out = reinterpret_cast<quint32 *>(frame.scanLine(framePos.y() + y)) + framePos.x();
+            const quint32 *end = buffer + imageBufferWidth;
+
+            while (buffer != end) {
+                const int alpha = qAlpha(*buffer);
+                switch (alpha) {
+                case 0xFF: // fully opaque
+                    *out = *buffer;
+                    break;
+                case 0x00: // fully transparent - just replace to background
+                    *out = background;
+                    break;
+                default: // partly transparent - do color blending
+                    *out = blendSourceOver(alpha, *buffer, background);
+                    break;
+                }
+                ++buffer;
+                ++out;
             }
-            ++buffer;
         }
     }
 
@@ -227,6 +297,93 @@ public:
         return result;
     }
 
+    // Starts FFmpeg that reads raw frames from the pipe and writes them
+    // into the same numbered snapshot files, so the export works as usual
+    bool startEncoder()
+    {
+        const QJsonObject ffmpegJson = KisFFMpegWrapper::findFFMpeg(RecorderExportConfig(true).ffmpegPath());
+        if (!ffmpegJson["enabled"].toBool())
+            return false;
+
+        if (!outputDir.exists() && !outputDir.mkpath(settings.outputDirectory))
+            return false;
+
+        const QString pixelFormat = QSysInfo::ByteOrder == QSysInfo::LittleEndian ? "bgra" : "argb";
+
+        KisFFMpegWrapperSettings ffmpegSettings;
+        ffmpegSettings.processPath = ffmpegJson["path"].toString();
+        ffmpegSettings.args << "-f" << "rawvideo"
+                            << "-pix_fmt" << pixelFormat
+                            << "-s" << QString("%1x%2").arg(frame.width()).arg(frame.height())
+                            << "-i" << "-"
+                            << "-start_number" << QString::number(partIndex);
+
+        switch (settings.format) {
+            case RecorderFormat::JPEG:
+                // 0...100 -> 31..2
+                ffmpegSettings.args << "-pix_fmt" << "yuvj420p"
+                                    << "-q:v" << QString::number(qBound(2, 31 - settings.quality * 29 / 100, 31));
+                break;
+            case RecorderFormat::PNG:
+                ffmpegSettings.args << "-pix_fmt" << "rgb24"
+                                    << "-compression_level" << QString::number(qBound(0, settings.compression, 9));
+                break;
+        }
+
+        ffmpegSettings.outputFile = QString("%1%2.%3").arg(settings.outputDirectory, "%07d",
+                                                           RecorderFormatInfo::fileExtension(settings.format));
+        ffmpegSettings.batchMode = true;
+
+        encoder.reset(new KisFFMpegWrapper());
+        encoder->startNonBlocking(ffmpegSettings);
+
+        encoderOutputDirectory = settings.outputDirectory;
+        encoderFrameSize = frame.size();
+        encoderNextIndex = partIndex;
+
+        return true;
+    }
+
+    void finishEncoder()
+    {
+        if (!encoder)
+            return;
+
+        encoder->closeStdin();
+        encoder->waitForFinished(RecorderConst::waitEncoderTimeoutMs);
+        encoder.reset();
+    }
+
+    bool writeFrameToEncoder()
+    {
+        if (encoder && (encoderOutputDirectory != settings.outputDirectory
+                        || encoderFrameSize != frame.size()
+                        || encoderNextIndex != partIndex)) {
+            finishEncoder();
+        }
+
+        if (!encoder && !startEncoder()) {
+            qWarning() << "Recorder: FFmpeg is not available, the frames will be saved by Krita";
+            settings.realTimeEncoding = false;
+            return writeFrame();
+        }
+
+        const QByteArray data =
+            QByteArray::fromRawData(reinterpret_cast<const char *>(frame.constBits()), int(frame.sizeInBytes()));
+
+        if (!encoder->writeToStdin(data))
+            return false;
+
+        // The writes don't block, so throttle ourselves: allow only one frame
+        // to be queued while FFmpeg encodes the previous one. The writer has
+        // its own thread, so it may wait here.
+        if (!encoder->waitForStdinBytesWritten(data.size()))
+            return false;
+
+        ++encoderNextIndex;
+        return true;
+    }
+
 };
 
 RecorderWriter::RecorderWriter()
@@ -244,15 +401,16 @@ void RecorderWriter::setCanvas(QPointer<KisCanvas2> canvas)
 {
     if (d->canvas) {
         disconnect(d->canvas->toolProxy(), SIGNAL(toolChanged(QString)), this, SLOT(onToolChanged(QString)));
-        disconnect(d->canvas->image(), SIGNAL(sigImageUpdated(QRect)), this, SLOT(onImageModified()));
+        disconnect(d->canvas->image(), SIGNAL(sigImageUpdated(QRect)), this, SLOT(onImageModified(QRect)));
     }
 
     d->canvas = canvas;
+    d->invalidateFrame();
 
     if (d->canvas) {
         connect(d->canvas->toolProxy(), SIGNAL(toolChanged(QString)), this, SLOT(onToolChanged(QString)),
                 Qt::DirectConnection); // need to handle it even if our event loop is not running
-        connect(d->canvas->image(), SIGNAL(sigImageUpdated(QRect)), this, SLOT(onImageModified()),
+        connect(d->canvas->image(), SIGNAL(sigImageUpdated(QRect)), this, SLOT(onImageModified(QRect)),
                 Qt::DirectConnection); // because it spams
     }
 }
@@ -323,17 +481,13 @@ void RecorderWriter::timerEvent(QTimerEvent */*event*/)
     QElapsedTimer elapsedTimer;
     elapsedTimer.start();
 
-    d->captureImage();
-
-    // downscale image buffer
-    for (int res = 0; res < d->settings.resolution; ++res)
-        d->halfSizeImageBuffer();
-
-    d->removeFrameTransparency();
+    const QRect updatedRect = d->captureImage();
+    if (updatedRect.isEmpty())
+        return;
 
     ++d->partIndex;
 
-    bool isFrameWritten = d->writeFrame();
+    bool isFrameWritten = d->settings.realTimeEncoding ? d->writeFrameToEncoder() : d->writeFrame();
     if (!isFrameWritten) {
         emit frameWriteFailed();
         quit();
@@ -350,8 +504,14 @@ void RecorderWriter::timerEvent(QTimerEvent */*event*/)
     }
 }
 
-void RecorderWriter::onImageModified()
+void RecorderWriter::onImageModified(const QRect &rect)
 {
+    {
+        // collect the changes even when not capturing, the frame must not get stale
+        QMutexLocker locker(&d->dirtyRectLock);
+        d->dirtyRect |= rect;
+    }
+
     if (d->skipCapturing || !d->enabled)
         return;
 
@@ -385,4 +545,6 @@ void RecorderWriter::run()
     QThread::run();
 
     killTimer(timerId);
+
+    d->finishEncoder();
 }
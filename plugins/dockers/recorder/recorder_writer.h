@@ -11,6 +11,7 @@
 
 #include <QThread>
 #include <QPointer>
+#include <QRect>
 
 class RecorderConfig;
 class KisCanvas2;
@@ -24,6 +25,7 @@ struct RecorderWriterSettings
     int resolution;
     double captureInterval;
     bool recordIsolateLayerMode;
+    bool realTimeEncoding; // stream the frames into FFmpeg instead of saving them from Krita
 };
 
 class RecorderWriter: public QThread
@@ -51,7 +53,7 @@ protected:
     void timerEvent(QTimerEvent *event) override;
 
 private Q_SLOTS:
-    void onImageModified();
+    void onImageModified(const QRect &rect);
     void onToolChanged(const QString &toolId);
 
 private:
@@ -58,6 +58,7 @@ public:
     int resolution = 0;
     bool recordIsolateLayerMode = false;
     bool recordAutomatically = false;
+    bool realTimeEncoding = false;
 
     QLabel* statusBarLabel;
     QLabel* statusBarWarningLabel;
@@ -90,6 +91,7 @@ public:
         resolution = config.resolution();
         recordIsolateLayerMode = config.recordIsolateLayerMode();
         recordAutomatically = config.recordAutomatically();
+        realTimeEncoding = config.realTimeEncoding();
 
         updateUiFormat();
     }
@@ -137,7 +139,7 @@ public:
     void updateWriterSettings()
     {
         outputDirectory = snapshotDirectory % QDir::separator() % prefix % QDir::separator();
-        writer.setup({ outputDirectory, format, quality, compression, resolution, captureInterval, recordIsolateLayerMode });
+        writer.setup({ outputDirectory, format, quality, compression, resolution, captureInterval, recordIsolateLayerMode, realTimeEncoding });
     }
 
     QString getPrefix()
@@ -234,6 +236,7 @@ RecorderDockerDock::RecorderDockerDock()
     d->ui->comboResolution->setCurrentIndex(d->resolution);
     d->ui->checkBoxRecordIsolateMode->setChecked(d->recordIsolateLayerMode);
     d->ui->checkBoxAutoRecord->setChecked(d->recordAutomatically);
+    d->ui->checkBoxRealTimeEncoding->setChecked(d->realTimeEncoding);
 
     KisActionRegistry *actionRegistry = KisActionRegistry::instance();
     d->recordToggleAction = actionRegistry->makeQAction(keyActionRecordToggle, this);
@@ -255,6 +258,7 @@ RecorderDockerDock::RecorderDockerDock()
     connect(d->ui->comboResolution, SIGNAL(currentIndexChanged(int)), this, SLOT(onResolutionChanged(int)));
     connect(d->ui->checkBoxRecordIsolateMode, SIGNAL(toggled(bool)), this, SLOT(onRecordIsolateLayerModeToggled(bool)));
     connect(d->ui->checkBoxAutoRecord, SIGNAL(toggled(bool)), this, SLOT(onAutoRecordToggled(bool)));
+    connect(d->ui->checkBoxRealTimeEncoding, SIGNAL(toggled(bool)), this, SLOT(onRealTimeEncodingToggled(bool)));
     connect(d->ui->buttonRecordToggle, SIGNAL(toggled(bool)), this, SLOT(onRecordButtonToggled(bool)));
     connect(d->ui->buttonExport, SIGNAL(clicked()), this, SLOT(onExportButtonClicked()));
 
@@ -413,6 +417,13 @@ void RecorderDockerDock::onAutoRecordToggled(bool checked)
     d->loadSettings();
 }
 
+void RecorderDockerDock::onRealTimeEncodingToggled(bool checked)
+{
+    d->realTimeEncoding = checked;
+    RecorderConfig(false).setRealTimeEncoding(checked);
+    d->loadSettings();
+}
+
 void RecorderDockerDock::onCaptureIntervalChanged(double interval)
 {
     d->captureInterval = interval;
@@ -570,6 +570,12 @@ bool KisKraLoadVisitor::loadPaintDevice(KisPaintDeviceSP device, const QString&
                 }
             }
         }
+
+        /**
+         * Every keyframe has been loaded into its own set of tiles, so
+         * let the unchanged parts of the frames share them
+         */
+        frameInterface->shareTilesBetweenFrames();
     }
 
     return true;
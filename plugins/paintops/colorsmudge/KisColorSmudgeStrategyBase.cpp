@@ -11,6 +11,24 @@
 #include "kis_fixed_paint_device.h"
 #include "kis_paint_device.h"
 #include "KisColorSmudgeSampleUtils.h"
+#include "KisParallelDeviceProcessingUtils.h"
+
+namespace {
+
+/**
+ * All the blending functions below may be called for a horizontal
+ * stripe of the dab only, so we should calculate the position of the
+ * stripe inside the device's buffer
+ */
+inline quint8* stripePointer(KisFixedPaintDeviceSP device, const QRect &stripeRect)
+{
+    const QRect bounds = device->bounds();
+    KIS_SAFE_ASSERT_RECOVER_NOOP(bounds.width() == stripeRect.width());
+
+    return device->data() + (stripeRect.y() - bounds.y()) * bounds.width() * device->pixelSize();
+}
+
+}
 
 /**********************************************************************************/
 /*                 DabColoringStrategyMask                                        */
@@ -32,10 +50,12 @@ void KisColorSmudgeStrategyBase::DabColoringStrategyMask::blendInFusedBackground
     colorRateOp->composite(dullingFillColor.data(), 1, paintColor.data(), 1, 0, 0, 1, 1, colorRateOpacity);
 
     if (smearOp->id() == COMPOSITE_COPY && smudgeRateOpacity == OPACITY_OPAQUE_U8) {
-        dst->fill(dst->bounds(), dullingFillColor);
+        dst->fill(dstRect, dullingFillColor);
     } else {
-        src->readBytes(dst->data(), dstRect);
-        smearOp->composite(dst->data(), dstRect.width() * dst->pixelSize(),
+        quint8 *dstPtr = stripePointer(dst, dstRect);
+
+        src->readBytes(dstPtr, dstRect);
+        smearOp->composite(dstPtr, dstRect.width() * dst->pixelSize(),
                            dullingFillColor.data(), 0,
                            0, 0,
                            1, dstRect.width() * dstRect.height(),
@@ -51,7 +71,7 @@ void KisColorSmudgeStrategyBase::DabColoringStrategyMask::blendInColorRate(const
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN(*paintColor.colorSpace() == *colorRateOp->colorSpace());
 
-    colorRateOp->composite(dstDevice->data(), dstRect.width() * dstDevice->pixelSize(),
+    colorRateOp->composite(stripePointer(dstDevice, dstRect), dstRect.width() * dstDevice->pixelSize(),
                            paintColor.data(), 0,
                            0, 0,
                            dstRect.height(), dstRect.width(),
@@ -78,8 +98,11 @@ void KisColorSmudgeStrategyBase::DabColoringStrategyStamp::blendInColorRate(cons
     // TODO: check correctness for composition source device (transparency masks)
     KIS_ASSERT_RECOVER_RETURN(*dstDevice->colorSpace() == *m_origDab->colorSpace());
 
-    colorRateOp->composite(dstDevice->data(), dstRect.width() * dstDevice->pixelSize(),
-                           m_origDab->data(), dstRect.width() * m_origDab->pixelSize(),
+    const int stripeOffset =
+        (dstRect.y() - dstDevice->bounds().y()) * m_origDab->bounds().width() * m_origDab->pixelSize();
+
+    colorRateOp->composite(stripePointer(dstDevice, dstRect), dstRect.width() * dstDevice->pixelSize(),
+                           m_origDab->data() + stripeOffset, dstRect.width() * m_origDab->pixelSize(),
                            0, 0,
                            dstRect.height(), dstRect.width(),
                            colorRateOpacity);
@@ -206,45 +229,63 @@ KisColorSmudgeStrategyBase::blendBrush(const QVector<KisPainter *> dstPainters,
     DabColoringStrategy &coloringStrategy = this->coloringStrategy();
 
     const quint8 dullingRateOpacity = this->dullingRateOpacity(opacity, smudgeRateValue);
+    const quint8 smudgeRateOpacity = this->smearRateOpacity(opacity, smudgeRateValue);
 
-    if (colorRateOpacity > 0 &&
+    const bool useFusedDullingBlending =
+        colorRateOpacity > 0 &&
         m_useDullingMode &&
         coloringStrategy.supportsFusedDullingBlending() &&
         ((m_smearOp->id() == COMPOSITE_OVER &&
           m_colorRateOp->id() == COMPOSITE_OVER) ||
          (m_smearOp->id() == COMPOSITE_COPY &&
-          dullingRateOpacity == OPACITY_OPAQUE_U8))) {
-
-        coloringStrategy.blendInFusedBackgroundAndColorRateWithDulling(m_blendDevice,
-                                                                       srcSampleDevice,
-                                                                       dstRect,
-                                                                       m_preparedDullingColor,
-                                                                       m_smearOp,
-                                                                       dullingRateOpacity,
-                                                                       currentPaintColor.convertedTo(
-                                                                               m_preparedDullingColor.colorSpace()),
-                                                                       m_colorRateOp,
-                                                                       colorRateOpacity);
-
-    } else {
-        if (!m_useDullingMode) {
-            const quint8 smudgeRateOpacity = this->smearRateOpacity(opacity, smudgeRateValue);
-            blendInBackgroundWithSmearing(m_blendDevice, srcSampleDevice,
-                                          srcRect, dstRect, smudgeRateOpacity);
-        } else {
-            blendInBackgroundWithDulling(m_blendDevice, srcSampleDevice,
-                                         dstRect,
-                                         m_preparedDullingColor, dullingRateOpacity);
-        }
-
-        if (colorRateOpacity > 0) {
-            coloringStrategy.blendInColorRate(
-                    currentPaintColor.convertedTo(m_preparedDullingColor.colorSpace()),
-                    m_colorRateOp,
-                    colorRateOpacity,
-                    m_blendDevice, dstRect);
-        }
-    }
+          dullingRateOpacity == OPACITY_OPAQUE_U8));
+
+    const KoColor preparedPaintColor = currentPaintColor.convertedTo(m_preparedDullingColor.colorSpace());
+    const QPoint srcOffset = srcRect.topLeft() - dstRect.topLeft();
+
+    /**
+     * Every pixel of the blend device depends on the corresponding
+     * pixels of the source only, so the mixing of big dabs can be
+     * split into full-width stripes and done concurrently. The final
+     * blending of the dab into the destination is still done in the
+     * stroke thread, so the dabs are painted in the correct order.
+     *
+     * NOTE: the helper processes the stripes serially when called from
+     *       a worker thread of the scheduler.
+     */
+    KritaUtils::processRectInParallel(dstRect,
+        [&] (const QRect &dstStripe) {
+            if (useFusedDullingBlending) {
+                coloringStrategy.blendInFusedBackgroundAndColorRateWithDulling(m_blendDevice,
+                                                                               srcSampleDevice,
+                                                                               dstStripe,
+                                                                               m_preparedDullingColor,
+                                                                               m_smearOp,
+                                                                               dullingRateOpacity,
+                                                                               preparedPaintColor,
+                                                                               m_colorRateOp,
+                                                                               colorRateOpacity);
+
+            } else {
+                if (!m_useDullingMode) {
+                    blendInBackgroundWithSmearing(m_blendDevice, srcSampleDevice,
+                                                  dstStripe.translated(srcOffset), dstStripe,
+                                                  smudgeRateOpacity);
+                } else {
+                    blendInBackgroundWithDulling(m_blendDevice, srcSampleDevice,
+                                                 dstStripe,
+                                                 m_preparedDullingColor, dullingRateOpacity);
+                }
+
+                if (colorRateOpacity > 0) {
+                    coloringStrategy.blendInColorRate(
+                            preparedPaintColor,
+                            m_colorRateOp,
+                            colorRateOpacity,
+                            m_blendDevice, dstStripe);
+                }
+            }
+        });
 
     const bool preserveDab = preserveMaskDab && dstPainters.size() > 1;
 
@@ -265,17 +306,19 @@ void KisColorSmudgeStrategyBase::blendInBackgroundWithSmearing(KisFixedPaintDevi
                                                                const QRect &srcRect, const QRect &dstRect,
                                                                const quint8 smudgeRateOpacity)
 {
+    quint8 *dstPtr = stripePointer(dst, dstRect);
+
     if (m_smearOp->id() == COMPOSITE_COPY && smudgeRateOpacity == OPACITY_OPAQUE_U8) {
-        src->readBytes(dst->data(), srcRect);
+        src->readBytes(dstPtr, srcRect);
     } else {
-        src->readBytes(dst->data(), dstRect);
+        src->readBytes(dstPtr, dstRect);
 
         KisFixedPaintDevice tempDevice(src->colorSpace(), m_memoryAllocator);
         tempDevice.setRect(srcRect);
         tempDevice.lazyGrowBufferWithoutInitialization();
 
         src->readBytes(tempDevice.data(), srcRect);
-        m_smearOp->composite(dst->data(), dstRect.width() * dst->pixelSize(),
+        m_smearOp->composite(dstPtr, dstRect.width() * dst->pixelSize(),
                              tempDevice.data(), dstRect.width() * tempDevice.pixelSize(), // stride should be random non-zero
                              0, 0,
                              1, dstRect.width() * dstRect.height(),
@@ -290,10 +333,12 @@ void KisColorSmudgeStrategyBase::blendInBackgroundWithDulling(KisFixedPaintDevic
     Q_UNUSED(preparedDullingColor);
 
     if (m_smearOp->id() == COMPOSITE_COPY && smudgeRateOpacity == OPACITY_OPAQUE_U8) {
-        dst->fill(dst->bounds(), m_preparedDullingColor);
+        dst->fill(dstRect, m_preparedDullingColor);
     } else {
-        src->readBytes(dst->data(), dstRect);
-        m_smearOp->composite(dst->data(), dstRect.width() * dst->pixelSize(),
+        quint8 *dstPtr = stripePointer(dst, dstRect);
+
+        src->readBytes(dstPtr, dstRect);
+        m_smearOp->composite(dstPtr, dstRect.width() * dst->pixelSize(),
                              m_preparedDullingColor.data(), 0,
                              0, 0,
                              1, dstRect.width() * dstRect.height(),
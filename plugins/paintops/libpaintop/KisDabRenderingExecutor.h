@@ -7,7 +7,7 @@
 #ifndef KISDABRENDERINGEXECUTOR_H
 #define KISDABRENDERINGEXECUTOR_H
 
-#include "kritadefaultpaintops_export.h"
+#include "kritapaintop_export.h"
 
 #include <QScopedPointer>
 
@@ -21,7 +21,7 @@ class KisPrecisionOption;
 class KisRunnableStrokeJobsInterface;
 
 
-class KRITADEFAULTPAINTOPS_EXPORT KisDabRenderingExecutor
+class PAINTOP_EXPORT KisDabRenderingExecutor
 {
 public:
     KisDabRenderingExecutor(const KoColorSpace *cs,
@@ -10,9 +10,9 @@
 #include <KoColorSpace.h>
 #include <KoColorSpaceRegistry.h>
 
-#include <../KisDabRenderingQueue.h>
-#include <../KisRenderedDab.h>
-#include <../KisDabRenderingJob.h>
+#include <KisDabRenderingQueue.h>
+#include <KisRenderedDab.h>
+#include <KisDabRenderingJob.h>
 
 struct SurrogateCacheInterface : public KisDabRenderingQueue::CacheInterface
 {
@@ -431,7 +431,7 @@ void KisDabRenderingQueueTest::testPostprocessedDabs()
 
 }
 
-#include <../KisDabRenderingQueueCache.h>
+#include <KisDabRenderingQueueCache.h>
 
 void KisDabRenderingQueueTest::testRunningJobs()
 {
@@ -486,7 +486,7 @@ void KisDabRenderingQueueTest::testRunningJobs()
     QCOMPARE(renderedDabs[1].offset, QPoint(15,15));
 }
 
-#include "../KisDabRenderingExecutor.h"
+#include "KisDabRenderingExecutor.h"
 #include "KisFakeRunnableStrokeJobsExecutor.h"
 
 void KisDabRenderingQueueTest::testExecutor()
@@ -75,6 +75,23 @@ struct KisLiquifyTransformStrategy::Private
 
     bool recalculateOnNextRedraw;
 
+    /**
+     * The preview image is updated incrementally while painting,
+     * that is, only the area touched by the liquify dabs is regenerated.
+     * These members keep the state the preview has been generated for.
+     */
+    struct PreviewCache {
+        bool isValid = false;
+        const KisLiquifyTransformWorker *worker = 0;
+        qint64 originalImageKey = 0;
+        QTransform thumbTransform;
+        bool useFlakeOptimization = false;
+        QImage srcImage;
+        QPointF srcImageOffset;
+    };
+
+    PreviewCache previewCache;
+
     void recalculateTransformations();
     inline QPointF imageToThumb(const QPointF &pt, bool useFlakeOptimization);
 };
@@ -130,6 +147,8 @@ void KisLiquifyTransformStrategy::paint(QPainter &gc)
 void KisLiquifyTransformStrategy::externalConfigChanged()
 {
     if (!m_d->currentArgs.liquifyWorker()) return;
+
+    m_d->previewCache.isValid = false;
     m_d->recalculateTransformations();
 }
 
@@ -269,33 +288,60 @@ void KisLiquifyTransformStrategy::Private::recalculateTransformations()
     bool useFlakeOptimization = scale < 1.0 &&
         !KisTransformUtils::thumbnailTooSmall(resultThumbTransform, q->originalImage().rect());
 
-    paintingOffset = transaction.originalTopLeft();
-    if (!q->originalImage().isNull()) {
-        if (useFlakeOptimization) {
-            transformedImage = q->originalImage().transformed(resultThumbTransform);
-            paintingTransform = QTransform();
-        } else {
-            transformedImage = q->originalImage();
-            paintingTransform = resultThumbTransform;
-        }
+    KisLiquifyTransformWorker *worker = currentArgs.liquifyWorker();
 
+    if (!q->originalImage().isNull()) {
         QTransform imageToRealThumbTransform =
             useFlakeOptimization ?
             scaleTransform :
             q->thumbToImageTransform().inverted();
 
-        QPointF origTLInFlake =
-            imageToRealThumbTransform.map(transaction.originalTopLeft());
+        const bool canUpdateIncrementally =
+            previewCache.isValid &&
+            previewCache.worker == worker &&
+            previewCache.originalImageKey == q->originalImage().cacheKey() &&
+            previewCache.thumbTransform == resultThumbTransform &&
+            previewCache.useFlakeOptimization == useFlakeOptimization &&
+            !transformedImage.isNull();
+
+        if (!canUpdateIncrementally ||
+            !worker->updateQImageIncrementally(previewCache.srcImage,
+                                               previewCache.srcImageOffset,
+                                               imageToRealThumbTransform,
+                                               &transformedImage,
+                                               paintingOffset)) {
+
+            if (useFlakeOptimization) {
+                previewCache.srcImage = q->originalImage().transformed(resultThumbTransform);
+                paintingTransform = QTransform();
+            } else {
+                previewCache.srcImage = q->originalImage();
+                paintingTransform = resultThumbTransform;
+            }
+
+            previewCache.srcImageOffset =
+                imageToRealThumbTransform.map(transaction.originalTopLeft());
+
+            paintingOffset = transaction.originalTopLeft();
+            transformedImage =
+                worker->runOnQImage(previewCache.srcImage,
+                                    previewCache.srcImageOffset,
+                                    imageToRealThumbTransform,
+                                    &paintingOffset);
+
+            previewCache.worker = worker;
+            previewCache.originalImageKey = q->originalImage().cacheKey();
+            previewCache.thumbTransform = resultThumbTransform;
+            previewCache.useFlakeOptimization = useFlakeOptimization;
+            previewCache.isValid = true;
+        }
 
-        transformedImage =
-            currentArgs.liquifyWorker()->runOnQImage(transformedImage,
-                                                     origTLInFlake,
-                                                     imageToRealThumbTransform,
-                                                     &paintingOffset);
+        worker->resetDirtyState();
     } else {
         transformedImage = q->originalImage();
         paintingOffset = imageToThumb(transaction.originalTopLeft(), false);
         paintingTransform = resultThumbTransform;
+        previewCache.isValid = false;
     }
 
     handlesTransform = scaleTransform;